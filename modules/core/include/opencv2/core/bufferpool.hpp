@@ -18,6 +18,14 @@ namespace cv
 //! @addtogroup core
 //! @{
 
+//! Usage statistics of reserved buffers
+struct BufferPoolStatistics
+{
+    BufferPoolStatistics() : hits(0), misses(0) { }
+    size_t hits;    //!< number of allocations served by reserved buffers
+    size_t misses;  //!< number of pooled allocations which required a new buffer
+};
+
 class BufferPoolController
 {
 protected:
@@ -27,6 +35,10 @@ public:
     virtual size_t getMaxReservedSize() const = 0;
     virtual void setMaxReservedSize(size_t size) = 0;
     virtual void freeAllReservedBuffers() = 0;
+
+    //! returns empty statistics if pool doesn't collect it
+    virtual BufferPoolStatistics getStatistics() const { return BufferPoolStatistics(); }
+    virtual void resetStatistics() { }
 };
 
 //! @}
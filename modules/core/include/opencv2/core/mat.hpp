@@ -503,6 +503,7 @@ public:
                       const size_t dstofs[], const size_t dststep[], bool sync) const;
 
     // default implementation returns DummyBufferPoolController
+    // standard allocator returns pool of host memory buffers (disabled until setMaxReservedSize() call or OPENCV_BUFFERPOOL_LIMIT)
     virtual BufferPoolController* getBufferPoolController(const char* id = NULL) const;
 };
 
@@ -3683,6 +3684,8 @@ MatExpr operator / (const Matx<_Tp, m, n>& a, const Mat& b) { return Mat(a) / b;
 CV_EXPORTS MatExpr operator < (const Mat& a, const Mat& b);
 CV_EXPORTS MatExpr operator < (const Mat& a, double s);
 CV_EXPORTS MatExpr operator < (double s, const Mat& a);
+CV_EXPORTS MatExpr operator < (const MatExpr& e, double s);
+CV_EXPORTS MatExpr operator < (double s, const MatExpr& e);
 template<typename _Tp, int m, int n> static inline
 MatExpr operator < (const Mat& a, const Matx<_Tp, m, n>& b) { return a < Mat(b); }
 template<typename _Tp, int m, int n> static inline
@@ -3691,6 +3694,8 @@ MatExpr operator < (const Matx<_Tp, m, n>& a, const Mat& b) { return Mat(a) < b;
 CV_EXPORTS MatExpr operator <= (const Mat& a, const Mat& b);
 CV_EXPORTS MatExpr operator <= (const Mat& a, double s);
 CV_EXPORTS MatExpr operator <= (double s, const Mat& a);
+CV_EXPORTS MatExpr operator <= (const MatExpr& e, double s);
+CV_EXPORTS MatExpr operator <= (double s, const MatExpr& e);
 template<typename _Tp, int m, int n> static inline
 MatExpr operator <= (const Mat& a, const Matx<_Tp, m, n>& b) { return a <= Mat(b); }
 template<typename _Tp, int m, int n> static inline
@@ -3699,6 +3704,8 @@ MatExpr operator <= (const Matx<_Tp, m, n>& a, const Mat& b) { return Mat(a) <=
 CV_EXPORTS MatExpr operator == (const Mat& a, const Mat& b);
 CV_EXPORTS MatExpr operator == (const Mat& a, double s);
 CV_EXPORTS MatExpr operator == (double s, const Mat& a);
+CV_EXPORTS MatExpr operator == (const MatExpr& e, double s);
+CV_EXPORTS MatExpr operator == (double s, const MatExpr& e);
 template<typename _Tp, int m, int n> static inline
 MatExpr operator == (const Mat& a, const Matx<_Tp, m, n>& b) { return a == Mat(b); }
 template<typename _Tp, int m, int n> static inline
@@ -3707,6 +3714,8 @@ MatExpr operator == (const Matx<_Tp, m, n>& a, const Mat& b) { return Mat(a) ==
 CV_EXPORTS MatExpr operator != (const Mat& a, const Mat& b);
 CV_EXPORTS MatExpr operator != (const Mat& a, double s);
 CV_EXPORTS MatExpr operator != (double s, const Mat& a);
+CV_EXPORTS MatExpr operator != (const MatExpr& e, double s);
+CV_EXPORTS MatExpr operator != (double s, const MatExpr& e);
 template<typename _Tp, int m, int n> static inline
 MatExpr operator != (const Mat& a, const Matx<_Tp, m, n>& b) { return a != Mat(b); }
 template<typename _Tp, int m, int n> static inline
@@ -3715,6 +3724,8 @@ MatExpr operator != (const Matx<_Tp, m, n>& a, const Mat& b) { return Mat(a) !=
 CV_EXPORTS MatExpr operator >= (const Mat& a, const Mat& b);
 CV_EXPORTS MatExpr operator >= (const Mat& a, double s);
 CV_EXPORTS MatExpr operator >= (double s, const Mat& a);
+CV_EXPORTS MatExpr operator >= (const MatExpr& e, double s);
+CV_EXPORTS MatExpr operator >= (double s, const MatExpr& e);
 template<typename _Tp, int m, int n> static inline
 MatExpr operator >= (const Mat& a, const Matx<_Tp, m, n>& b) { return a >= Mat(b); }
 template<typename _Tp, int m, int n> static inline
@@ -3723,6 +3734,8 @@ MatExpr operator >= (const Matx<_Tp, m, n>& a, const Mat& b) { return Mat(a) >=
 CV_EXPORTS MatExpr operator > (const Mat& a, const Mat& b);
 CV_EXPORTS MatExpr operator > (const Mat& a, double s);
 CV_EXPORTS MatExpr operator > (double s, const Mat& a);
+CV_EXPORTS MatExpr operator > (const MatExpr& e, double s);
+CV_EXPORTS MatExpr operator > (double s, const MatExpr& e);
 template<typename _Tp, int m, int n> static inline
 MatExpr operator > (const Mat& a, const Matx<_Tp, m, n>& b) { return a > Mat(b); }
 template<typename _Tp, int m, int n> static inline
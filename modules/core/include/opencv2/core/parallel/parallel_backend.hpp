@@ -47,6 +47,13 @@ namespace cv { namespace parallel {
  * - disable backend: `OPENCV_PARALLEL_PRIORITY_<backend>=0`
  * - specify list of backends with high priority (>100000): `OPENCV_PARALLEL_PRIORITY_LIST=TBB,OPENMP`. Unknown backends are registered as new plugins.
  *
+ * ### Builtin work-stealing backend
+ *
+ * `WORKSTEALING` is a builtin thread pool with per-thread task deques. Unlike other backends, nested `parallel_for_()`
+ * calls and calls from several application threads are executed in parallel on the same pool instead of being
+ * serialized. It is not selected by default: use `OPENCV_PARALLEL_BACKEND=WORKSTEALING` or
+ * `setParallelForBackend("WORKSTEALING")`.
+ *
  */
 
 /** Interface for parallel_for backends implementations
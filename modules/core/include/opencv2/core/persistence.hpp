@@ -296,6 +296,7 @@ A complete example using the FileStorage interface
 
 class CV_EXPORTS FileNode;
 class CV_EXPORTS FileNodeIterator;
+class CV_EXPORTS FileStorageStreamHandler;
 
 /** @brief XML/YAML/JSON file storage class that encapsulates all the information necessary for writing or
 reading data to/from a file.
@@ -316,6 +317,17 @@ public:
         FORMAT_XML  = (1<<3), //!< flag, XML format
         FORMAT_YAML = (2<<3), //!< flag, YAML format
         FORMAT_JSON = (3<<3), //!< flag, JSON format
+        FORMAT_BINARY = (4<<3), /**< flag, binary format. Raw data (e.g. content of matrices) is stored as
+                                     aligned blocks, the file is memory-mapped on reading and matrices reference
+                                     the mapped data without copying. Matrices read from the same node share the
+                                     data, so modification of one of them is visible in the others (use
+                                     Mat::clone() to get an independent copy). The mapping is copy-on-write,
+                                     the file is never modified, but it must not be truncated while such matrices
+                                     exist: access to the pages beyond its new end raises SIGBUS. Elements
+                                     of raw data blocks are available through FileNode::readRaw(), operator >>
+                                     and FileNode::mat(), but not as separate nodes. Must be specified explicitly
+                                     for writing (FileStorage::MEMORY and FileStorage::APPEND are not supported),
+                                     the format is detected automatically on reading. */
 
         BASE64      = 64,     //!< flag, write rawdata in Base64 by default. (consider using WRITE_BASE64)
         WRITE_BASE64 = BASE64 | WRITE, //!< flag, enable both WRITE and BASE64
@@ -353,7 +365,7 @@ public:
      FileStorage::WRITE and FileStorage::MEMORY flags are specified, source is used just to specify
      the output file format (e.g. mydata.xml, .yml etc.). A file name can also contain parameters.
      You can use this format, "*?base64" (e.g. "file.json?base64" (case sensitive)), as an alternative to
-     FileStorage::BASE64 flag.
+     FileStorage::BASE64 flag. Binary storages (see FileStorage::FORMAT_BINARY) are detected by the file content.
      @param flags Mode of operation. One of FileStorage::Mode
      @param encoding Encoding of the file. Note that UTF-16 XML encoding is not supported currently and
      you should use 8-bit encoding instead of it.
@@ -459,6 +471,32 @@ public:
      */
     CV_WRAP int getFormat() const;
 
+    /** @brief Reads the storage incrementally and passes its nodes to the handler.
+
+     Unlike open(), the method does not keep the whole document in memory. Nodes are passed to the handler
+     as soon as they are parsed and their memory is reused after the handler returns, so the memory
+     consumption is defined by the largest node at the depth `maxDepth` rather than by the file size.
+     Base64-encoded data of such node (e.g. matrix data) is decoded when the node is parsed and is released
+     together with the node. Long lines of JSON files are parsed by chunks, so minified files are read in
+     constant memory too.
+
+     The root mapping of every stream (document) has depth 0, the top-level nodes have depth 1.
+     Collections with depth less than `maxDepth` are reported by FileStorageStreamHandler::startCollection()
+     and FileStorageStreamHandler::endCollection() calls, other nodes with depth up to `maxDepth` are passed
+     to FileStorageStreamHandler::node() together with all their elements.
+
+     Binary storages (see FileStorage::FORMAT_BINARY) are memory-mapped and their node tree is traversed
+     in place.
+     @param filename Name of the file to read or the text string to read the data from (with FileStorage::MEMORY flag).
+     @param handler The handler of the storage nodes.
+     @param maxDepth Depth of the nodes which are passed to the handler with all their elements.
+     @param flags Mode of operation: FileStorage::READ with optional FileStorage::MEMORY.
+     @param encoding Encoding of the file, see open().
+     @returns false if the storage can't be opened or it is empty.
+     */
+    static bool readStream(const String& filename, FileStorageStreamHandler& handler, int maxDepth = 1,
+                           int flags = READ, const String& encoding = String());
+
     int state;
     std::string elname;
 
@@ -692,6 +730,35 @@ protected:
     size_t idx;
 };
 
+/** @brief Handler of the nodes of the storage which is read by FileStorage::readStream().
+
+ The nodes which are passed to the handler are valid only until the method returns, copy the data you need
+ (e.g. read matrices with `node >> m`) before returning. Throw an exception to stop reading.
+ */
+class CV_EXPORTS FileStorageStreamHandler
+{
+public:
+    virtual ~FileStorageStreamHandler();
+
+    /** @brief Called when a sequence or a mapping with depth less than `maxDepth` starts.
+     @param key Name of the collection or an empty string for sequence elements and roots of the streams.
+     @param type FileNode::SEQ or FileNode::MAP.
+     @param depth Depth of the collection.
+     */
+    virtual void startCollection(const String& key, int type, int depth);
+
+    /** @brief Called when all elements of the collection reported by startCollection() are passed.
+     */
+    virtual void endCollection(const String& key, int type, int depth);
+
+    /** @brief Called for every complete node with depth up to `maxDepth`, which is not reported by startCollection().
+     @param key Name of the node or an empty string for sequence elements.
+     @param node The node with all its elements.
+     @param depth Depth of the node.
+     */
+    virtual void node(const String& key, const FileNode& node, int depth) = 0;
+};
+
 //! @} core_xml
 
 /////////////////// XML & YAML I/O implementation //////////////////
@@ -233,6 +233,28 @@ The exact meaning of the return value depends on the threading framework used by
  */
 CV_EXPORTS_W int getThreadNum();
 
+/** @brief Counters of parallel_for_() calls
+
+The counters are collected since the program start or the last resetParallelForCounters() call,
+they show how often parallel regions are executed serially instead of being parallelized.
+*/
+struct CV_EXPORTS ParallelForCounters
+{
+    int64 calls;     //!< parallel_for_() calls with non-empty range
+    int64 parallel;  //!< calls passed to the threading framework
+    int64 nested;    //!< calls executed serially because they were made from a body of another parallel_for_() call
+    int64 serial;    //!< calls executed serially because of a single thread or a single stripe
+};
+
+/** @brief Returns counters of parallel_for_() calls of all threads
+
+@sa resetParallelForCounters
+*/
+CV_EXPORTS ParallelForCounters getParallelForCounters();
+
+//! Resets counters returned by getParallelForCounters()
+CV_EXPORTS void resetParallelForCounters();
+
 /** @brief Returns full configuration time cmake output.
 
 Returned value is raw cmake output including version control system revision, compiler version,
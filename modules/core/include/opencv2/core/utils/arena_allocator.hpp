@@ -0,0 +1,60 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#ifndef OPENCV_CORE_ARENA_ALLOCATOR_HPP
+#define OPENCV_CORE_ARENA_ALLOCATOR_HPP
+
+#include "../mat.hpp"
+#include "./allocator_stats.hpp"
+
+namespace cv { namespace utils {
+
+//! @addtogroup core_utils
+//! @{
+
+/** @brief Returns Mat allocator which reuses memory blocks through per-thread caches
+
+Freed blocks are kept in free lists of the thread which releases them, one list per power-of-two size class.
+The next allocation of the same size class by this thread takes the block from the list without calling the system
+allocator, so temporary Mats of repeated calls become cheap. Blocks larger than `OPENCV_ARENA_ALLOCATOR_MAX_BLOCK_SIZE`
+(16Mb by default) are not cached, every thread keeps up to `OPENCV_ARENA_ALLOCATOR_THREAD_CACHE_SIZE` (64Mb by default)
+of free blocks. Cached blocks are released when their thread exits or through releaseArenaAllocatorCache().
+
+Allocator is not used by default, install it through Mat::setDefaultAllocator(), ArenaAllocatorScope or
+Mat::allocator field of the specific matrix.
+*/
+CV_EXPORTS MatAllocator* getArenaAllocator();
+
+/** @brief Statistics of memory which is requested from the system by the arena allocator
+
+Memory is counted while it is used by matrices or kept in the caches. The number of allocations is the number of
+cache misses.
+*/
+CV_EXPORTS AllocatorStatisticsInterface& getArenaAllocatorStatistics();
+
+/** @brief Returns cached free blocks of the calling thread to the system */
+CV_EXPORTS void releaseArenaAllocatorCache();
+
+/** @brief Installs the arena allocator as the default Mat allocator for the lifetime of the object
+
+@note Default allocator is a global setting, it affects matrices which are created by all threads. Scopes must not
+be created by different threads concurrently.
+*/
+class CV_EXPORTS ArenaAllocatorScope
+{
+public:
+    ArenaAllocatorScope();
+    ~ArenaAllocatorScope();
+private:
+    MatAllocator* prevAllocator_;
+
+    ArenaAllocatorScope(const ArenaAllocatorScope&);  // disabled
+    ArenaAllocatorScope& operator=(const ArenaAllocatorScope&);  // disabled
+};
+
+//! @}
+
+}} // namespace
+
+#endif // OPENCV_CORE_ARENA_ALLOCATOR_HPP
@@ -0,0 +1,215 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "precomp.hpp"
+
+#include <opencv2/core/utils/arena_allocator.hpp>
+#include <opencv2/core/utils/allocator_stats.impl.hpp>
+#include <opencv2/core/utils/configuration.private.hpp>
+#include <opencv2/core/utils/tls.hpp>
+
+namespace cv { namespace utils {
+
+namespace {
+
+static size_t getArenaMaxBlockSize()
+{
+    static size_t value = utils::getConfigurationParameterSizeT("OPENCV_ARENA_ALLOCATOR_MAX_BLOCK_SIZE", (size_t)16 << 20);
+    return value;
+}
+
+static size_t getArenaThreadCacheSize()
+{
+    static size_t value = utils::getConfigurationParameterSizeT("OPENCV_ARENA_ALLOCATOR_THREAD_CACHE_SIZE", (size_t)64 << 20);
+    return value;
+}
+
+static AllocatorStatistics& getArenaStats()
+{
+    static AllocatorStatistics arena_stats;
+    return arena_stats;
+}
+
+enum
+{
+    ARENA_MIN_BLOCK_SHIFT = 6,  // 64 bytes, equal to CV_MALLOC_ALIGN
+    ARENA_SIZE_CLASSES = (int)sizeof(size_t) * 8 - ARENA_MIN_BLOCK_SHIFT
+};
+
+//! returns size class of the buffer, or -1 if the buffer is not cached
+static inline int getSizeClass(size_t size)
+{
+    if (size > getArenaMaxBlockSize())
+        return -1;
+    int size_class = 0;
+    while (((size_t)1 << (size_class + ARENA_MIN_BLOCK_SHIFT)) < size)
+        size_class++;
+    return size_class < ARENA_SIZE_CLASSES ? size_class : -1;
+}
+
+static inline size_t getBlockSize(int size_class)
+{
+    return (size_t)1 << (size_class + ARENA_MIN_BLOCK_SHIFT);
+}
+
+struct ArenaThreadCache
+{
+    ArenaThreadCache() : cached_size(0) {}
+    ~ArenaThreadCache() { release(); }
+
+    void* allocate(int size_class)
+    {
+        std::vector<void*>& blocks = free_blocks[size_class];
+        if (blocks.empty())
+            return NULL;
+        void* ptr = blocks.back();
+        blocks.pop_back();
+        cached_size -= getBlockSize(size_class);
+        return ptr;
+    }
+
+    bool deallocate(void* ptr, int size_class)
+    {
+        const size_t block_size = getBlockSize(size_class);
+        if (cached_size + block_size > getArenaThreadCacheSize())
+            return false;
+        free_blocks[size_class].push_back(ptr);
+        cached_size += block_size;
+        return true;
+    }
+
+    void release()
+    {
+        for (int i = 0; i < ARENA_SIZE_CLASSES; i++)
+        {
+            std::vector<void*>& blocks = free_blocks[i];
+            for (size_t j = 0; j < blocks.size(); j++)
+            {
+                fastFree(blocks[j]);
+                getArenaStats().onFree(getBlockSize(i));
+            }
+            blocks.clear();
+        }
+        cached_size = 0;
+    }
+
+    std::vector<void*> free_blocks[ARENA_SIZE_CLASSES];
+    size_t cached_size;
+};
+
+static TLSData<ArenaThreadCache>& getArenaThreadCacheTLS()
+{
+    CV_SINGLETON_LAZY_INIT_REF(TLSData<ArenaThreadCache>, new TLSData<ArenaThreadCache>())
+}
+
+class ArenaMatAllocator CV_FINAL : public MatAllocator
+{
+public:
+    UMatData* allocate(int dims, const int* sizes, int type,
+                       void* data0, size_t* step, AccessFlag /*flags*/, UMatUsageFlags /*usageFlags*/) const CV_OVERRIDE
+    {
+        size_t total = CV_ELEM_SIZE(type);
+        for( int i = dims-1; i >= 0; i-- )
+        {
+            if( step )
+            {
+                if( data0 && step[i] != CV_AUTOSTEP )
+                {
+                    CV_Assert(total <= step[i]);
+                    total = step[i];
+                }
+                else
+                    step[i] = total;
+            }
+            total *= sizes[i];
+        }
+        uchar* data = data0 ? (uchar*)data0 : allocateBlock(total);
+        UMatData* u = new UMatData(this);
+        u->data = u->origdata = data;
+        u->size = total;
+        if(data0)
+            u->flags |= UMatData::USER_ALLOCATED;
+
+        return u;
+    }
+
+    bool allocate(UMatData* u, AccessFlag /*accessFlags*/, UMatUsageFlags /*usageFlags*/) const CV_OVERRIDE
+    {
+        if(!u) return false;
+        return true;
+    }
+
+    void deallocate(UMatData* u) const CV_OVERRIDE
+    {
+        if(!u)
+            return;
+
+        CV_Assert(u->urefcount == 0);
+        CV_Assert(u->refcount == 0);
+        if( !(u->flags & UMatData::USER_ALLOCATED) )
+        {
+            deallocateBlock(u->origdata, u->size);
+            u->origdata = 0;
+        }
+        delete u;
+    }
+
+protected:
+    static uchar* allocateBlock(size_t size)
+    {
+        int size_class = getSizeClass(size);
+        if (size_class < 0)
+        {
+            uchar* data = (uchar*)fastMalloc(size);
+            getArenaStats().onAllocate(size);
+            return data;
+        }
+        void* data = getArenaThreadCacheTLS().get()->allocate(size_class);
+        if (!data)
+        {
+            data = fastMalloc(getBlockSize(size_class));
+            getArenaStats().onAllocate(getBlockSize(size_class));
+        }
+        return (uchar*)data;
+    }
+
+    static void deallocateBlock(uchar* data, size_t size)
+    {
+        int size_class = getSizeClass(size);
+        if (size_class >= 0 && getArenaThreadCacheTLS().get()->deallocate(data, size_class))
+            return;
+        fastFree(data);
+        getArenaStats().onFree(size_class >= 0 ? getBlockSize(size_class) : size);
+    }
+};
+
+}  // namespace
+
+MatAllocator* getArenaAllocator()
+{
+    CV_SINGLETON_LAZY_INIT(MatAllocator, new ArenaMatAllocator())
+}
+
+AllocatorStatisticsInterface& getArenaAllocatorStatistics()
+{
+    return getArenaStats();
+}
+
+void releaseArenaAllocatorCache()
+{
+    getArenaThreadCacheTLS().get()->release();
+}
+
+ArenaAllocatorScope::ArenaAllocatorScope()
+    : prevAllocator_(Mat::getDefaultAllocator())
+{
+    Mat::setDefaultAllocator(getArenaAllocator());
+}
+
+ArenaAllocatorScope::~ArenaAllocatorScope()
+{
+    Mat::setDefaultAllocator(prevAllocator_);
+}
+
+}} // namespace
@@ -0,0 +1,154 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "precomp.hpp"
+#include "bufferpool.impl.hpp"
+
+#include <opencv2/core/utils/configuration.private.hpp>
+
+namespace cv {
+
+StdBufferPool& StdBufferPool::getInstance()
+{
+    CV_SINGLETON_LAZY_INIT_REF(StdBufferPool, new StdBufferPool())
+}
+
+StdBufferPool::StdBufferPool()
+    : currentReservedSize(0),
+      maxReservedSize(utils::getConfigurationParameterSizeT("OPENCV_BUFFERPOOL_LIMIT", 0))
+{
+    // nothing
+}
+
+StdBufferPool::~StdBufferPool()
+{
+    freeAllReservedBuffers();
+}
+
+size_t StdBufferPool::getCapacity(size_t size)
+{
+    // heuristic values, same as for OpenCL buffers
+    size_t granularity;
+    if (size < 1024*1024)
+        granularity = 4096;
+    else if (size < 16*1024*1024)
+        granularity = 64*1024;
+    else
+        granularity = 1024*1024;
+    return alignSize(size, (int)granularity);
+}
+
+void* StdBufferPool::allocate(size_t size)
+{
+    const size_t limit = maxReservedSize.load();
+    const size_t capacity = getCapacity(size);
+    if (limit == 0 || size < 4096 || capacity > limit / 8)
+        return NULL;
+    {
+        AutoLock lock(mutex_);
+        BucketMap::iterator i = buckets_.find(capacity);
+        if (i != buckets_.end())
+        {
+            EntryList::iterator e = i->second;
+            void* ptr = e->ptr;
+            buckets_.erase(i);
+            reservedEntries_.erase(e);
+            currentReservedSize -= capacity;
+            statistics.hits++;
+            return ptr;
+        }
+        statistics.misses++;
+    }
+    return fastMalloc(capacity);
+}
+
+void StdBufferPool::release(void* ptr, size_t size)
+{
+    const size_t capacity = getCapacity(size);
+    {
+        AutoLock lock(mutex_);
+        const size_t limit = maxReservedSize.load();
+        if (limit > 0 && capacity <= limit / 8)
+        {
+            Entry entry;
+            entry.ptr = ptr;
+            entry.capacity = capacity;
+            reservedEntries_.push_front(entry);
+            buckets_.insert(std::make_pair(capacity, reservedEntries_.begin()));
+            currentReservedSize += capacity;
+            _releaseLRUEntries(limit);
+            return;
+        }
+    }
+    fastFree(ptr);
+}
+
+void StdBufferPool::_releaseLRUEntries(size_t limit)
+{
+    while (currentReservedSize > limit)
+    {
+        CV_DbgAssert(!reservedEntries_.empty());
+        EntryList::iterator e = --reservedEntries_.end();
+        std::pair<BucketMap::iterator, BucketMap::iterator> bucket = buckets_.equal_range(e->capacity);
+        for (BucketMap::iterator i = bucket.first; i != bucket.second; ++i)
+        {
+            if (i->second == e)
+            {
+                buckets_.erase(i);
+                break;
+            }
+        }
+        CV_DbgAssert(currentReservedSize >= e->capacity);
+        currentReservedSize -= e->capacity;
+        fastFree(e->ptr);
+        reservedEntries_.erase(e);
+    }
+}
+
+size_t StdBufferPool::getReservedSize() const
+{
+    AutoLock lock(mutex_);
+    return currentReservedSize;
+}
+
+size_t StdBufferPool::getMaxReservedSize() const
+{
+    return maxReservedSize.load();
+}
+
+void StdBufferPool::setMaxReservedSize(size_t size)
+{
+    AutoLock lock(mutex_);
+    maxReservedSize = size;
+    // drop buffers which are not pooled with the new limit
+    for (BucketMap::iterator i = buckets_.upper_bound(size / 8); i != buckets_.end();)
+    {
+        EntryList::iterator e = i->second;
+        currentReservedSize -= e->capacity;
+        fastFree(e->ptr);
+        reservedEntries_.erase(e);
+        buckets_.erase(i++);
+    }
+    _releaseLRUEntries(size);
+}
+
+void StdBufferPool::freeAllReservedBuffers()
+{
+    AutoLock lock(mutex_);
+    _releaseLRUEntries(0);
+}
+
+BufferPoolStatistics StdBufferPool::getStatistics() const
+{
+    AutoLock lock(mutex_);
+    return statistics;
+}
+
+void StdBufferPool::resetStatistics()
+{
+    AutoLock lock(mutex_);
+    statistics = BufferPoolStatistics();
+}
+
+} // namespace
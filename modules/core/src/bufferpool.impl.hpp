@@ -9,6 +9,10 @@
 
 #include "opencv2/core/bufferpool.hpp"
 
+#include <atomic>
+#include <list>
+#include <map>
+
 namespace cv {
 
 class DummyBufferPoolController : public BufferPoolController
@@ -23,6 +27,54 @@ public:
     virtual void freeAllReservedBuffers() CV_OVERRIDE { }
 };
 
+/** Pool of host memory buffers for the standard Mat allocator
+
+Released buffers are kept in buckets of the same capacity (size rounded up to the allocation granularity) and reused
+by allocations of the same bucket. Pool is disabled while the max reserved size is 0 (default value is controlled by
+OPENCV_BUFFERPOOL_LIMIT). Buffers smaller than 4Kb or larger than 1/8 of the limit are not pooled.
+*/
+class StdBufferPool : public BufferPoolController
+{
+public:
+    static StdBufferPool& getInstance();
+
+    /// returns NULL if buffer should not be pooled
+    void* allocate(size_t size);
+    /// `size` must be the same as in allocate() call
+    void release(void* ptr, size_t size);
+
+    virtual size_t getReservedSize() const CV_OVERRIDE;
+    virtual size_t getMaxReservedSize() const CV_OVERRIDE;
+    virtual void setMaxReservedSize(size_t size) CV_OVERRIDE;
+    virtual void freeAllReservedBuffers() CV_OVERRIDE;
+    virtual BufferPoolStatistics getStatistics() const CV_OVERRIDE;
+    virtual void resetStatistics() CV_OVERRIDE;
+
+protected:
+    StdBufferPool();
+    virtual ~StdBufferPool();
+
+    struct Entry
+    {
+        void* ptr;
+        size_t capacity;
+    };
+    typedef std::list<Entry> EntryList;
+    typedef std::multimap<size_t, EntryList::iterator> BucketMap;
+
+    static size_t getCapacity(size_t size);
+    // synchronized
+    void _releaseLRUEntries(size_t limit);
+
+    mutable Mutex mutex_;
+    size_t currentReservedSize;
+    std::atomic<size_t> maxReservedSize;
+    BufferPoolStatistics statistics;
+
+    EntryList reservedEntries_;  // LRU order, the most recently released buffers first
+    BucketMap buckets_;  // capacity => entry of reservedEntries_
+};
+
 } // namespace
 
 #endif // __OPENCV_CORE_BUFFER_POOL_IMPL_HPP__
@@ -728,6 +728,230 @@ static void GEMMStore_64fc( const Complexd* c_data, size_t c_step,
     GEMMStore(c_data, c_step, d_buf, d_buf_step, d_data, d_step, d_size, alpha, beta, flags);
 }
 
+#if CV_SIMD
+// Packed-panel GEMM for the single-channel floating-point types.
+// op(A) is copied block by block (GEMM_PACKED_MC x GEMM_PACKED_KC) into micro-panels of
+// GEMM_PACKED_MR rows, op(B) (GEMM_PACKED_KC x NC) into micro-panels of two vector widths,
+// so that the micro-kernel reads both operands sequentially and keeps the whole
+// MR x NR tile of D in registers. Independent MC x NC tiles of D are processed in parallel.
+enum
+{
+    GEMM_PACKED_MR = 6,
+    GEMM_PACKED_MC = GEMM_PACKED_MR*12,
+    GEMM_PACKED_KC = 256,
+    GEMM_PACKED_NC_PANELS = 8
+};
+
+static inline v_float32 gemmPackedSetAll(float v) { return vx_setall_f32(v); }
+#if CV_SIMD_64F
+static inline v_float64 gemmPackedSetAll(double v) { return vx_setall_f64(v); }
+#endif
+
+template<typename T> static inline int gemmPackedNR()
+{
+    return VTraits<decltype(gemmPackedSetAll(T()))>::max_nlanes*2;
+}
+
+static inline bool useGemmPacked( Size d_size, int len )
+{
+    return d_size.width >= 32 && d_size.height >= 32 && len >= 32 &&
+           (double)d_size.width*d_size.height*len >= 64.*64.*64.;
+}
+
+// op(A)(i, p) = A[i*as0 + p*as1]; the rows of the last micro-panel are padded with zeros
+template<typename T> static void
+gemmPackA( const T* A, size_t as0, size_t as1, int mc, int kc, T* buf )
+{
+    const int MR = GEMM_PACKED_MR;
+    for( int i = 0; i < mc; i += MR )
+    {
+        int k, mr = std::min(mc - i, MR);
+        const T* a = A + i*as0;
+        for( int p = 0; p < kc; p++, buf += MR )
+        {
+            const T* ap = a + p*as1;
+            for( k = 0; k < mr; k++ )
+                buf[k] = ap[k*as0];
+            for( ; k < MR; k++ )
+                buf[k] = 0;
+        }
+    }
+}
+
+// op(B)(p, j) = B[p*bs0 + j*bs1]; the columns of the last micro-panel are padded with zeros
+template<typename T> static void
+gemmPackB( const T* B, size_t bs0, size_t bs1, int kc, int nc, T* buf )
+{
+    typedef decltype(gemmPackedSetAll(T())) VT;
+    const int nlanes = VTraits<VT>::max_nlanes, NR = nlanes*2;
+    for( int j = 0; j < nc; j += NR )
+    {
+        int k, nr = std::min(nc - j, NR);
+        const T* b = B + j*bs1;
+        for( int p = 0; p < kc; p++, buf += NR )
+        {
+            const T* bp = b + p*bs0;
+            if( bs1 == 1 && nr == NR )
+            {
+                v_store(buf, vx_load(bp));
+                v_store(buf + nlanes, vx_load(bp + nlanes));
+                continue;
+            }
+            for( k = 0; k < nr; k++ )
+                buf[k] = bp[k*bs1];
+            for( ; k < NR; k++ )
+                buf[k] = 0;
+        }
+    }
+}
+
+template<typename VT> static inline void
+gemmPackedStore( typename VTraits<VT>::lane_type* d, const VT& s0, const VT& s1, const VT& valpha )
+{
+    const int nlanes = VTraits<VT>::max_nlanes;
+    v_store(d, v_fma(s0, valpha, vx_load(d)));
+    v_store(d + nlanes, v_fma(s1, valpha, vx_load(d + nlanes)));
+}
+
+// d[0:MR, 0:NR] += alpha * a[0:MR, 0:kc] * b[0:kc, 0:NR] for one pair of packed micro-panels
+template<typename T> static void
+gemmPackedKernel( int kc, const T* a, const T* b, T* d, size_t ldd, T alpha )
+{
+    typedef decltype(gemmPackedSetAll(T())) VT;
+    const int nlanes = VTraits<VT>::max_nlanes;
+    VT z = gemmPackedSetAll(T(0));
+    VT s00 = z, s01 = z, s10 = z, s11 = z, s20 = z, s21 = z;
+    VT s30 = z, s31 = z, s40 = z, s41 = z, s50 = z, s51 = z;
+
+    for( int p = 0; p < kc; p++, a += GEMM_PACKED_MR, b += nlanes*2 )
+    {
+        VT b0 = vx_load(b), b1 = vx_load(b + nlanes);
+        VT a0 = gemmPackedSetAll(a[0]), a1 = gemmPackedSetAll(a[1]);
+        s00 = v_fma(a0, b0, s00); s01 = v_fma(a0, b1, s01);
+        s10 = v_fma(a1, b0, s10); s11 = v_fma(a1, b1, s11);
+        a0 = gemmPackedSetAll(a[2]); a1 = gemmPackedSetAll(a[3]);
+        s20 = v_fma(a0, b0, s20); s21 = v_fma(a0, b1, s21);
+        s30 = v_fma(a1, b0, s30); s31 = v_fma(a1, b1, s31);
+        a0 = gemmPackedSetAll(a[4]); a1 = gemmPackedSetAll(a[5]);
+        s40 = v_fma(a0, b0, s40); s41 = v_fma(a0, b1, s41);
+        s50 = v_fma(a1, b0, s50); s51 = v_fma(a1, b1, s51);
+    }
+
+    VT valpha = gemmPackedSetAll(alpha);
+    gemmPackedStore(d, s00, s01, valpha);
+    gemmPackedStore(d + ldd, s10, s11, valpha);
+    gemmPackedStore(d + ldd*2, s20, s21, valpha);
+    gemmPackedStore(d + ldd*3, s30, s31, valpha);
+    gemmPackedStore(d + ldd*4, s40, s41, valpha);
+    gemmPackedStore(d + ldd*5, s50, s51, valpha);
+}
+
+template<typename T> class GEMMPackedInvoker : public ParallelLoopBody
+{
+public:
+    GEMMPackedInvoker( const Mat& _A, const Mat& _B, const Mat& _C, const Mat& _D,
+                       T _alpha, T _beta, int _flags, int _len )
+        : A(_A), B(_B), C(_C), D(_D), alpha(_alpha), beta(_beta), flags(_flags), len(_len)
+    {
+        NR = gemmPackedNR<T>();
+        NC = NR*GEMM_PACKED_NC_PANELS;
+        nTilesX = (D.cols + NC - 1)/NC;
+    }
+
+    int tiles() const { return nTilesX*((D.rows + GEMM_PACKED_MC - 1)/GEMM_PACKED_MC); }
+
+    void operator()( const Range& range ) const CV_OVERRIDE
+    {
+        const int MR = GEMM_PACKED_MR, MC = GEMM_PACKED_MC, KC = GEMM_PACKED_KC;
+        const size_t esz = sizeof(T);
+        size_t as0 = A.step/esz, as1 = 1, bs0 = B.step/esz, bs1 = 1;
+        size_t ldd = D.step/esz, ldc = C.empty() ? 0 : C.step/esz;
+        if( flags & GEMM_1_T )
+            std::swap(as0, as1);
+        if( flags & GEMM_2_T )
+            std::swap(bs0, bs1);
+
+        AutoBuffer<T> _buf((size_t)MC*KC + (size_t)KC*NC + MR*NR);
+        T* packA = _buf.data();
+        T* packB = packA + MC*KC;
+        T* tmp = packB + KC*NC;
+
+        for( int tile = range.start; tile < range.end; tile++ )
+        {
+            int i0 = (tile / nTilesX)*MC, j0 = (tile % nTilesX)*NC;
+            int mc = std::min(D.rows - i0, MC), nc = std::min(D.cols - j0, NC);
+            T* d0 = (T*)D.ptr<T>(i0) + j0;
+
+            for( int i = 0; i < mc; i++ )
+            {
+                T* d = d0 + i*ldd;
+                if( C.empty() )
+                    memset(d, 0, nc*esz);
+                else if( !(flags & GEMM_3_T) )
+                {
+                    const T* c = C.ptr<T>(i0 + i) + j0;
+                    for( int j = 0; j < nc; j++ )
+                        d[j] = beta*c[j];
+                }
+                else
+                {
+                    const T* c = C.ptr<T>() + (size_t)j0*ldc + i0 + i;
+                    for( int j = 0; j < nc; j++ )
+                        d[j] = beta*c[j*ldc];
+                }
+            }
+
+            for( int k0 = 0; k0 < len; k0 += KC )
+            {
+                int kc = std::min(len - k0, KC);
+                gemmPackA(A.ptr<T>() + i0*as0 + k0*as1, as0, as1, mc, kc, packA);
+                gemmPackB(B.ptr<T>() + k0*bs0 + j0*bs1, bs0, bs1, kc, nc, packB);
+
+                for( int i = 0; i < mc; i += MR )
+                {
+                    int mr = std::min(mc - i, MR);
+                    for( int j = 0; j < nc; j += NR )
+                    {
+                        int nr = std::min(nc - j, NR);
+                        const T* a = packA + i*kc;
+                        const T* b = packB + j*kc;
+                        T* d = d0 + i*ldd + j;
+                        if( mr == MR && nr == NR )
+                        {
+                            gemmPackedKernel(kc, a, b, d, ldd, alpha);
+                            continue;
+                        }
+                        memset(tmp, 0, MR*NR*esz);
+                        gemmPackedKernel(kc, a, b, tmp, (size_t)NR, alpha);
+                        for( int y = 0; y < mr; y++ )
+                            for( int x = 0; x < nr; x++ )
+                                d[y*ldd + x] += tmp[y*NR + x];
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    const Mat& A;
+    const Mat& B;
+    const Mat& C;
+    const Mat& D;
+    T alpha, beta;
+    int flags, len;
+    int NR, NC, nTilesX;
+};
+
+template<typename T> static void
+gemmPacked( const Mat& A, const Mat& B, double alpha, const Mat& C, double beta, Mat& D, int flags, int len )
+{
+    CV_INSTRUMENT_REGION();
+
+    GEMMPackedInvoker<T> invoker(A, B, C, D, (T)alpha, (T)beta, flags, len);
+    parallel_for_(Range(0, invoker.tiles()), invoker);
+}
+#endif
+
 static void gemmImpl( Mat A, Mat B, double alpha,
            Mat C, double beta, Mat D, int flags )
 {
@@ -1020,6 +1244,21 @@ static void gemmImpl( Mat A, Mat B, double alpha,
         }
     }
 
+#if CV_SIMD
+    if( type == CV_32FC1 && useGemmPacked(d_size, len) )
+    {
+        gemmPacked<float>(A, B, alpha, C, beta, D, flags, len);
+        return;
+    }
+#if CV_SIMD_64F
+    if( type == CV_64FC1 && useGemmPacked(d_size, len) )
+    {
+        gemmPacked<double>(A, B, alpha, C, beta, D, flags, len);
+        return;
+    }
+#endif
+#endif
+
     {
     size_t b_step = B.step;
     GEMMSingleMulFunc singleMulFunc;
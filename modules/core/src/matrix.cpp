@@ -126,6 +126,11 @@ BufferPoolController* MatAllocator::getBufferPoolController(const char* id) cons
 class StdMatAllocator CV_FINAL : public MatAllocator
 {
 public:
+    enum AllocatorFlags
+    {
+        ALLOCATOR_FLAGS_BUFFER_POOL_USED = 1 << 0
+    };
+
     UMatData* allocate(int dims, const int* sizes, int type,
                        void* data0, size_t* step, AccessFlag /*flags*/, UMatUsageFlags /*usageFlags*/) const CV_OVERRIDE
     {
@@ -144,10 +149,20 @@ public:
             }
             total *= sizes[i];
         }
-        uchar* data = data0 ? (uchar*)data0 : (uchar*)fastMalloc(total);
+        uchar* data = (uchar*)data0;
+        int allocatorFlags = 0;
+        if (!data)
+        {
+            data = (uchar*)StdBufferPool::getInstance().allocate(total);
+            if (data)
+                allocatorFlags = ALLOCATOR_FLAGS_BUFFER_POOL_USED;
+            else
+                data = (uchar*)fastMalloc(total);
+        }
         UMatData* u = new UMatData(this);
         u->data = u->origdata = data;
         u->size = total;
+        u->allocatorFlags_ = allocatorFlags;
         if(data0)
             u->flags |= UMatData::USER_ALLOCATED;
 
@@ -169,11 +184,21 @@ public:
         CV_Assert(u->refcount == 0);
         if( !(u->flags & UMatData::USER_ALLOCATED) )
         {
-            fastFree(u->origdata);
+            if (u->allocatorFlags_ & ALLOCATOR_FLAGS_BUFFER_POOL_USED)
+                StdBufferPool::getInstance().release(u->origdata, u->size);
+            else
+                fastFree(u->origdata);
             u->origdata = 0;
         }
         delete u;
     }
+
+    BufferPoolController* getBufferPoolController(const char* id) const CV_OVERRIDE
+    {
+        if (id != NULL && strcmp(id, "CPU") != 0)
+            return MatAllocator::getBufferPoolController(id);
+        return &StdBufferPool::getInstance();
+    }
 };
 
 static
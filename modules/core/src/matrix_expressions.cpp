@@ -11,6 +11,7 @@
 
 #include "precomp.hpp"
 #include <opencv2/core/utils/logger.hpp>
+#include "opencv2/core/hal/intrin.hpp"
 
 namespace cv
 {
@@ -57,7 +58,9 @@ public:
     bool elementWise(const MatExpr& /*expr*/) const CV_OVERRIDE { return true; }
     void assign(const MatExpr& expr, Mat& m, int type=-1) const CV_OVERRIDE;
 
+    void add(const MatExpr& e1, const MatExpr& e2, MatExpr& res) const CV_OVERRIDE;
     void add(const MatExpr& e1, const Scalar& s, MatExpr& res) const CV_OVERRIDE;
+    void subtract(const MatExpr& e1, const MatExpr& e2, MatExpr& res) const CV_OVERRIDE;
     void subtract(const Scalar& s, const MatExpr& expr, MatExpr& res) const CV_OVERRIDE;
     void multiply(const MatExpr& e1, double s, MatExpr& res) const CV_OVERRIDE;
     void divide(double s, const MatExpr& e, MatExpr& res) const CV_OVERRIDE;
@@ -103,6 +106,75 @@ public:
 
 static MatOp_Cmp g_MatOp_Cmp;
 
+/* Elementwise chain, computed in a single pass over the operands:
+       t = saturate_cast<T>(alpha*a + beta*b + r)
+       dst = saturate_cast<T>(sign*t + gamma*c + shift)
+   where T is the type of operands. This is the result of the generic path, which stores the sum of two operands
+   into a temporary matrix and adds the third one to it. Without c there is no intermediate saturation:
+       dst = saturate_cast<T>(alpha*a + beta*b + shift)
+   With FUSED_ABS the absolute value is taken before saturation (as absdiff() does), with FUSED_CMP the saturated value
+   is compared with the threshold (cmpop is stored in FUSED_CMPOP_MASK bits).
+
+   Operands b and c are optional. Coefficients are stored as alpha, beta and s = Scalar(gamma, shift, threshold, r),
+   FUSED_NEG means sign = -1. FUSED_SWAP keeps the order of operands of the generic path, c goes first there.
+
+   Only expressions which are evaluated exactly in float are fused, so the result is the same as one of the generic
+   path bit by bit: integer operands with shifts and coefficients which keep all values exact in float, floating-point
+   ones with +-1 coefficients only.
+*/
+class MatOp_Fused CV_FINAL : public MatOp
+{
+public:
+    MatOp_Fused() {}
+    virtual ~MatOp_Fused() {}
+
+    enum
+    {
+        FUSED_CMPOP_MASK = 7,
+        FUSED_ABS = 8,
+        FUSED_CMP = 16,
+        FUSED_NEG = 32,
+        FUSED_SWAP = 64
+    };
+
+    bool elementWise(const MatExpr& /*expr*/) const CV_OVERRIDE { return true; }
+    void assign(const MatExpr& expr, Mat& m, int type=-1) const CV_OVERRIDE;
+
+    void add(const MatExpr& e, const Scalar& s, MatExpr& res) const CV_OVERRIDE;
+    void subtract(const Scalar& s, const MatExpr& e, MatExpr& res) const CV_OVERRIDE;
+    void multiply(const MatExpr& e, double s, MatExpr& res) const CV_OVERRIDE;
+    void abs(const MatExpr& e, MatExpr& res) const CV_OVERRIDE;
+
+    int type(const MatExpr& expr) const CV_OVERRIDE;
+
+    //! the chain above, coeffs[2] and m[2] are gamma and c
+    struct LinearForm
+    {
+        LinearForm() : n(0), shift(0), innerShift(0), innerSign(1), singleFirst(false), isAbs(false) {}
+        Mat m[3];
+        double coeffs[3];
+        int n;
+        double shift;
+        double innerShift;  // r, n == 3 only
+        double innerSign;  // sign, n == 3 only
+        bool singleFirst;  // FUSED_SWAP
+        bool isAbs;
+    };
+    static bool getLinearForm(const MatExpr& e, LinearForm& f);
+    //! checks that the float evaluation gives the same result as the generic path
+    static bool isExact(const LinearForm& f);
+
+    //! e1 + sign*e2 with 3 matrix operands. The fused expression stores one saturated sum of two operands,
+    //! so longer chains are split: the fused part is computed first, as the generic path does with the sum.
+    static bool makeSum(MatExpr& res, const MatExpr& e1, const MatExpr& e2, double sign);
+    static bool makeCmp(MatExpr& res, const MatExpr& e, int cmpop, double threshold);
+    static void makeExpr(MatExpr& res, int flags, const LinearForm& f, double threshold=0);
+    //! expression of the generic path: the sum of two operands is computed, c is added to it later
+    static void unfuse(const MatExpr& e, MatExpr& res);
+};
+
+static MatOp_Fused g_MatOp_Fused;
+
 class MatOp_GEMM CV_FINAL : public MatOp
 {
 public:
@@ -205,6 +277,7 @@ static inline bool isAddEx(const MatExpr& e) { return e.op == &g_MatOp_AddEx; }
 static inline bool isScaled(const MatExpr& e) { return isAddEx(e) && (!e.b.data || e.beta == 0) && e.s == Scalar(); }
 static inline bool isBin(const MatExpr& e, char c) { return e.op == &g_MatOp_Bin && e.flags == c; }
 static inline bool isCmp(const MatExpr& e) { return e.op == &g_MatOp_Cmp; }
+static inline bool isFused(const MatExpr& e) { return e.op == &g_MatOp_Fused; }
 static inline bool isReciprocal(const MatExpr& e) { return isBin(e,'/') && (!e.b.data || e.beta == 0); }
 static inline bool isT(const MatExpr& e) { return e.op == &g_MatOp_T; }
 static inline bool isInv(const MatExpr& e) { return e.op == &g_MatOp_Invert; }
@@ -966,6 +1039,24 @@ MatExpr operator < (double s, const Mat& a)
     return e;
 }
 
+static MatExpr makeCmpExpr(const MatExpr& e, int cmpop, double s)
+{
+    MatExpr res;
+    if( !MatOp_Fused::makeCmp(res, e, cmpop, s) )
+        MatOp_Cmp::makeExpr(res, cmpop, Mat(e), s);
+    return res;
+}
+
+MatExpr operator < (const MatExpr& e, double s)
+{
+    return makeCmpExpr(e, CV_CMP_LT, s);
+}
+
+MatExpr operator < (double s, const MatExpr& e)
+{
+    return makeCmpExpr(e, CV_CMP_GT, s);
+}
+
 MatExpr operator <= (const Mat& a, const Mat& b)
 {
     checkOperandsExist(a, b);
@@ -990,6 +1081,16 @@ MatExpr operator <= (double s, const Mat& a)
     return e;
 }
 
+MatExpr operator <= (const MatExpr& e, double s)
+{
+    return makeCmpExpr(e, CV_CMP_LE, s);
+}
+
+MatExpr operator <= (double s, const MatExpr& e)
+{
+    return makeCmpExpr(e, CV_CMP_GE, s);
+}
+
 MatExpr operator == (const Mat& a, const Mat& b)
 {
     checkOperandsExist(a, b);
@@ -1014,6 +1115,16 @@ MatExpr operator == (double s, const Mat& a)
     return e;
 }
 
+MatExpr operator == (const MatExpr& e, double s)
+{
+    return makeCmpExpr(e, CV_CMP_EQ, s);
+}
+
+MatExpr operator == (double s, const MatExpr& e)
+{
+    return makeCmpExpr(e, CV_CMP_EQ, s);
+}
+
 MatExpr operator != (const Mat& a, const Mat& b)
 {
     checkOperandsExist(a, b);
@@ -1038,6 +1149,16 @@ MatExpr operator != (double s, const Mat& a)
     return e;
 }
 
+MatExpr operator != (const MatExpr& e, double s)
+{
+    return makeCmpExpr(e, CV_CMP_NE, s);
+}
+
+MatExpr operator != (double s, const MatExpr& e)
+{
+    return makeCmpExpr(e, CV_CMP_NE, s);
+}
+
 MatExpr operator >= (const Mat& a, const Mat& b)
 {
     checkOperandsExist(a, b);
@@ -1062,6 +1183,16 @@ MatExpr operator >= (double s, const Mat& a)
     return e;
 }
 
+MatExpr operator >= (const MatExpr& e, double s)
+{
+    return makeCmpExpr(e, CV_CMP_GE, s);
+}
+
+MatExpr operator >= (double s, const MatExpr& e)
+{
+    return makeCmpExpr(e, CV_CMP_LE, s);
+}
+
 MatExpr operator > (const Mat& a, const Mat& b)
 {
     checkOperandsExist(a, b);
@@ -1086,6 +1217,16 @@ MatExpr operator > (double s, const Mat& a)
     return e;
 }
 
+MatExpr operator > (const MatExpr& e, double s)
+{
+    return makeCmpExpr(e, CV_CMP_GT, s);
+}
+
+MatExpr operator > (double s, const MatExpr& e)
+{
+    return makeCmpExpr(e, CV_CMP_LT, s);
+}
+
 MatExpr min(const Mat& a, const Mat& b)
 {
     CV_INSTRUMENT_REGION();
@@ -1350,6 +1491,24 @@ void MatOp_AddEx::assign(const MatExpr& e, Mat& m, int _type) const
 }
 
 
+void MatOp_AddEx::add(const MatExpr& e1, const MatExpr& e2, MatExpr& res) const
+{
+    CV_INSTRUMENT_REGION();
+
+    if( !MatOp_Fused::makeSum(res, e1, e2, 1) )
+        MatOp::add(e1, e2, res);
+}
+
+
+void MatOp_AddEx::subtract(const MatExpr& e1, const MatExpr& e2, MatExpr& res) const
+{
+    CV_INSTRUMENT_REGION();
+
+    if( !MatOp_Fused::makeSum(res, e1, e2, -1) )
+        MatOp::subtract(e1, e2, res);
+}
+
+
 void MatOp_AddEx::add(const MatExpr& e, const Scalar& s, MatExpr& res) const
 {
     CV_INSTRUMENT_REGION();
@@ -1522,6 +1681,568 @@ inline void MatOp_Cmp::makeExpr(MatExpr& res, int cmpop, const Mat& a, double al
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+namespace {
+
+struct FusedParams
+{
+    float alpha, beta, gamma, shift;
+    float innerShift, innerSign;
+    bool hasB;
+    bool hasC;  // operand c and the intermediate saturation
+    bool isAbs;
+    int cmpop;  // -1 to store the result
+    float threshold;
+    int cmpResult;  // 0 or 255 if the result of comparison doesn't depend on values, -1 otherwise
+};
+
+enum { FUSED_BLOCK_SIZE = 1024 };
+
+template<typename T> static inline float fusedSaturate(float v) { return (float)saturate_cast<T>(v); }
+template<> inline float fusedSaturate<float>(float v) { return v; }
+
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+static inline v_float32 fusedLoad(const float* ptr) { return vx_load(ptr); }
+static inline v_float32 fusedLoad(const uchar* ptr) { return v_cvt_f32(v_reinterpret_as_s32(vx_load_expand_q(ptr))); }
+
+static inline v_float32 fusedSaturate(const v_float32& v, const float*) { return v; }
+static inline v_float32 fusedSaturate(const v_float32& v, const uchar*)
+{
+    return v_cvt_f32(v_min(v_max(v_round(v), vx_setzero_s32()), vx_setall_s32(255)));
+}
+
+// Shifts are added separately: they are zero for floating-point data, where adding +0 would change the sign of -0
+template<typename T> static inline
+int fusedLinearSIMD(const T* a, const T* b, const T* c, float* buf, int n, const FusedParams& p)
+{
+    const int step = VTraits<v_float32>::vlanes();
+    const v_float32 v_alpha = vx_setall_f32(p.alpha), v_beta = vx_setall_f32(p.beta);
+    const v_float32 v_gamma = vx_setall_f32(p.gamma), v_shift = vx_setall_f32(p.shift);
+    const v_float32 v_ishift = vx_setall_f32(p.innerShift), v_isign = vx_setall_f32(p.innerSign);
+    int i = 0;
+    for( ; i <= n - step; i += step )
+    {
+        v_float32 v = v_mul(fusedLoad(a + i), v_alpha);
+        if( p.hasB )
+            v = v_fma(fusedLoad(b + i), v_beta, v);
+        if( p.hasC )
+        {
+            if( p.innerShift != 0 )
+                v = v_add(v, v_ishift);
+            v = v_fma(fusedLoad(c + i), v_gamma, v_mul(fusedSaturate(v, a), v_isign));
+        }
+        if( p.shift != 0 )
+            v = v_add(v, v_shift);
+        if( p.isAbs )
+            v = v_abs(v);
+        v_store(buf + i, fusedSaturate(v, a));
+    }
+    return i;
+}
+
+static inline int fusedLinearVec(const uchar* a, const uchar* b, const uchar* c, float* buf, int n, const FusedParams& p)
+{ return fusedLinearSIMD(a, b, c, buf, n, p); }
+static inline int fusedLinearVec(const float* a, const float* b, const float* c, float* buf, int n, const FusedParams& p)
+{ return fusedLinearSIMD(a, b, c, buf, n, p); }
+#endif
+template<typename T> static inline int fusedLinearVec(const T*, const T*, const T*, float*, int, const FusedParams&) { return 0; }
+
+//! buf = the chain of MatOp_Fused saturated to T
+template<typename T> static
+void fusedLinear(const T* a, const T* b, const T* c, float* buf, int n, const FusedParams& p)
+{
+    int i = fusedLinearVec(a, b, c, buf, n, p);
+    for( ; i < n; i++ )
+    {
+        float v = (float)a[i]*p.alpha;
+        if( p.hasB )
+            v = std::fma((float)b[i], p.beta, v);
+        if( p.hasC )
+        {
+            if( p.innerShift != 0 )
+                v += p.innerShift;
+            v = std::fma((float)c[i], p.gamma, fusedSaturate<T>(v)*p.innerSign);
+        }
+        if( p.shift != 0 )
+            v += p.shift;
+        buf[i] = fusedSaturate<T>(p.isAbs ? std::abs(v) : v);
+    }
+}
+
+template<typename DT> static
+void fusedStore(const float* buf, DT* dst, int n)
+{
+    for( int i = 0; i < n; i++ )
+        dst[i] = saturate_cast<DT>(buf[i]);
+}
+
+template<> void fusedStore<uchar>(const float* buf, uchar* dst, int n)
+{
+    int i = 0;
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+    const int step = VTraits<v_float32>::vlanes();
+    for( ; i <= n - 4*step; i += 4*step )
+    {
+        v_int16 w0 = v_pack(v_round(vx_load(buf + i)), v_round(vx_load(buf + i + step)));
+        v_int16 w1 = v_pack(v_round(vx_load(buf + i + 2*step)), v_round(vx_load(buf + i + 3*step)));
+        v_store(dst + i, v_pack_u(w0, w1));
+    }
+#endif
+    for( ; i < n; i++ )
+        dst[i] = saturate_cast<uchar>(buf[i]);
+}
+
+template<> void fusedStore<float>(const float* buf, float* dst, int n)
+{
+    memcpy(dst, buf, n*sizeof(float));
+}
+
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+static inline v_float32 fusedCmpVec(int cmpop, const v_float32& a, const v_float32& b)
+{
+    switch( cmpop )
+    {
+    case CMP_EQ: return v_eq(a, b);
+    case CMP_GT: return v_gt(a, b);
+    case CMP_GE: return v_ge(a, b);
+    case CMP_LT: return v_lt(a, b);
+    case CMP_LE: return v_le(a, b);
+    default: return v_ne(a, b);
+    }
+}
+#endif
+
+static inline bool fusedCmp(int cmpop, float a, float b)
+{
+    switch( cmpop )
+    {
+    case CMP_EQ: return a == b;
+    case CMP_GT: return a > b;
+    case CMP_GE: return a >= b;
+    case CMP_LT: return a < b;
+    case CMP_LE: return a <= b;
+    default: return a != b;
+    }
+}
+
+static void fusedCompare(const float* buf, uchar* dst, int n, const FusedParams& p)
+{
+    if( p.cmpResult >= 0 )
+    {
+        memset(dst, p.cmpResult, n);
+        return;
+    }
+    int i = 0;
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+    const int step = VTraits<v_float32>::vlanes();
+    const v_float32 v_thresh = vx_setall_f32(p.threshold);
+    for( ; i <= n - 4*step; i += 4*step )
+    {
+        v_int32 m0 = v_reinterpret_as_s32(fusedCmpVec(p.cmpop, vx_load(buf + i), v_thresh));
+        v_int32 m1 = v_reinterpret_as_s32(fusedCmpVec(p.cmpop, vx_load(buf + i + step), v_thresh));
+        v_int32 m2 = v_reinterpret_as_s32(fusedCmpVec(p.cmpop, vx_load(buf + i + 2*step), v_thresh));
+        v_int32 m3 = v_reinterpret_as_s32(fusedCmpVec(p.cmpop, vx_load(buf + i + 3*step), v_thresh));
+        v_store((schar*)(dst + i), v_pack(v_pack(m0, m1), v_pack(m2, m3)));
+    }
+#endif
+    for( ; i < n; i++ )
+        dst[i] = fusedCmp(p.cmpop, buf[i], p.threshold) ? 255 : 0;
+}
+
+typedef void (*FusedFunc)(const uchar* a, const uchar* b, const uchar* c, uchar* dst, size_t len, int ddepth, const FusedParams& p);
+
+template<typename T> static
+void fused_(const uchar* a_, const uchar* b_, const uchar* c_, uchar* dst, size_t len, int ddepth, const FusedParams& p)
+{
+    const T* a = (const T*)a_;
+    const T* b = (const T*)b_;
+    const T* c = (const T*)c_;
+    const size_t desz = CV_ELEM_SIZE1(ddepth);
+    float buf[FUSED_BLOCK_SIZE];
+    for( size_t i = 0; i < len; i += FUSED_BLOCK_SIZE )
+    {
+        int n = (int)std::min(len - i, (size_t)FUSED_BLOCK_SIZE);
+        fusedLinear(a + i, b + i, c + i, buf, n, p);
+        uchar* d = dst + i*desz;
+        if( p.cmpop >= 0 )
+            fusedCompare(buf, d, n, p);
+        else if( ddepth == CV_8U )
+            fusedStore(buf, d, n);
+        else if( ddepth == CV_8S )
+            fusedStore(buf, (schar*)d, n);
+        else if( ddepth == CV_16U )
+            fusedStore(buf, (ushort*)d, n);
+        else if( ddepth == CV_16S )
+            fusedStore(buf, (short*)d, n);
+        else if( ddepth == CV_32S )
+            fusedStore(buf, (int*)d, n);
+        else if( ddepth == CV_32F )
+            fusedStore(buf, (float*)d, n);
+        else if( ddepth == CV_64F )
+            fusedStore(buf, (double*)d, n);
+        else
+            CV_Error(cv::Error::StsUnsupportedFormat, "");
+    }
+}
+
+static FusedFunc getFusedFunc(int depth)
+{
+    switch( depth )
+    {
+    case CV_8U: return fused_<uchar>;
+    case CV_8S: return fused_<schar>;
+    case CV_16U: return fused_<ushort>;
+    case CV_16S: return fused_<short>;
+    case CV_32F: return fused_<float>;
+    default: return NULL;  // computations in float are not accurate enough
+    }
+}
+
+} // namespace
+
+bool MatOp_Fused::getLinearForm(const MatExpr& e, LinearForm& f)
+{
+    f = LinearForm();
+    if( isIdentity(e) )
+    {
+        f.m[0] = e.a; f.coeffs[0] = 1; f.n = 1;
+    }
+    else if( isAddEx(e) )
+    {
+        if( !e.s.isReal() )
+            return false;
+        f.m[0] = e.a; f.coeffs[0] = e.alpha; f.n = 1;
+        if( e.b.data && e.beta != 0 )
+        {
+            f.m[1] = e.b; f.coeffs[1] = e.beta; f.n = 2;
+        }
+        f.shift = e.s[0];
+    }
+    else if( isBin(e, 'a') )
+    {
+        f.m[0] = e.a; f.coeffs[0] = 1; f.n = 1;
+        if( e.b.data )
+        {
+            f.m[1] = e.b; f.coeffs[1] = -1; f.n = 2;
+        }
+        else if( e.s.isReal() )
+            f.shift = -e.s[0];
+        else
+            return false;
+        f.isAbs = true;
+    }
+    else if( isFused(e) && (e.flags & FUSED_CMP) == 0 )
+    {
+        f.m[0] = e.a; f.m[1] = e.b; f.m[2] = e.c;
+        f.coeffs[0] = e.alpha; f.coeffs[1] = e.beta; f.coeffs[2] = e.s[0];
+        f.n = e.c.data ? 3 : e.b.data ? 2 : 1;
+        f.shift = e.s[1];
+        f.innerShift = e.s[3];
+        f.innerSign = (e.flags & FUSED_NEG) ? -1 : 1;
+        f.singleFirst = (e.flags & FUSED_SWAP) != 0;
+        f.isAbs = (e.flags & FUSED_ABS) != 0;
+    }
+    else
+        return false;
+
+    const Mat& a = f.m[0];
+    if( !getFusedFunc(a.depth()) )
+        return false;
+    // scalar is added to the first channel only by other operations
+    if( a.channels() > 1 && f.shift != 0 )
+        return false;
+    for( int i = 1; i < f.n; i++ )
+    {
+        if( f.m[i].type() != a.type() || f.m[i].size != a.size )
+            return false;
+    }
+    return true;
+}
+
+// number of fractional bits of the value if it is a small dyadic fraction, -1 otherwise
+static int fusedFractionBits(double v)
+{
+    for( int bits = 0; bits <= 24; bits++ )
+    {
+        double scaled = std::ldexp(v, bits);
+        if( scaled == std::floor(scaled) )
+            return bits;
+    }
+    return -1;
+}
+
+bool MatOp_Fused::isExact(const LinearForm& f)
+{
+    const int depth = f.m[0].depth();
+    const double coeffs[] = { f.coeffs[0], f.n > 1 ? f.coeffs[1] : 0, f.n > 2 ? f.coeffs[2] : 0, f.n > 2 ? f.innerSign : 0 };
+    if( depth == CV_32F )
+    {
+        // the generic path uses add() and subtract() for these, one rounding per operation as here
+        for( int i = 0; i < f.n; i++ )
+        {
+            if( std::abs(coeffs[i]) != 1 )
+                return false;
+        }
+        if( f.n > 1 && coeffs[0] == -1 && coeffs[1] == -1 )
+            return false;
+        if( f.n > 2 && coeffs[2] == -1 && coeffs[3] == -1 )
+            return false;
+        return f.shift == 0 && f.innerShift == 0;
+    }
+
+    // integer values: all products and sums must be exact in float, so rounding and saturation give the same result.
+    // Scalars are converted to integers by add(), absdiff() and others
+    if( f.shift != std::floor(f.shift) || f.innerShift != std::floor(f.innerShift) )
+        return false;
+    int bits = 0;
+    for( int i = 0; i < 3; i++ )
+    {
+        int b = fusedFractionBits(coeffs[i]);
+        if( b < 0 )
+            return false;
+        bits = std::max(bits, b);
+    }
+    const double maxval = depth == CV_8U ? 255 : depth == CV_8S ? 128 : depth == CV_16U ? 65535 : 32768;
+    double bound = (std::abs(coeffs[0]) + std::abs(coeffs[1]))*maxval;
+    if( f.n > 2 )
+    {
+        bound += std::abs(f.innerShift);
+        if( std::ldexp(bound, bits) >= (1 << 24) )
+            return false;
+        bound = maxval + std::abs(coeffs[2])*maxval;  // the intermediate value is saturated
+    }
+    bound += std::abs(f.shift);
+    return std::ldexp(bound, bits) < (1 << 24);
+}
+
+bool MatOp_Fused::makeSum(MatExpr& res, const MatExpr& e1, const MatExpr& e2, double sign)
+{
+    LinearForm f1, f2;
+    if( !getLinearForm(e1, f1) || !getLinearForm(e2, f2) || f1.isAbs || f2.isAbs )
+        return false;
+    // sums of 2 operands are processed by addWeighted() and others
+    if( f1.n + f2.n != 3 || f1.m[0].type() != f2.m[0].type() || f1.m[0].size != f2.m[0].size )
+        return false;
+
+    // as MatOp::add() does: the sum of 2 operands goes to a temporary matrix, the single operand is added to it
+    const LinearForm& pair = f1.n == 2 ? f1 : f2;
+    const LinearForm& single = f1.n == 2 ? f2 : f1;
+    const double singleSign = f1.n == 2 ? sign : 1;
+    LinearForm f;
+    f.n = 3;
+    f.m[0] = pair.m[0]; f.coeffs[0] = pair.coeffs[0];
+    f.m[1] = pair.m[1]; f.coeffs[1] = pair.coeffs[1];
+    f.innerShift = pair.shift;
+    f.innerSign = f1.n == 2 ? 1 : sign;
+    f.m[2] = single.m[0]; f.coeffs[2] = singleSign*single.coeffs[0];
+    f.shift = singleSign*single.shift;
+    f.singleFirst = f1.n == 1;
+    if( !isExact(f) )
+        return false;
+    makeExpr(res, 0, f);
+    return true;
+}
+
+bool MatOp_Fused::makeCmp(MatExpr& res, const MatExpr& e, int cmpop, double threshold)
+{
+    LinearForm f;
+    // comparison of a matrix is processed by compare()
+    if( isIdentity(e) || !getLinearForm(e, f) || f.m[0].channels() > 1 || !isExact(f) )
+        return false;
+    makeExpr(res, FUSED_CMP | cmpop, f, threshold);
+    return true;
+}
+
+void MatOp_Fused::makeExpr(MatExpr& res, int flags, const LinearForm& f, double threshold)
+{
+    flags |= f.isAbs ? FUSED_ABS : 0;
+    flags |= f.n > 2 && f.innerSign < 0 ? FUSED_NEG : 0;
+    flags |= f.n > 2 && f.singleFirst ? FUSED_SWAP : 0;
+    res = MatExpr(&g_MatOp_Fused, flags, f.m[0], f.n > 1 ? f.m[1] : Mat(), f.n > 2 ? f.m[2] : Mat(),
+                  f.coeffs[0], f.n > 1 ? f.coeffs[1] : 0,
+                  Scalar(f.n > 2 ? f.coeffs[2] : 0, f.shift, threshold, f.n > 2 ? f.innerShift : 0));
+}
+
+void MatOp_Fused::unfuse(const MatExpr& e, MatExpr& res)
+{
+    CV_Assert( e.c.data && (e.flags & (FUSED_CMP | FUSED_ABS)) == 0 );
+    MatExpr pair;
+    MatOp_AddEx::makeExpr(pair, e.a, e.b, e.alpha, e.beta, Scalar(e.s[3]));
+    Mat m;
+    pair.op->assign(pair, m);
+    const double sign = (e.flags & FUSED_NEG) ? -1 : 1;
+    if( e.flags & FUSED_SWAP )
+        MatOp_AddEx::makeExpr(res, e.c, m, e.s[0], sign, Scalar(e.s[1]));
+    else
+        MatOp_AddEx::makeExpr(res, m, e.c, sign, e.s[0], Scalar(e.s[1]));
+}
+
+// Operations with scalars are folded into the expression as MatOp_AddEx does, if the result stays exact
+
+void MatOp_Fused::add(const MatExpr& e, const Scalar& s, MatExpr& res) const
+{
+    CV_INSTRUMENT_REGION();
+
+    LinearForm f;
+    if( (e.flags & FUSED_CMP) == 0 && s.isReal() && getLinearForm(e, f) )
+    {
+        f.shift += s[0];
+        if( (f.m[0].channels() == 1 || f.shift == 0) && isExact(f) )
+        {
+            makeExpr(res, 0, f);
+            return;
+        }
+    }
+    if( (e.flags & FUSED_CMP) == 0 )
+    {
+        MatExpr u;
+        unfuse(e, u);
+        u.op->add(u, s, res);
+    }
+    else
+        MatOp::add(e, s, res);
+}
+
+void MatOp_Fused::subtract(const Scalar& s, const MatExpr& e, MatExpr& res) const
+{
+    CV_INSTRUMENT_REGION();
+
+    LinearForm f;
+    if( (e.flags & FUSED_CMP) == 0 && s.isReal() && getLinearForm(e, f) )
+    {
+        // the sum of two operands is not changed, it is subtracted as a whole
+        f.innerSign = -f.innerSign;
+        f.coeffs[2] = -f.coeffs[2];
+        f.shift = s[0] - f.shift;
+        if( (f.m[0].channels() == 1 || f.shift == 0) && isExact(f) )
+        {
+            makeExpr(res, 0, f);
+            return;
+        }
+    }
+    if( (e.flags & FUSED_CMP) == 0 )
+    {
+        MatExpr u;
+        unfuse(e, u);
+        u.op->subtract(s, u, res);
+    }
+    else
+        MatOp::subtract(s, e, res);
+}
+
+void MatOp_Fused::multiply(const MatExpr& e, double s, MatExpr& res) const
+{
+    CV_INSTRUMENT_REGION();
+
+    LinearForm f;
+    // the sign of the sum of two operands is a flag, other factors are applied by the generic path
+    if( (e.flags & FUSED_CMP) == 0 && std::abs(s) == 1 && getLinearForm(e, f) )
+    {
+        f.innerSign *= s;
+        f.coeffs[2] *= s;
+        f.shift *= s;
+        if( isExact(f) )
+        {
+            makeExpr(res, 0, f);
+            return;
+        }
+    }
+    if( (e.flags & FUSED_CMP) == 0 )
+    {
+        MatExpr u;
+        unfuse(e, u);
+        u.op->multiply(u, s, res);
+    }
+    else
+        MatOp::multiply(e, s, res);
+}
+
+void MatOp_Fused::abs(const MatExpr& e, MatExpr& res) const
+{
+    CV_INSTRUMENT_REGION();
+
+    // abs() of a difference is absdiff() of the operands in the generic path
+    if( (e.flags & FUSED_CMP) == 0 )
+    {
+        MatExpr u;
+        unfuse(e, u);
+        u.op->abs(u, res);
+    }
+    else
+        MatOp::abs(e, res);
+}
+
+int MatOp_Fused::type(const MatExpr& e) const
+{
+    CV_INSTRUMENT_REGION();
+
+    if( e.flags & FUSED_CMP )
+        return CV_8UC(e.a.channels());
+    return e.a.type();
+}
+
+void MatOp_Fused::assign(const MatExpr& e, Mat& m, int _type) const
+{
+    const bool isCmp = (e.flags & FUSED_CMP) != 0;
+    const int depth = e.a.depth(), cn = e.a.channels();
+    const int rtype = isCmp ? CV_8UC(cn) : e.a.type();
+    int dtype = rtype;
+    if( _type != -1 && !isCmp && CV_MAT_DEPTH(_type) != CV_16F )
+    {
+        // saturate_cast<> to the requested type is fused too
+        CV_Assert( CV_MAT_CN(_type) == cn );
+        dtype = _type;
+    }
+    Mat temp, &dst = _type == -1 || _type == dtype ? m : temp;
+
+    FusedParams p;
+    p.alpha = (float)e.alpha;
+    p.beta = e.b.data ? (float)e.beta : 0.f;
+    p.gamma = e.c.data ? (float)e.s[0] : 0.f;
+    p.shift = (float)e.s[1];
+    p.innerShift = (float)e.s[3];
+    p.innerSign = (e.flags & FUSED_NEG) ? -1.f : 1.f;
+    p.hasB = e.b.data != NULL;
+    p.hasC = e.c.data != NULL;
+    p.isAbs = (e.flags & FUSED_ABS) != 0;
+    p.cmpop = isCmp ? (e.flags & FUSED_CMPOP_MASK) : -1;
+    p.threshold = 0;
+    p.cmpResult = -1;
+    if( isCmp )
+    {
+        double thresh = e.s[2];
+        if( depth != CV_32F )
+        {
+            // values are integers, use the same rules as compare()
+            if( p.cmpop == CMP_GT || p.cmpop == CMP_LE )
+                thresh = std::floor(thresh);
+            else if( p.cmpop == CMP_LT || p.cmpop == CMP_GE )
+                thresh = std::ceil(thresh);
+            else if( thresh != std::floor(thresh) )
+                p.cmpResult = p.cmpop == CMP_EQ ? 0 : 255;
+            thresh = std::min(std::max(thresh, -65536.), 65536.);
+        }
+        p.threshold = saturate_cast<float>(thresh);
+    }
+
+    // missing operands are replaced by 'a' for the iterator, they are not read
+    Mat a = e.a, b = e.b.data ? e.b : e.a, c = e.c.data ? e.c : e.a;
+    dst.create(a.dims, a.size, dtype);
+
+    FusedFunc func = getFusedFunc(depth);
+    CV_Assert(func);
+    const Mat* arrays[] = { &a, &b, &c, &dst, 0 };
+    uchar* ptrs[4] = {};
+    NAryMatIterator it(arrays, ptrs);
+    const size_t len = it.size*cn;
+    for( size_t i = 0; i < it.nplanes; i++, ++it )
+        func(ptrs[0], ptrs[1], ptrs[2], ptrs[3], len, CV_MAT_DEPTH(dtype), p);
+
+    if( dst.data != m.data )
+        dst.convertTo(m, _type);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 void MatOp_T::assign(const MatExpr& e, Mat& m, int _type) const
 {
     Mat temp, &dst = _type == -1 || _type == e.a.type() ? m : temp;
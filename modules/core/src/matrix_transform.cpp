@@ -15,7 +15,7 @@ namespace cv {
 ////////////////////////////////////// transpose /////////////////////////////////////////
 
 template<typename T> static void
-transpose_( const uchar* src, size_t sstep, uchar* dst, size_t dstep, Size sz )
+transpose_( const uchar* src, ptrdiff_t sstep, uchar* dst, ptrdiff_t dstep, Size sz )
 {
     int i=0, j, m = sz.width, n = sz.height;
 
@@ -29,10 +29,10 @@ transpose_( const uchar* src, size_t sstep, uchar* dst, size_t dstep, Size sz )
 
         for( j = 0; j <= n - 4; j += 4 )
         {
-            const T* s0 = (const T*)(src + i*sizeof(T) + sstep*j);
-            const T* s1 = (const T*)(src + i*sizeof(T) + sstep*(j+1));
-            const T* s2 = (const T*)(src + i*sizeof(T) + sstep*(j+2));
-            const T* s3 = (const T*)(src + i*sizeof(T) + sstep*(j+3));
+            const T* s0 = (const T*)(src + sstep*j) + i;
+            const T* s1 = (const T*)(src + sstep*(j+1)) + i;
+            const T* s2 = (const T*)(src + sstep*(j+2)) + i;
+            const T* s3 = (const T*)(src + sstep*(j+3)) + i;
 
             d0[j] = s0[0]; d0[j+1] = s1[0]; d0[j+2] = s2[0]; d0[j+3] = s3[0];
             d1[j] = s0[1]; d1[j+1] = s1[1]; d1[j+2] = s2[1]; d1[j+3] = s3[1];
@@ -42,7 +42,7 @@ transpose_( const uchar* src, size_t sstep, uchar* dst, size_t dstep, Size sz )
 
         for( ; j < n; j++ )
         {
-            const T* s0 = (const T*)(src + i*sizeof(T) + j*sstep);
+            const T* s0 = (const T*)(src + j*sstep) + i;
             d0[j] = s0[0]; d1[j] = s0[1]; d2[j] = s0[2]; d3[j] = s0[3];
         }
     }
@@ -54,50 +54,115 @@ transpose_( const uchar* src, size_t sstep, uchar* dst, size_t dstep, Size sz )
         #if CV_ENABLE_UNROLLED
         for(; j <= n - 4; j += 4 )
         {
-            const T* s0 = (const T*)(src + i*sizeof(T) + sstep*j);
-            const T* s1 = (const T*)(src + i*sizeof(T) + sstep*(j+1));
-            const T* s2 = (const T*)(src + i*sizeof(T) + sstep*(j+2));
-            const T* s3 = (const T*)(src + i*sizeof(T) + sstep*(j+3));
+            const T* s0 = (const T*)(src + sstep*j) + i;
+            const T* s1 = (const T*)(src + sstep*(j+1)) + i;
+            const T* s2 = (const T*)(src + sstep*(j+2)) + i;
+            const T* s3 = (const T*)(src + sstep*(j+3)) + i;
 
             d0[j] = s0[0]; d0[j+1] = s1[0]; d0[j+2] = s2[0]; d0[j+3] = s3[0];
         }
         #endif
         for( ; j < n; j++ )
         {
-            const T* s0 = (const T*)(src + i*sizeof(T) + j*sstep);
+            const T* s0 = (const T*)(src + j*sstep) + i;
             d0[j] = s0[0];
         }
     }
 }
 
-template<typename T> static void
-transposeI_( uchar* data, size_t step, int n )
+#if CV_SIMD128
+// Transposes the square block of nlanes x nlanes elements in registers:
+// log2(nlanes) rounds of interleaving of the rows i and i + nlanes/2.
+template<typename VT> static inline void
+transposeRegs_( VT* a )
 {
-    for( int i = 0; i < n; i++ )
+    enum { n = VT::nlanes };
+    VT b[n];
+    for( int k = 1; k < n; k *= 2 )
     {
-        T* row = (T*)(data + step*i);
-        uchar* data1 = data + i*sizeof(T);
-        for( int j = i+1; j < n; j++ )
-            std::swap( row[j], *(T*)(data1 + step*j) );
+        for( int i = 0; i < n/2; i++ )
+            v_zip(a[i], a[i + n/2], b[i*2], b[i*2 + 1]);
+        for( int i = 0; i < n; i++ )
+            a[i] = b[i];
     }
 }
 
-typedef void (*TransposeFunc)( const uchar* src, size_t sstep, uchar* dst, size_t dstep, Size sz );
-typedef void (*TransposeInplaceFunc)( uchar* data, size_t step, int n );
+template<typename VT> static void
+transposeBlock_( const uchar* src, ptrdiff_t sstep, uchar* dst, ptrdiff_t dstep )
+{
+    typedef typename VT::lane_type T;
+    enum { n = VT::nlanes };
+    VT a[n];
+    for( int i = 0; i < n; i++ )
+        a[i] = v_load((const T*)(src + sstep*i));
+    transposeRegs_(a);
+    for( int i = 0; i < n; i++ )
+        v_store((T*)(dst + dstep*i), a[i]);
+}
+
+// 16x16 block of 3-channel pixels: the channels are separated on loading and transposed independently
+static void
+transposeBlock8uC3( const uchar* src, ptrdiff_t sstep, uchar* dst, ptrdiff_t dstep )
+{
+    enum { n = v_uint8x16::nlanes };
+    v_uint8x16 a[n], b[n], c[n];
+    for( int i = 0; i < n; i++ )
+        v_load_deinterleave(src + sstep*i, a[i], b[i], c[i]);
+    transposeRegs_(a);
+    transposeRegs_(b);
+    transposeRegs_(c);
+    for( int i = 0; i < n; i++ )
+        v_store_interleave(dst + dstep*i, a[i], b[i], c[i]);
+}
+
+typedef void (*TransposeBlockFunc)( const uchar* src, ptrdiff_t sstep, uchar* dst, ptrdiff_t dstep );
+
+// T is the element type, the square blocks of bs x bs elements are transposed by the block function
+template<typename T, int bs, TransposeBlockFunc transposeBlock> static void
+transposeSIMD_( const uchar* src, ptrdiff_t sstep, uchar* dst, ptrdiff_t dstep, Size sz )
+{
+    const int m = sz.width, n = sz.height;
+    int i = 0, j = 0;
+    for( ; i <= m - bs; i += bs )
+        for( j = 0; j <= n - bs; j += bs )
+            transposeBlock(src + sstep*j + i*sizeof(T), sstep, dst + dstep*i + j*sizeof(T), dstep);
+    // the right and the bottom margins
+    if( i < m )
+        transpose_<T>(src + i*sizeof(T), sstep, dst + dstep*i, dstep, Size(m - i, n));
+    if( i > 0 && j < n )
+        transpose_<T>(src + sstep*j, sstep, dst + j*sizeof(T), dstep, Size(i, n - j));
+}
+#endif
+
+typedef void (*TransposeFunc)( const uchar* src, ptrdiff_t sstep, uchar* dst, ptrdiff_t dstep, Size sz );
 
 #define DEF_TRANSPOSE_FUNC(suffix, type) \
-static void transpose_##suffix( const uchar* src, size_t sstep, uchar* dst, size_t dstep, Size sz ) \
-{ transpose_<type>(src, sstep, dst, dstep, sz); } \
-\
-static void transposeI_##suffix( uchar* data, size_t step, int n ) \
-{ transposeI_<type>(data, step, n); }
+static void transpose_##suffix( const uchar* src, ptrdiff_t sstep, uchar* dst, ptrdiff_t dstep, Size sz ) \
+{ transpose_<type>(src, sstep, dst, dstep, sz); }
 
+#if CV_SIMD128
+static void transpose_8u( const uchar* src, ptrdiff_t sstep, uchar* dst, ptrdiff_t dstep, Size sz )
+{ transposeSIMD_<uchar, v_uint8x16::nlanes, transposeBlock_<v_uint8x16> >(src, sstep, dst, dstep, sz); }
+static void transpose_16u( const uchar* src, ptrdiff_t sstep, uchar* dst, ptrdiff_t dstep, Size sz )
+{ transposeSIMD_<ushort, v_uint16x8::nlanes, transposeBlock_<v_uint16x8> >(src, sstep, dst, dstep, sz); }
+static void transpose_32s( const uchar* src, ptrdiff_t sstep, uchar* dst, ptrdiff_t dstep, Size sz )
+{ transposeSIMD_<unsigned, v_uint32x4::nlanes, transposeBlock_<v_uint32x4> >(src, sstep, dst, dstep, sz); }
+static void transpose_8uC3( const uchar* src, ptrdiff_t sstep, uchar* dst, ptrdiff_t dstep, Size sz )
+{ transposeSIMD_<Vec3b, v_uint8x16::nlanes, transposeBlock8uC3>(src, sstep, dst, dstep, sz); }
+#else
 DEF_TRANSPOSE_FUNC(8u, uchar)
 DEF_TRANSPOSE_FUNC(16u, ushort)
-DEF_TRANSPOSE_FUNC(8uC3, Vec3b)
 DEF_TRANSPOSE_FUNC(32s, int)
-DEF_TRANSPOSE_FUNC(16uC3, Vec3s)
+DEF_TRANSPOSE_FUNC(8uC3, Vec3b)
+#endif
+#if CV_SIMD128_64F
+// the lanes are only moved, so any 8-byte elements can be transposed as doubles
+static void transpose_32sC2( const uchar* src, ptrdiff_t sstep, uchar* dst, ptrdiff_t dstep, Size sz )
+{ transposeSIMD_<int64, v_float64x2::nlanes, transposeBlock_<v_float64x2> >(src, sstep, dst, dstep, sz); }
+#else
 DEF_TRANSPOSE_FUNC(32sC2, Vec2i)
+#endif
+DEF_TRANSPOSE_FUNC(16uC3, Vec3s)
 DEF_TRANSPOSE_FUNC(32sC3, Vec3i)
 DEF_TRANSPOSE_FUNC(32sC4, Vec4i)
 DEF_TRANSPOSE_FUNC(32sC6, Vec6i)
@@ -110,13 +175,118 @@ static TransposeFunc transposeTab[] =
     0, 0, 0, 0, 0, 0, 0, transpose_32sC6, 0, 0, 0, 0, 0, 0, 0, transpose_32sC8
 };
 
-static TransposeInplaceFunc transposeInplaceTab[] =
+// The matrices are processed by square tiles, so that the source and the destination tiles fit L1 cache
+static int getTransposeTileSize( size_t esz )
+{
+    int tile = 64;
+    while( tile > 16 && (size_t)tile*tile*esz > 8192 )
+        tile /= 2;
+    return tile;
+}
+
+class TransposeInvoker : public ParallelLoopBody
+{
+public:
+    TransposeInvoker( const uchar* _src, ptrdiff_t _sstep, uchar* _dst, ptrdiff_t _dstep,
+                      Size _sz, size_t _esz, TransposeFunc _func )
+        : src(_src), sstep(_sstep), dst(_dst), dstep(_dstep), sz(_sz), esz(_esz), func(_func),
+          tile(getTransposeTileSize(_esz))
+    {}
+
+    // the range is a range of the tile columns of the source matrix
+    void operator()( const Range& range ) const CV_OVERRIDE
+    {
+        for( int tx = range.start; tx < range.end; tx++ )
+        {
+            int x = tx*tile, width = std::min(tile, sz.width - x);
+            for( int y = 0; y < sz.height; y += tile )
+                func( src + sstep*y + x*esz, sstep, dst + dstep*x + y*esz, dstep,
+                      Size(width, std::min(tile, sz.height - y)) );
+        }
+    }
+
+    int tilesCount() const { return (sz.width + tile - 1)/tile; }
+
+protected:
+    const uchar* src;
+    ptrdiff_t sstep;
+    uchar* dst;
+    ptrdiff_t dstep;
+    Size sz;
+    size_t esz;
+    TransposeFunc func;
+    int tile;
+};
+
+// In-place transposition of the square matrix: the pairs of tiles, which are symmetrical
+// relatively to the main diagonal, are copied to the buffers and written back transposed
+class TransposeInplaceInvoker : public ParallelLoopBody
 {
-    0, transposeI_8u, transposeI_16u, transposeI_8uC3, transposeI_32s, 0, transposeI_16uC3, 0,
-    transposeI_32sC2, 0, 0, 0, transposeI_32sC3, 0, 0, 0, transposeI_32sC4,
-    0, 0, 0, 0, 0, 0, 0, transposeI_32sC6, 0, 0, 0, 0, 0, 0, 0, transposeI_32sC8
+public:
+    TransposeInplaceInvoker( uchar* _data, ptrdiff_t _step, int _n, size_t _esz, TransposeFunc _func )
+        : data(_data), step(_step), n(_n), esz(_esz), func(_func), tile(getTransposeTileSize(_esz))
+    {}
+
+    // the range is a range of the tile rows, every task processes the tiles right to the diagonal
+    void operator()( const Range& range ) const CV_OVERRIDE
+    {
+        const ptrdiff_t bstep = (ptrdiff_t)(tile*esz);
+        AutoBuffer<uchar> _buf(tile*bstep*2);
+        uchar* buf0 = _buf.data();
+        uchar* buf1 = buf0 + tile*bstep;
+        for( int ty = range.start; ty < range.end; ty++ )
+        {
+            int y = ty*tile, height = std::min(tile, n - y);
+            for( int x = y; x < n; x += tile )
+            {
+                int width = std::min(tile, n - x);
+                uchar* a = data + step*y + x*esz;
+                uchar* b = data + step*x + y*esz;
+                copyTile(a, buf0, bstep, Size(width, height));
+                if( x != y )
+                {
+                    copyTile(b, buf1, bstep, Size(height, width));
+                    func( buf1, bstep, a, step, Size(height, width) );
+                }
+                func( buf0, bstep, b, step, Size(width, height) );
+            }
+        }
+    }
+
+    int tilesCount() const { return (n + tile - 1)/tile; }
+
+protected:
+    void copyTile( const uchar* src, uchar* buf, ptrdiff_t bstep, Size sz ) const
+    {
+        for( int i = 0; i < sz.height; i++ )
+            memcpy(buf + bstep*i, src + step*i, sz.width*esz);
+    }
+
+    uchar* data;
+    ptrdiff_t step;
+    int n;
+    size_t esz;
+    TransposeFunc func;
+    int tile;
 };
 
+// transposes the matrix, the steps can be negative to flip the source or the destination
+static void transposeImpl( const uchar* src, ptrdiff_t sstep, uchar* dst, ptrdiff_t dstep, Size sz, int esz )
+{
+    TransposeFunc func = transposeTab[esz];
+    CV_Assert( func != 0 );
+    TransposeInvoker invoker(src, sstep, dst, dstep, sz, esz, func);
+    parallel_for_(Range(0, invoker.tilesCount()), invoker, (double)sz.area()*esz/(1 << 18));
+}
+
+static void transposeInplaceImpl( uchar* data, ptrdiff_t step, int n, int esz )
+{
+    TransposeFunc func = transposeTab[esz];
+    CV_Assert( func != 0 );
+    TransposeInplaceInvoker invoker(data, step, n, esz, func);
+    parallel_for_(Range(0, invoker.tilesCount()), invoker, (double)n*n*esz/(1 << 18));
+}
+
 #ifdef HAVE_OPENCL
 
 static bool ocl_transpose( InputArray _src, OutputArray _dst )
@@ -275,16 +445,12 @@ void transpose( InputArray _src, OutputArray _dst )
 
     if( dst.data == src.data )
     {
-        TransposeInplaceFunc func = transposeInplaceTab[esz];
-        CV_Assert( func != 0 );
         CV_Assert( dst.cols == dst.rows );
-        func( dst.ptr(), dst.step, dst.rows );
+        transposeInplaceImpl( dst.ptr(), dst.step, dst.rows, esz );
     }
     else
     {
-        TransposeFunc func = transposeTab[esz];
-        CV_Assert( func != 0 );
-        func( src.ptr(), src.step, dst.ptr(), dst.step, src.size() );
+        transposeImpl( src.ptr(), src.step, dst.ptr(), dst.step, src.size(), esz );
     }
 }
 
@@ -1144,7 +1310,19 @@ void rotate(InputArray _src, OutputArray _dst, int rotateMode)
     CALL_HAL(rotate90, cv_hal_rotate90, type, src.ptr(), src.step, src.cols, src.rows,
              dst.ptr(), dst.step, angle);
 
+    int esz = (int)src.elemSize();
+    if( (angle == 90 || angle == 270) && dst.data != src.data && esz <= 32 && transposeTab[esz] )
+    {
+        // single pass: rotation by 90 degrees is transposition of the matrix with the reversed order of rows
+        if( angle == 90 )
+            transposeImpl( src.ptr(src.rows - 1), -(ptrdiff_t)src.step, dst.ptr(), dst.step, src.size(), esz );
+        else
+            transposeImpl( src.ptr(), src.step, dst.ptr(dst.rows - 1), -(ptrdiff_t)dst.step, src.size(), esz );
+        return;
+    }
+
     // use src (Mat) since _src (InputArray) is updated by _dst.create() when in-place
+    // (square matrices are transposed and flipped in-place)
     rotateImpl(src, _dst, rotateMode);
 }
 
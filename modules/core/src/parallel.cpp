@@ -351,6 +351,9 @@ namespace {
             CV_TRACE_ARG_VALUE(range_end, "range.end", (int64)r.end);
 #endif
 
+            // parallel_for_() calls from the body are nested ones
+            int& depth = getCoreTlsData().parallelForDepth;
+            depth++;
             try
             {
                 (*ctx.body)(r);
@@ -375,6 +378,8 @@ namespace {
             }
 #endif
 
+            depth--;
+
             if (!ctx.is_rng_used && !(cv::theRNG() == ctx.rng))
                 ctx.is_rng_used = true;
         }
@@ -500,6 +505,11 @@ static SchedPtr pplScheduler;
 
 static void parallel_for_impl(const cv::Range& range, const cv::ParallelLoopBody& body, double nstripes); // forward declaration
 
+static std::atomic<int64> g_parallelForCalls(0);
+static std::atomic<int64> g_parallelForParallel(0);
+static std::atomic<int64> g_parallelForNested(0);
+static std::atomic<int64> g_parallelForSerial(0);
+
 void parallel_for_(const cv::Range& range, const cv::ParallelLoopBody& body, double nstripes)
 {
 #ifdef OPENCV_TRACE
@@ -512,31 +522,62 @@ void parallel_for_(const cv::Range& range, const cv::ParallelLoopBody& body, dou
     CV_INSTRUMENT_REGION_MT_FORK();
     if (range.empty())
         return;
+    g_parallelForCalls++;
+
+#ifndef OPENCV_DISABLE_THREAD_SUPPORT
+    {
+        const std::shared_ptr<ParallelForAPI>& api = getCurrentParallelForAPI();
+        if (api && isNestedParallelForSupported(*api))
+        {
+            parallel_for_impl(range, body, nstripes);
+            return;
+        }
+    }
+#endif
 
-    static std::atomic<bool> flagNestedParallelFor(false);
-    bool isNotNestedRegion = !flagNestedParallelFor.load();
-    if (isNotNestedRegion)
-      isNotNestedRegion = !flagNestedParallelFor.exchange(true);
-    if (isNotNestedRegion)
+    // The nesting depth is tracked per thread: calls from a parallel_for_() body are executed serially,
+    // while calls from different application threads are passed to the threading framework concurrently.
+    int& depth = getCoreTlsData().parallelForDepth;
+    if (depth == 0)
     {
+        depth++;
         try
         {
             parallel_for_impl(range, body, nstripes);
-            flagNestedParallelFor = false;
+            depth--;
         }
         catch (...)
         {
-            flagNestedParallelFor = false;
+            depth--;
             throw;
         }
     }
     else // nested parallel_for_() calls are not parallelized
     {
         CV_UNUSED(nstripes);
+        g_parallelForNested++;
         body(range);
     }
 }
 
+ParallelForCounters getParallelForCounters()
+{
+    ParallelForCounters counters;
+    counters.calls = g_parallelForCalls.load();
+    counters.parallel = g_parallelForParallel.load();
+    counters.nested = g_parallelForNested.load();
+    counters.serial = g_parallelForSerial.load();
+    return counters;
+}
+
+void resetParallelForCounters()
+{
+    g_parallelForCalls = 0;
+    g_parallelForParallel = 0;
+    g_parallelForNested = 0;
+    g_parallelForSerial = 0;
+}
+
 static
 void parallel_for_cb(int start, int end, void* data)
 {
@@ -555,6 +596,7 @@ static void parallel_for_impl(const cv::Range& range, const cv::ParallelLoopBody
         cv::Range stripeRange = pbody.stripeRange();
         if( stripeRange.end - stripeRange.start == 1 )
         {
+            g_parallelForSerial++;
             body(range);
             return;
         }
@@ -562,6 +604,7 @@ static void parallel_for_impl(const cv::Range& range, const cv::ParallelLoopBody
         std::shared_ptr<ParallelForAPI>& api = getCurrentParallelForAPI();
         if (api)
         {
+            g_parallelForParallel++;
             CV_CheckEQ(stripeRange.start, 0, "");
             api->parallel_for(stripeRange.end, parallel_for_cb, (void*)&pbody);
             ctx.finalize();  // propagate exceptions if exists
@@ -569,6 +612,7 @@ static void parallel_for_impl(const cv::Range& range, const cv::ParallelLoopBody
         }
 
 #ifdef CV_PARALLEL_FRAMEWORK
+        bool isParallel = true;
 #if defined HAVE_TBB
 
 #if TBB_INTERFACE_VERSION >= 8000
@@ -610,7 +654,8 @@ static void parallel_for_impl(const cv::Range& range, const cv::ParallelLoopBody
 
 #elif defined HAVE_PTHREADS_PF
 
-        parallel_for_pthreads(pbody.stripeRange(), pbody, pbody.stripeRange().size());
+        // the pool executes the range in the calling thread if it has no workers
+        isParallel = parallel_for_pthreads(pbody.stripeRange(), pbody, pbody.stripeRange().size());
 
 #else
 
@@ -618,11 +663,16 @@ static void parallel_for_impl(const cv::Range& range, const cv::ParallelLoopBody
 
 #endif
 
+        if (isParallel)
+            g_parallelForParallel++;
+        else
+            g_parallelForSerial++;
         ctx.finalize();  // propagate exceptions if exists
         return;
 #endif // CV_PARALLEL_FRAMEWORK
     }
 
+    g_parallelForSerial++;
     body(range);
 }
 
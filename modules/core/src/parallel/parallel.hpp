@@ -22,6 +22,13 @@ std::shared_ptr<cv::parallel::ParallelForAPI> createParallelBackendTBB();
 std::shared_ptr<cv::parallel::ParallelForAPI> createParallelBackendOpenMP();
 #endif
 
+#ifndef OPENCV_DISABLE_THREAD_SUPPORT
+std::shared_ptr<cv::parallel::ParallelForAPI> createParallelBackendWorkStealing();
+
+/// true for backends which run nested and concurrent parallel_for() calls in parallel themselves
+bool isNestedParallelForSupported(const ParallelForAPI& api);
+#endif
+
 #endif  // BUILD_PLUGIN
 
 }}  // namespace
@@ -0,0 +1,388 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+#include "../precomp.hpp"
+
+#ifndef OPENCV_DISABLE_THREAD_SUPPORT
+
+#include "parallel.hpp"
+#include "../parallel_impl.hpp"
+
+#include <opencv2/core/utils/configuration.private.hpp>
+#include <opencv2/core/utils/logger.hpp>
+#include <opencv2/core/utils/tls.hpp>
+
+#include <atomic>
+#include <deque>
+#include <exception>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace cv { namespace parallel {
+
+namespace {
+
+static int CV_WORKSTEALING_ACTIVE_WAIT = (int)utils::getConfigurationParameterSizeT("OPENCV_PARALLEL_WORKSTEALING_ACTIVE_WAIT", 256);  // iterations
+
+/** Work-stealing parallel_for() backend
+
+Every worker thread owns a deque of tasks. A task is a range of stripes of one parallel_for() call (job).
+The thread which executes a task splits it in halves, pushes the right half to the back of its deque and continues
+with the left one down to a single stripe. So the owner pops small ranges from the back of its deque, while idle
+workers steal the big ones from the front.
+
+Nested parallel_for() calls made by a worker push their tasks into the worker's own deque, calls from other threads
+use a shared queue. The calling thread doesn't sleep while its job has queued tasks, it executes them itself, so nested
+and concurrent parallel_for() calls share one set of threads without oversubscription and without deadlocks.
+
+While waiting, a thread executes tasks of its own job or of jobs nested into it only. A task of an unrelated job may
+need a lock which the waiting thread holds across its nested parallel_for() call.
+*/
+class WorkStealingParallelForBackend CV_FINAL : public ParallelForAPI
+{
+public:
+    WorkStealingParallelForBackend()
+        : m_queued(0), m_pushed(0), m_sleeping(0), m_stop(false), m_numThreads(0)
+    {
+        CV_LOG_INFO(NULL, "Initializing work-stealing parallel backend");
+        setNumThreads((int)defaultNumberOfThreads());
+    }
+
+    ~WorkStealingParallelForBackend() CV_OVERRIDE
+    {
+        stopWorkers();
+    }
+
+    void parallel_for(int tasks, FN_parallel_for_body_cb_t body_callback, void* callback_data) CV_OVERRIDE
+    {
+        if (tasks <= 0)
+            return;
+        ThreadState& ts = getThreadState();
+        // workers keep the list they belong to, other threads hold it while they may steal from it
+        std::shared_ptr<WorkerList> prevWorkers = ts.workers;
+        if (!ts.worker && tasks > 1)
+            ts.workers = getWorkers();
+        if (tasks == 1 || !ts.workers || ts.workers->empty())
+        {
+            ts.workers = prevWorkers;
+            body_callback(0, tasks, callback_data);
+            return;
+        }
+
+        Job job(body_callback, callback_data, tasks, ts.current);
+        execute(ts, Task(&job, 0, tasks));
+
+        while (job.remaining.load() > 0)
+        {
+            const unsigned pushed = m_pushed.load();
+            if (runTask(ts, &job))
+                continue;
+            // the remaining stripes are running in other threads
+            std::unique_lock<std::mutex> lock(m_sleepMutex);
+            m_sleeping++;
+            m_wake.wait(lock, [&] { return m_pushed.load() != pushed || job.remaining.load() == 0; });
+            m_sleeping--;
+        }
+        ts.workers = prevWorkers;
+
+        if (job.hasException.load())
+            std::rethrow_exception(job.exception);
+    }
+
+    int getThreadNum() const CV_OVERRIDE
+    {
+        return getThreadState().index;
+    }
+
+    int getNumThreads() const CV_OVERRIDE
+    {
+        return m_numThreads;
+    }
+
+    int setNumThreads(int nThreads) CV_OVERRIDE
+    {
+        int oldNumThreads = m_numThreads;
+        if (nThreads < 0)
+            nThreads = (int)defaultNumberOfThreads();
+        if (nThreads == m_numThreads)
+            return oldNumThreads;
+
+        stopWorkers();
+        m_numThreads = nThreads;
+        // the thread which calls parallel_for() takes part in the work
+        std::shared_ptr<WorkerList> workers = std::make_shared<WorkerList>();
+        for (int i = 1; i < nThreads; i++)
+            workers->push_back(std::unique_ptr<Worker>(new Worker()));
+        for (size_t i = 0; i < workers->size(); i++)
+            (*workers)[i]->thread = std::thread(&WorkStealingParallelForBackend::run, this, workers, (int)i + 1);
+        {
+            std::lock_guard<std::mutex> lock(m_workersMutex);
+            m_workers = workers;
+        }
+        return oldNumThreads;
+    }
+
+    const char* getName() const CV_OVERRIDE
+    {
+        return "workstealing";
+    }
+
+protected:
+    struct Job
+    {
+        Job(FN_parallel_for_body_cb_t body_, void* data_, int tasks, const Job* parent_)
+            : body(body_), data(data_), parent(parent_), remaining(tasks), hasException(false)
+        {}
+
+        /// true for this job and the jobs nested into it
+        bool isPartOf(const Job* root) const
+        {
+            for (const Job* job = this; job; job = job->parent)
+                if (job == root)
+                    return true;
+            return false;
+        }
+
+        FN_parallel_for_body_cb_t body;
+        void* data;
+        const Job* parent;  // job of the task which made this parallel_for() call, it outlives this one
+        std::atomic<int> remaining;  // stripes which are not finished yet
+        std::atomic<bool> hasException;
+        std::exception_ptr exception;  // the first one, written by the thread which sets hasException
+    };
+
+    struct Task
+    {
+        Task() : job(NULL), begin(0), end(0) {}
+        Task(Job* job_, int begin_, int end_) : job(job_), begin(begin_), end(end_) {}
+
+        Job* job;
+        int begin, end;
+    };
+
+    struct TaskQueue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    struct Worker : public TaskQueue
+    {
+        std::thread thread;
+    };
+
+    typedef std::vector<std::unique_ptr<Worker> > WorkerList;
+
+    struct ThreadState
+    {
+        ThreadState() : worker(NULL), index(0), current(NULL) {}
+
+        Worker* worker;  // NULL for threads which are not owned by the backend
+        int index;
+        const Job* current;  // job of the task being executed
+        std::shared_ptr<WorkerList> workers;  // victims for stealing
+    };
+
+    std::shared_ptr<WorkerList> getWorkers()
+    {
+        std::lock_guard<std::mutex> lock(m_workersMutex);
+        return m_workers;
+    }
+
+    ThreadState& getThreadState() const
+    {
+        return *m_tls.get();
+    }
+
+    void push(ThreadState& ts, const Task& task)
+    {
+        TaskQueue& queue = ts.worker ? *ts.worker : m_shared;
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tasks.push_back(task);
+        }
+        m_queued++;
+        m_pushed++;
+        if (m_sleeping.load() > 0)
+        {
+            // the sleeping thread either waits already or checks m_pushed under the lock.
+            // Waiting callers accept tasks of their own job only, so wake everybody
+            { std::lock_guard<std::mutex> lock(m_sleepMutex); }
+            m_wake.notify_all();
+        }
+    }
+
+    /// takes a task of the 'root' job or of the jobs nested into it, any task if 'root' is NULL
+    bool pop(ThreadState& ts, Task& task, const Job* root)
+    {
+        // own tasks first, in LIFO order while they are hot in the cache
+        if (ts.worker && popBack(*ts.worker, task, root))
+            return true;
+        if (popFront(m_shared, task, root))
+            return true;
+        if (!ts.workers)
+            return false;
+        // steal the biggest ranges, starting from the next worker to spread the victims
+        const WorkerList& workers = *ts.workers;
+        const size_t n = workers.size();
+        for (size_t i = 0; i < n; i++)
+        {
+            Worker* victim = workers[(ts.index + i) % n].get();
+            if (victim != ts.worker && popFront(*victim, task, root))
+                return true;
+        }
+        return false;
+    }
+
+    bool popBack(TaskQueue& queue, Task& task, const Job* root)
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        for (size_t i = queue.tasks.size(); i > 0; i--)
+        {
+            if (root && !queue.tasks[i - 1].job->isPartOf(root))
+                continue;
+            task = queue.tasks[i - 1];
+            queue.tasks.erase(queue.tasks.begin() + (i - 1));
+            m_queued--;
+            return true;
+        }
+        return false;
+    }
+
+    bool popFront(TaskQueue& queue, Task& task, const Job* root)
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        for (size_t i = 0; i < queue.tasks.size(); i++)
+        {
+            if (root && !queue.tasks[i].job->isPartOf(root))
+                continue;
+            task = queue.tasks[i];
+            queue.tasks.erase(queue.tasks.begin() + i);
+            m_queued--;
+            return true;
+        }
+        return false;
+    }
+
+    bool runTask(ThreadState& ts, const Job* root)
+    {
+        Task task;
+        if (!pop(ts, task, root))
+            return false;
+        execute(ts, task);
+        return true;
+    }
+
+    void execute(ThreadState& ts, Task task)
+    {
+        Job& job = *task.job;
+        while (task.end - task.begin > 1)
+        {
+            int middle = task.begin + (task.end - task.begin) / 2;
+            push(ts, Task(&job, middle, task.end));
+            task.end = middle;
+        }
+
+        const Job* prevJob = ts.current;
+        ts.current = &job;
+        try
+        {
+            job.body(task.begin, task.end, job.data);
+        }
+        catch (...)
+        {
+            if (!job.hasException.exchange(true))
+                job.exception = std::current_exception();
+        }
+        ts.current = prevJob;
+
+        // the job may be destroyed by its owner right after the last stripe is counted
+        const int done = task.end - task.begin;
+        if (job.remaining.fetch_sub(done) == done && m_sleeping.load() > 0)
+        {
+            { std::lock_guard<std::mutex> lock(m_sleepMutex); }
+            m_wake.notify_all();
+        }
+    }
+
+    void run(std::shared_ptr<WorkerList> workers, int index)
+    {
+        ThreadState& ts = getThreadState();
+        ts.worker = (*workers)[index - 1].get();
+        ts.index = index;
+        ts.workers = workers;
+        for (;;)
+        {
+            if (runTask(ts, NULL))
+                continue;
+
+            for (int i = 0; i < CV_WORKSTEALING_ACTIVE_WAIT && m_queued.load() == 0; i++)
+                std::this_thread::yield();
+            if (m_queued.load() > 0)
+                continue;
+
+            std::unique_lock<std::mutex> lock(m_sleepMutex);
+            if (m_stop)
+                break;
+            m_sleeping++;
+            m_wake.wait(lock, [this] { return m_stop || m_queued.load() > 0; });
+            m_sleeping--;
+        }
+        ts.worker = NULL;
+        ts.index = 0;
+        ts.workers.reset();
+    }
+
+    void stopWorkers()
+    {
+        // new parallel_for() calls don't see the list anymore, running ones hold it until they return
+        std::shared_ptr<WorkerList> workers;
+        {
+            std::lock_guard<std::mutex> lock(m_workersMutex);
+            workers.swap(m_workers);
+        }
+        if (!workers)
+            return;
+        {
+            std::lock_guard<std::mutex> lock(m_sleepMutex);
+            m_stop = true;
+        }
+        m_wake.notify_all();
+        // a worker exits with the empty own deque, nobody pushes into it after that
+        for (size_t i = 0; i < workers->size(); i++)
+            (*workers)[i]->thread.join();
+        {
+            std::lock_guard<std::mutex> lock(m_sleepMutex);
+            m_stop = false;
+        }
+    }
+
+    std::shared_ptr<WorkerList> m_workers;  // guarded by m_workersMutex
+    std::mutex m_workersMutex;
+    TaskQueue m_shared;  // tasks of parallel_for() calls from threads which are not workers
+    std::atomic<int> m_queued;  // tasks in all queues
+    std::atomic<unsigned> m_pushed;  // tasks pushed so far, wakes the waiting callers
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wake;
+    std::atomic<int> m_sleeping;
+    bool m_stop;  // guarded by m_sleepMutex
+    int m_numThreads;
+    mutable TLSData<ThreadState> m_tls;
+};
+
+}  // namespace
+
+std::shared_ptr<cv::parallel::ParallelForAPI> createParallelBackendWorkStealing()
+{
+    return std::make_shared<WorkStealingParallelForBackend>();
+}
+
+bool isNestedParallelForSupported(const ParallelForAPI& api)
+{
+    return dynamic_cast<const WorkStealingParallelForBackend*>(&api) != NULL;
+}
+
+}}  // namespace
+
+#endif  // OPENCV_DISABLE_THREAD_SUPPORT
@@ -5,6 +5,7 @@
 #include "precomp.hpp"
 
 #include "parallel_impl.hpp"
+#include "thread_placement.hpp"
 
 #ifdef HAVE_PTHREADS_PF
 #include <pthread.h>
@@ -25,6 +26,12 @@
 
 #include <atomic>
 
+#if defined(__linux__) && defined(_GNU_SOURCE) && !defined(__ANDROID__) && !defined(__EMSCRIPTEN__)
+#define CV_THREAD_POOL_HAVE_AFFINITY 1
+#include <sched.h>
+#include <fstream>
+#endif
+
 // Spin lock's OS-level yield
 #ifdef DECLARE_CV_YIELD
 DECLARE_CV_YIELD
@@ -79,6 +86,118 @@ static int CV_MAIN_THREAD_ACTIVE_WAIT = (int)utils::getConfigurationParameterSiz
 
 static int CV_WORKER_ACTIVE_WAIT_THREADS_LIMIT = (int)utils::getConfigurationParameterSizeT("OPENCV_THREAD_POOL_ACTIVE_WAIT_THREADS_LIMIT", 0); // number of real cores
 
+// pin every worker thread to a single CPU
+static bool CV_THREAD_POOL_BIND_THREADS = utils::getConfigurationParameterBool("OPENCV_THREAD_POOL_BIND_THREADS", false);
+// pin worker threads to CPUs of NUMA nodes and split range of every job between nodes
+static bool CV_THREAD_POOL_NUMA = utils::getConfigurationParameterBool("OPENCV_THREAD_POOL_NUMA", false);
+
+#ifdef CV_THREAD_POOL_HAVE_AFFINITY
+static std::string readSysfsLine(const std::string& filename)
+{
+    std::ifstream f(filename.c_str());
+    std::string content;
+    std::getline(f, content);
+    return content;
+}
+#endif
+
+// NUMA nodes and their CPUs allowed for the process, from sysfs
+static ThreadPlacement* detectThreadPlacement()
+{
+    std::vector< std::vector<int> > node_cpus;
+#ifdef CV_THREAD_POOL_HAVE_AFFINITY
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (0 != sched_getaffinity(0, sizeof(allowed), &allowed))
+        return new ThreadPlacement();
+
+    std::vector<int> node_ids = ThreadPlacement::parseList(readSysfsLine("/sys/devices/system/node/online"));
+    for (size_t n = 0; n < node_ids.size(); n++)
+    {
+        std::vector<int> node = ThreadPlacement::parseList(readSysfsLine(cv::format("/sys/devices/system/node/node%d/cpulist", node_ids[n])));
+        std::vector<int> node_allowed;
+        for (size_t i = 0; i < node.size(); i++)
+        {
+            if (node[i] < CPU_SETSIZE && CPU_ISSET(node[i], &allowed))
+                node_allowed.push_back(node[i]);
+        }
+        if (!node_allowed.empty())
+            node_cpus.push_back(node_allowed);
+    }
+    if (node_cpus.empty())  // no NUMA information
+    {
+        std::vector<int> all;
+        for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+        {
+            if (CPU_ISSET(cpu, &allowed))
+                all.push_back(cpu);
+        }
+        if (!all.empty())
+            node_cpus.push_back(all);
+    }
+    CV_LOG_INFO(NULL, "Thread pool: " << CPU_COUNT(&allowed) << " CPUs on " << node_cpus.size() << " NUMA node(s)");
+#endif
+    return new ThreadPlacement(node_cpus);
+}
+
+static ThreadPlacement* g_forcedThreadPlacement = NULL;  // details::setThreadPoolNumaNodes()
+
+static const ThreadPlacement& getThreadPlacement()
+{
+    if (g_forcedThreadPlacement)
+        return *g_forcedThreadPlacement;
+    CV_SINGLETON_LAZY_INIT_REF(ThreadPlacement, detectThreadPlacement())
+}
+
+static inline bool isThreadPoolNuma()
+{
+    return CV_THREAD_POOL_NUMA || g_forcedThreadPlacement != NULL;
+}
+
+static inline int getThreadNumaNode(unsigned thread_idx)
+{
+    return isThreadPoolNuma() ? getThreadPlacement().getNode(thread_idx) : 0;
+}
+
+// node of the CPU which executes the calling thread, it is not pinned unlike workers
+static int getCurrentNumaNode()
+{
+    if (!isThreadPoolNuma())
+        return 0;
+#ifdef CV_THREAD_POOL_HAVE_AFFINITY
+    int cpu = sched_getcpu();
+    if (cpu >= 0)
+        return getThreadPlacement().getCpuNode(cpu);
+#endif
+    return 0;
+}
+
+/// pins the calling thread to its CPU (bind_to_cpu) or to CPUs of its NUMA node
+static bool bindCurrentThread(unsigned thread_idx, bool bind_to_cpu)
+{
+#ifdef CV_THREAD_POOL_HAVE_AFFINITY
+    const ThreadPlacement& placement = getThreadPlacement();
+    if (placement.empty())
+        return false;
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    if (bind_to_cpu)
+    {
+        CPU_SET(placement.getCpu(thread_idx), &cpu_set);
+    }
+    else
+    {
+        const std::vector<int>& node = placement.getNodeCpus(placement.getNode(thread_idx));
+        for (size_t i = 0; i < node.size(); i++)
+            CPU_SET(node[i], &cpu_set);
+    }
+    return 0 == pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+#else
+    CV_UNUSED(thread_idx); CV_UNUSED(bind_to_cpu);
+    return false;
+#endif
+}
+
 class WorkerThread;
 class ParallelJob;
 
@@ -106,7 +225,7 @@ public:
     }
     bool reconfigure_(unsigned new_threads_count); // internal implementation
 
-    void run(const Range& range, const ParallelLoopBody& body, double nstripes);
+    bool run(const Range& range, const ParallelLoopBody& body, double nstripes);
 
     size_t getNumOfThreads();
 
@@ -118,7 +237,7 @@ public:
 
     unsigned num_threads;
 
-    pthread_mutex_t mutex;  // guards fields (job/threads) from non-worker threads (concurrent parallel_for calls)
+    pthread_mutex_t mutex;  // guards threads from non-worker threads (concurrent parallel_for calls)
 #if defined(CV_USE_GLOBAL_WORKERS_COND_VAR)
     pthread_cond_t cond_thread_wake;
 #endif
@@ -128,7 +247,11 @@ public:
 
     std::vector< Ptr<WorkerThread> > threads;
 
-    Ptr<ParallelJob> job;
+    pthread_mutex_t mutex_jobs;  // guards jobs, taken by workers to pick up the next job
+    std::vector< Ptr<ParallelJob> > jobs;  // jobs of concurrent parallel_for calls
+    size_t next_job;  // round robin position in jobs, so workers are shared fairly between callers
+
+    Ptr<ParallelJob> findPendingJob();
 
 #ifdef CV_PROFILE_THREADS
     double tickFreq;
@@ -274,6 +397,7 @@ public:
     }
 
     void thread_body();
+    void process_job(Ptr<ParallelJob>& j_ptr, bool& allow_active_wait);
     static void* thread_loop_wrapper(void* thread_object)
     {
 #ifdef OPENCV_WITH_ITT
@@ -292,13 +416,34 @@ public:
         body(body_),
         range(range_),
         nstripes((unsigned)nstripes_),
-        is_completed(false)
+        is_completed(false),
+        caller_node(getCurrentNumaNode())
     {
         CV_LOG_VERBOSE(NULL, 5, "ParallelJob::ParallelJob(" << (void*)this << ")");
         current_task.store(0, std::memory_order_relaxed);
         active_thread_count.store(0, std::memory_order_relaxed);
         completed_thread_count.store(0, std::memory_order_relaxed);
         dummy0_[0] = 0, dummy1_[0] = 0, dummy2_[0] = 0; // compiler warning
+
+        const int num_nodes = isThreadPoolNuma() ? getThreadPlacement().getNumNodes() : 1;
+        if (num_nodes > 1 && range.size() >= num_nodes && thread_pool.num_threads > 0)
+        {
+            const ThreadPlacement& placement = getThreadPlacement();
+            // the same part of the range is processed by the same node in every call, so memory is accessed
+            // by the node which touched it first. Parts are proportional to the number of threads on nodes.
+            std::vector<int> node_threads(num_nodes, 0);
+            node_threads[caller_node]++;
+            for (unsigned i = 1; i < thread_pool.num_threads; i++)
+                node_threads[placement.getNode(i)]++;
+            std::vector<int> bounds = ThreadPlacement::splitRange(range.size(), node_threads);
+            std::vector< std::atomic<int> >(num_nodes).swap(node_task);
+            node_task_end.resize(num_nodes);
+            for (int n = 0; n < num_nodes; n++)
+            {
+                node_task[n].store(bounds[n], std::memory_order_relaxed);
+                node_task_end[n] = bounds[n + 1];
+            }
+        }
     }
 
     ~ParallelJob()
@@ -306,10 +451,35 @@ public:
         CV_LOG_VERBOSE(NULL, 5, "ParallelJob::~ParallelJob(" << (void*)this << ")");
     }
 
-    unsigned execute(bool is_worker_thread)
+    bool hasPendingTasks() const
+    {
+        if (node_task.empty())
+            return current_task < range.size();
+        for (size_t n = 0; n < node_task.size(); n++)
+        {
+            if (node_task[n] < node_task_end[n])
+                return true;
+        }
+        return false;
+    }
+
+    unsigned execute(bool is_worker_thread, int node = 0)
+    {
+        if (node_task.empty())
+            return execute(is_worker_thread, current_task, range.size());
+        // own part of the range first, then help other nodes
+        unsigned executed_tasks = 0;
+        for (size_t i = 0; i < node_task.size(); i++)
+        {
+            size_t n = (node + i) % node_task.size();
+            executed_tasks += execute(is_worker_thread, node_task[n], node_task_end[n]);
+        }
+        return executed_tasks;
+    }
+
+    unsigned execute(bool is_worker_thread, std::atomic<int>& current, const int task_count)
     {
         unsigned executed_tasks = 0;
-        const int task_count = range.size();
         const int remaining_multiplier = std::min(nstripes,
                 std::max(
                         std::min(100u, thread_pool.num_threads * 4),
@@ -317,8 +487,8 @@ public:
                 ));  // experimental value
         for (;;)
         {
-            int chunk_size = std::max(1, (task_count - current_task) / remaining_multiplier);
-            int id = current_task.fetch_add(chunk_size, std::memory_order_seq_cst);
+            int chunk_size = std::max(1, (task_count - current) / remaining_multiplier);
+            int id = current.fetch_add(chunk_size, std::memory_order_seq_cst);
             if (id >= task_count)
                 break; // no more free tasks
 
@@ -356,6 +526,10 @@ public:
 
     std::atomic<bool> is_completed;
 
+    const int caller_node;  // NUMA node of the thread which calls parallel_for_()
+    std::vector< std::atomic<int> > node_task;  // next free task in part of every NUMA node (OPENCV_THREAD_POOL_NUMA)
+    std::vector<int> node_task_end;
+
     // TODO exception handling
 };
 
@@ -375,6 +549,12 @@ void WorkerThread::thread_body()
     (void)cv::utils::getThreadID(); // notify OpenCV about new thread
     CV_LOG_VERBOSE(NULL, 5, "Thread: new thread: " << id);
 
+    if (CV_THREAD_POOL_BIND_THREADS || CV_THREAD_POOL_NUMA)
+    {
+        if (!bindCurrentThread(id + 1, CV_THREAD_POOL_BIND_THREADS))
+            CV_LOG_WARNING(NULL, "Thread pool: can't set affinity of worker thread " << id);
+    }
+
     bool allow_active_wait = true;
 
 #ifdef CV_PROFILE_THREADS
@@ -426,55 +606,71 @@ void WorkerThread::thread_body()
 
         if (!stop_thread)
         {
-            ParallelJob* j = j_ptr;
-            if (j)
+            process_job(j_ptr, allow_active_wait);
+            // help with jobs of other callers before going to sleep
+            while (!stop_thread && !has_wake_signal)
             {
-                CV_LOG_VERBOSE(NULL, 5, "Thread: job size=" << j->range.size() << " done=" << j->current_task);
-                if (j->current_task < j->range.size())
-                {
-                    int other = j->active_thread_count.fetch_add(1, std::memory_order_seq_cst);
-                    CV_LOG_VERBOSE(NULL, 5, "Thread: processing new job (with " << other << " other threads)"); CV_UNUSED(other);
+                j_ptr = thread_pool.findPendingJob();
+                if (!j_ptr)
+                    break;
+                process_job(j_ptr, allow_active_wait);
+            }
+        }
+#ifdef CV_PROFILE_THREADS
+        stat.threadFree = getTickCount();
+        stat.keepActive = allow_active_wait;
+#endif
+    }
+}
+
+void WorkerThread::process_job(Ptr<ParallelJob>& j_ptr, bool& allow_active_wait)
+{
+#ifdef CV_PROFILE_THREADS
+    ThreadPool::ThreadStatistics& stat = thread_pool.threads_stat[id + 1];
+#endif
+    ParallelJob* j = j_ptr;
+    if (j)
+    {
+        CV_LOG_VERBOSE(NULL, 5, "Thread: job size=" << j->range.size() << " done=" << j->current_task);
+        if (j->hasPendingTasks())
+        {
+            int other = j->active_thread_count.fetch_add(1, std::memory_order_seq_cst);
+            CV_LOG_VERBOSE(NULL, 5, "Thread: processing new job (with " << other << " other threads)"); CV_UNUSED(other);
 #ifdef CV_PROFILE_THREADS
-                    stat.threadExecuteStart = getTickCount();
-                    stat.executedTasks = j->execute(true);
-                    stat.threadExecuteStop = getTickCount();
+            stat.threadExecuteStart = getTickCount();
+            stat.executedTasks = j->execute(true, getThreadNumaNode(id + 1));
+            stat.threadExecuteStop = getTickCount();
 #else
-                    j->execute(true);
+            j->execute(true, getThreadNumaNode(id + 1));
 #endif
-                    int completed = j->completed_thread_count.fetch_add(1, std::memory_order_seq_cst) + 1;
-                    int active = j->active_thread_count.load(std::memory_order_acquire);
-                    if (CV_WORKER_ACTIVE_WAIT_THREADS_LIMIT > 0)
-                    {
-                        allow_active_wait = true;
-                        if (active >= CV_WORKER_ACTIVE_WAIT_THREADS_LIMIT && (id & 1) == 0) // turn off a half of threads
-                            allow_active_wait = false;
-                    }
-                    CV_LOG_VERBOSE(NULL, 5, "Thread: completed job processing: " << active << " " << completed);
-                    if (active == completed)
-                    {
-                        bool need_signal = !j->is_completed;
-                        j->is_completed = true;
-                        j = NULL; j_ptr.release();
-                        if (need_signal)
-                        {
-                            CV_LOG_VERBOSE(NULL, 5, "Thread: job finished => notifying the main thread");
-                            pthread_mutex_lock(&thread_pool.mutex_notify);  // to avoid signal miss due pre-check condition
-                            // empty
-                            pthread_mutex_unlock(&thread_pool.mutex_notify);
-                            pthread_cond_broadcast/*pthread_cond_signal*/(&thread_pool.cond_thread_task_complete);
-                        }
-                    }
-                }
-                else
+            int completed = j->completed_thread_count.fetch_add(1, std::memory_order_seq_cst) + 1;
+            int active = j->active_thread_count.load(std::memory_order_acquire);
+            if (CV_WORKER_ACTIVE_WAIT_THREADS_LIMIT > 0)
+            {
+                allow_active_wait = true;
+                if (active >= CV_WORKER_ACTIVE_WAIT_THREADS_LIMIT && (id & 1) == 0) // turn off a half of threads
+                    allow_active_wait = false;
+            }
+            CV_LOG_VERBOSE(NULL, 5, "Thread: completed job processing: " << active << " " << completed);
+            if (active == completed)
+            {
+                bool need_signal = !j->is_completed;
+                j->is_completed = true;
+                j = NULL; j_ptr.release();
+                if (need_signal)
                 {
-                    CV_LOG_VERBOSE(NULL, 5, "Thread: no free job tasks");
+                    CV_LOG_VERBOSE(NULL, 5, "Thread: job finished => notifying the main thread");
+                    pthread_mutex_lock(&thread_pool.mutex_notify);  // to avoid signal miss due pre-check condition
+                    // empty
+                    pthread_mutex_unlock(&thread_pool.mutex_notify);
+                    pthread_cond_broadcast/*pthread_cond_signal*/(&thread_pool.cond_thread_task_complete);
                 }
             }
         }
-#ifdef CV_PROFILE_THREADS
-        stat.threadFree = getTickCount();
-        stat.keepActive = allow_active_wait;
-#endif
+        else
+        {
+            CV_LOG_VERBOSE(NULL, 5, "Thread: no free job tasks");
+        }
     }
 }
 
@@ -487,6 +683,7 @@ ThreadPool::ThreadPool()
     int res = 0;
     res |= pthread_mutex_init(&mutex, NULL);
     res |= pthread_mutex_init(&mutex_notify, NULL);
+    res |= pthread_mutex_init(&mutex_jobs, NULL);
 #if defined(CV_USE_GLOBAL_WORKERS_COND_VAR)
     res |= pthread_cond_init(&cond_thread_wake, NULL);
 #endif
@@ -497,6 +694,7 @@ ThreadPool::ThreadPool()
         CV_LOG_FATAL(NULL, "Failed to initialize ThreadPool (pthreads)");
     }
     num_threads = defaultNumberOfThreads();
+    next_job = 0;
 }
 
 bool ThreadPool::reconfigure_(unsigned new_threads_count)
@@ -549,11 +747,32 @@ ThreadPool::~ThreadPool()
 #endif
     pthread_mutex_destroy(&mutex);
     pthread_mutex_destroy(&mutex_notify);
+    pthread_mutex_destroy(&mutex_jobs);
+}
+
+Ptr<ParallelJob> ThreadPool::findPendingJob()
+{
+    Ptr<ParallelJob> result;
+    pthread_mutex_lock(&mutex_jobs);
+    const size_t n = jobs.size();
+    for (size_t i = 0; i < n; i++)
+    {
+        const Ptr<ParallelJob>& j = jobs[(next_job + i) % n];
+        if (!j->is_completed && j->hasPendingTasks())
+        {
+            result = j;
+            next_job = (next_job + i + 1) % n;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&mutex_jobs);
+    return result;
 }
 
-void ThreadPool::run(const Range& range, const ParallelLoopBody& body, double nstripes)
+// Returns false if the body is executed by the calling thread without the worker threads
+bool ThreadPool::run(const Range& range, const ParallelLoopBody& body, double nstripes)
 {
-    CV_LOG_VERBOSE(NULL, 1, "MainThread: new parallel job: num_threads=" << num_threads << "   range=" << range.size() << "   nstripes=" << nstripes << "   job=" << (void*)job);
+    CV_LOG_VERBOSE(NULL, 1, "MainThread: new parallel job: num_threads=" << num_threads << "   range=" << range.size() << "   nstripes=" << nstripes);
 #ifdef CV_PROFILE_THREADS
     jobSubmitTime = getTickCount();
     threads_stat[0].reset();
@@ -561,74 +780,55 @@ void ThreadPool::run(const Range& range, const ParallelLoopBody& body, double ns
     threads_stat[0].threadWake = jobSubmitTime;
 #endif
     if (getNumOfThreads() > 1 &&
-        job == NULL &&
         (range.size() * nstripes >= 2 || (range.size() > 1 && nstripes <= 0))
     )
     {
+        CV_LOG_VERBOSE(NULL, 1, "MainThread: initialize parallel job: " << range.size());
+        Ptr<ParallelJob> job(new ParallelJob(*this, range, body, nstripes));
+
         pthread_mutex_lock(&mutex);
-        if (job != NULL)
-        {
-            pthread_mutex_unlock(&mutex);
-            body(range);
-            return;
-        }
-        reconfigure_(num_threads - 1);
+        pthread_mutex_lock(&mutex_jobs);
+        bool is_idle = jobs.empty();
+        jobs.push_back(job);
+        pthread_mutex_unlock(&mutex_jobs);
+        // workers can't be stopped while they serve jobs of other threads
+        if (is_idle || threads.size() < num_threads - 1)
+            reconfigure_(num_threads - 1);
 
         {
-            CV_LOG_VERBOSE(NULL, 1, "MainThread: initialize parallel job: " << range.size());
-            job = Ptr<ParallelJob>(new ParallelJob(*this, range, body, nstripes));
-            pthread_mutex_unlock(&mutex);
-
             CV_LOG_VERBOSE(NULL, 5, "MainThread: wake worker threads...");
+            // Only workers without an assigned job are woken. Busy ones join this job through
+            // findPendingJob() after completing their current one.
             size_t num_threads_to_wake = std::min(static_cast<size_t>(range.size()), threads.size());
-            for (size_t i = 0; i < num_threads_to_wake; ++i)
+            for (size_t i = 0; i < threads.size() && num_threads_to_wake > 0; ++i)
             {
-                if (job->current_task >= job->range.size())
+                if (!job->hasPendingTasks())
                     break;
                 WorkerThread& thread = *(threads[i].get());
-                if (
-#if defined(__clang__) && defined(__has_feature)
-#if __has_feature(thread_sanitizer)
-                        1 ||  // Robust workaround to avoid data race warning of `thread.job`
-#endif
-#endif
-#if !defined(CV_USE_GLOBAL_WORKERS_COND_VAR)
-                        thread.isActive ||
-#endif
-                        thread.has_wake_signal
-                        || !thread.job.empty()  // #10881
-                )
+                pthread_mutex_lock(&thread.mutex);
+                if (thread.has_wake_signal || !thread.job.empty())
                 {
-                    pthread_mutex_lock(&thread.mutex);
-                    thread.job = job;
-#if !defined(CV_USE_GLOBAL_WORKERS_COND_VAR)
-                    bool isActive = thread.isActive;
-#endif
-                    thread.has_wake_signal = true;
-#ifdef CV_PROFILE_THREADS
-                    threads_stat[i + 1].reset();
-#endif
                     pthread_mutex_unlock(&thread.mutex);
+                    continue;
+                }
+                thread.job = job;
 #if !defined(CV_USE_GLOBAL_WORKERS_COND_VAR)
-                    if (!isActive)
-                    {
-                        pthread_cond_broadcast/*pthread_cond_signal*/(&thread.cond_thread_wake); // wake thread
-                    }
+                bool isActive = thread.isActive;
 #endif
-                }
-                else
-                {
-                    CV_Assert(thread.job.empty());
-                    thread.job = job;
-                    thread.has_wake_signal = true;
+                thread.has_wake_signal = true;
 #ifdef CV_PROFILE_THREADS
-                    threads_stat[i + 1].reset();
+                threads_stat[i + 1].reset();
 #endif
+                pthread_mutex_unlock(&thread.mutex);
 #if !defined(CV_USE_GLOBAL_WORKERS_COND_VAR)
+                if (!isActive)
+                {
                     pthread_cond_broadcast/*pthread_cond_signal*/(&thread.cond_thread_wake); // wake thread
-#endif
                 }
+#endif
+                num_threads_to_wake--;
             }
+            pthread_mutex_unlock(&mutex);
 #ifdef CV_PROFILE_THREADS
             threads_stat[0].threadPing = getTickCount();
 #endif
@@ -641,15 +841,15 @@ void ThreadPool::run(const Range& range, const ParallelLoopBody& body, double ns
             CV_LOG_VERBOSE(NULL, 5, "MainThread: wake worker threads... (done)");
 
             {
-                ParallelJob& j = *(this->job);
+                ParallelJob& j = *job;
 #ifdef CV_PROFILE_THREADS
                 threads_stat[0].threadExecuteStart = getTickCount();
-                threads_stat[0].executedTasks = j.execute(false);
+                threads_stat[0].executedTasks = j.execute(false, j.caller_node);
                 threads_stat[0].threadExecuteStop = getTickCount();
 #else
-                j.execute(false);
+                j.execute(false, j.caller_node);
 #endif
-                CV_Assert(j.current_task >= j.range.size());
+                CV_Assert(!j.hasPendingTasks());
                 CV_LOG_VERBOSE(NULL, 5, "MainThread: complete self-tasks: " << j.active_thread_count << " " << j.completed_thread_count);
                 if (job->is_completed || j.active_thread_count == 0)
                 {
@@ -700,20 +900,16 @@ void ThreadPool::run(const Range& range, const ParallelLoopBody& body, double ns
                 threads_stat[i].dump(i - 1, jobSubmitTime, tickFreq);
             }
 #endif
-            if (job)
-            {
-                pthread_mutex_lock(&mutex);
-                CV_LOG_VERBOSE(NULL, 5, "MainThread: job release");
-                CV_Assert(job->is_completed);
-                job.release();
-                pthread_mutex_unlock(&mutex);
-            }
+            CV_LOG_VERBOSE(NULL, 5, "MainThread: job release");
+            CV_Assert(job->is_completed);
+            pthread_mutex_lock(&mutex_jobs);
+            jobs.erase(std::find(jobs.begin(), jobs.end(), job));
+            pthread_mutex_unlock(&mutex_jobs);
         }
+        return true;
     }
-    else
-    {
-        body(range);
-    }
+    body(range);
+    return false;
 }
 
 size_t ThreadPool::getNumOfThreads()
@@ -727,7 +923,12 @@ void ThreadPool::setNumOfThreads(unsigned n)
     {
         num_threads = n;
         if (n == 1)
-           if (job == NULL) reconfigure(0);  // stop worker threads immediately
+        {
+            pthread_mutex_lock(&mutex_jobs);
+            bool is_idle = jobs.empty();
+            pthread_mutex_unlock(&mutex_jobs);
+            if (is_idle) reconfigure(0);  // stop worker threads immediately
+        }
     }
 }
 
@@ -748,11 +949,33 @@ void parallel_pthreads_set_threads_num(int num)
     }
 }
 
-void parallel_for_pthreads(const Range& range, const ParallelLoopBody& body, double nstripes)
+bool parallel_for_pthreads(const Range& range, const ParallelLoopBody& body, double nstripes)
 {
-    ThreadPool::instance().run(range, body, nstripes);
+    return ThreadPool::instance().run(range, body, nstripes);
 }
 
+namespace details {
+
+void setThreadPoolNumaNodes(const std::vector< std::vector<int> >& node_cpus)
+{
+    ThreadPlacement* prev = g_forcedThreadPlacement;
+    g_forcedThreadPlacement = node_cpus.empty() ? NULL : new ThreadPlacement(node_cpus);
+    delete prev;
 }
 
+}  // namespace details
+
+}
+
+#else  // HAVE_PTHREADS_PF
+
+namespace cv { namespace details {
+
+void setThreadPoolNumaNodes(const std::vector< std::vector<int> >& /*node_cpus*/)
+{
+    // nothing, there is no pthreads thread pool
+}
+
+}}  // namespace
+
 #endif
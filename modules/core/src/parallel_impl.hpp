@@ -8,10 +8,22 @@ namespace cv {
 
 unsigned defaultNumberOfThreads();
 
-void parallel_for_pthreads(const Range& range, const ParallelLoopBody& body, double nstripes);
+// Returns false if the range is executed serially by the calling thread
+bool parallel_for_pthreads(const Range& range, const ParallelLoopBody& body, double nstripes);
 size_t parallel_pthreads_get_threads_num();
 void parallel_pthreads_set_threads_num(int num);
 
+namespace details {
+
+/** Forces splitting of pthreads thread pool jobs between NUMA nodes with the given CPUs of every node
+
+Threads are not pinned to these CPUs. An empty list restores the OPENCV_THREAD_POOL_NUMA behaviour.
+Used by tests, must not be called while parallel_for_() is running.
+*/
+CV_EXPORTS void setThreadPoolNumaNodes(const std::vector< std::vector<int> >& node_cpus);
+
+}  // namespace details
+
 }
 
 #endif // OPENCV_CORE_PARALLEL_IMPL_HPP
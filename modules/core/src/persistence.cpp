@@ -307,76 +307,6 @@ int decodeSimpleFormat( const char* dt )
 
 }
 
-#if defined __i386__ || defined(_M_IX86) || defined __x86_64__ || defined(_M_X64) || \
-    (defined (__LITTLE_ENDIAN__) && __LITTLE_ENDIAN__)
-#define CV_LITTLE_ENDIAN_MEM_ACCESS 1
-#else
-#define CV_LITTLE_ENDIAN_MEM_ACCESS 0
-#endif
-
-static inline int readInt(const uchar* p)
-{
-    // On little endian CPUs, both branches produce the same result. On big endian, only the else branch does.
-#if CV_LITTLE_ENDIAN_MEM_ACCESS
-    int val;
-    memcpy(&val, p, sizeof(val));
-    return val;
-#else
-    int val = (int)(p[0] | (p[1] << 8) | (p[2] << 16) | (p[3] << 24));
-    return val;
-#endif
-}
-
-static inline double readReal(const uchar* p)
-{
-    // On little endian CPUs, both branches produce the same result. On big endian, only the else branch does.
-#if CV_LITTLE_ENDIAN_MEM_ACCESS
-    double val;
-    memcpy(&val, p, sizeof(val));
-    return val;
-#else
-    unsigned val0 = (unsigned)(p[0] | (p[1] << 8) | (p[2] << 16) | (p[3] << 24));
-    unsigned val1 = (unsigned)(p[4] | (p[5] << 8) | (p[6] << 16) | (p[7] << 24));
-    Cv64suf val;
-    val.u = val0 | ((uint64)val1 << 32);
-    return val.f;
-#endif
-}
-
-static inline void writeInt(uchar* p, int ival)
-{
-    // On little endian CPUs, both branches produce the same result. On big endian, only the else branch does.
-#if CV_LITTLE_ENDIAN_MEM_ACCESS
-    memcpy(p, &ival, sizeof(ival));
-#else
-    p[0] = (uchar)ival;
-    p[1] = (uchar)(ival >> 8);
-    p[2] = (uchar)(ival >> 16);
-    p[3] = (uchar)(ival >> 24);
-#endif
-}
-
-static inline void writeReal(uchar* p, double fval)
-{
-    // On little endian CPUs, both branches produce the same result. On big endian, only the else branch does.
-#if CV_LITTLE_ENDIAN_MEM_ACCESS
-    memcpy(p, &fval, sizeof(fval));
-#else
-    Cv64suf v;
-    v.f = fval;
-    p[0] = (uchar)v.u;
-    p[1] = (uchar)(v.u >> 8);
-    p[2] = (uchar)(v.u >> 16);
-    p[3] = (uchar)(v.u >> 24);
-    p[4] = (uchar)(v.u >> 32);
-    p[5] = (uchar)(v.u >> 40);
-    p[6] = (uchar)(v.u >> 48);
-    p[7] = (uchar)(v.u >> 56);
-#endif
-}
-
-
-
 void FileStorage::Impl::init() {
     flags = 0;
     buffer.clear();
@@ -414,6 +344,8 @@ void FileStorage::Impl::init() {
     str_hash_data.clear();
     str_hash_data.resize(1);
     str_hash_data[0] = '\0';
+    binary_data.release();
+    stream_stack.clear();
 
     filename.clear();
     lineno = 0;
@@ -421,6 +353,8 @@ void FileStorage::Impl::init() {
 
 FileStorage::Impl::Impl(FileStorage *_fs) {
     fs_ext = _fs;
+    stream_handler = 0;
+    stream_max_depth = 0;
     init();
 }
 
@@ -441,6 +375,8 @@ void FileStorage::Impl::release(String *out) {
                 puts("</opencv_storage>\n");
             else if (fmt == FileStorage::FORMAT_JSON)
                 puts("}\n");
+            else if (fmt == FileStorage::FORMAT_BINARY)
+                getEmitter().endWriteStorage();
         }
         if (mem_mode && out) {
             *out = cv::String(outbuf.begin(), outbuf.end());
@@ -509,6 +445,23 @@ bool FileStorage::Impl::open(const char *filename_or_buf, int _flags, const char
 
     flags = _flags;
 
+    bool binary = write_mode && (flags & FileStorage::FORMAT_MASK) == FileStorage::FORMAT_BINARY;
+    if (binary && (mem_mode || append))
+        CV_Error(cv::Error::StsNotImplemented, "FileStorage::FORMAT_BINARY can't be used with FileStorage::MEMORY or FileStorage::APPEND");
+
+    if (!write_mode && !mem_mode && isBinaryStorage(filename)) {
+        try {
+            openBinaryStorage(this);
+        }
+        catch (...)
+        {
+            is_opened = true;
+            release();
+            throw;
+        }
+        return true;
+    }
+
     if (!mem_mode) {
         char *dot_pos = strrchr((char *) filename.c_str(), '.');
         char compression = '\0';
@@ -524,8 +477,11 @@ bool FileStorage::Impl::open(const char *filename_or_buf, int _flags, const char
                 dot_pos[3] = '\0', fnamelen--;
         }
 
+        if (binary && isGZ)
+            CV_Error(cv::Error::StsNotImplemented, "Compression of binary storage is not supported");
+
         if (!isGZ) {
-            file = fopen(filename.c_str(), !write_mode ? "rt" : !append ? "wt" : "a+t");
+            file = fopen(filename.c_str(), !write_mode ? "rt" : binary ? "wb" : !append ? "wt" : "a+t");
             if (!file)
             {
                 CV_LOG_ERROR(NULL, "Can't open file: '" << filename << "' in " << (!write_mode ? "read" : !append ? "write" : "append") << " mode");
@@ -653,6 +609,9 @@ bool FileStorage::Impl::open(const char *filename_or_buf, int _flags, const char
             }
 
             emitter_do_not_use_direct_dereference = createXMLEmitter(this);
+        } else if (fmt == FileStorage::FORMAT_BINARY) {
+            is_using_base64 = false;
+            emitter_do_not_use_direct_dereference = createBinaryEmitter(this);
         } else if (fmt == FileStorage::FORMAT_YAML) {
             if (!append)
                 puts("%YAML:1.0\n---\n");
@@ -734,6 +693,14 @@ bool FileStorage::Impl::open(const char *filename_or_buf, int _flags, const char
             writeInt(rptr + 5, 0);
 
             roots.clear();
+            if (stream_handler) {
+                // the streams have depth 0
+                StreamNode root;
+                root.node = root_nodes;
+                root.depth = -1;
+                root.started = true;
+                stream_stack.assign(1, root);
+            }
 
             switch (fmt) {
                 case FileStorage::FORMAT_XML:
@@ -754,13 +721,16 @@ bool FileStorage::Impl::open(const char *filename_or_buf, int _flags, const char
                 if (ok) {
                     finalizeCollection(root_nodes);
 
-                    CV_Assert(!fs_data_ptrs.empty());
-                    FileNode roots_node(fs_ext, 0, 0);
-                    size_t i, nroots = roots_node.size();
-                    FileNodeIterator it = roots_node.begin();
+                    // in the streaming mode the nodes have been passed to the handler and released
+                    if (!stream_handler) {
+                        CV_Assert(!fs_data_ptrs.empty());
+                        FileNode roots_node(fs_ext, 0, 0);
+                        size_t i, nroots = roots_node.size();
+                        FileNodeIterator it = roots_node.begin();
 
-                    for (i = 0; i < nroots; i++, ++it)
-                        roots.push_back(*it);
+                        for (i = 0; i < nroots; i++, ++it)
+                            roots.push_back(*it);
+                    }
                 }
             }
         }
@@ -806,7 +776,58 @@ char *FileStorage::Impl::getsFromFile(char *buf, int count) {
     CV_Error(cv::Error::StsError, "The storage is not opened");
 }
 
+int FileStorage::Impl::getcFromFile() {
+    if (file)
+        return fgetc(file);
+#if USE_ZLIB
+    if (gzfile)
+        return gzgetc(gzfile);
+#endif
+    CV_Error(cv::Error::StsError, "The storage is not opened");
+}
+
+// Long lines of JSON files are passed to the parser by chunks in the streaming mode.
+// The chunk can end after ',', '{' or '[' outside of string literals and comments,
+// the parser skips the line break which is added after the chunk.
+static bool isJSONSplitPoint(char c, int& state)
+{
+    enum { JSON_TEXT = 0, JSON_STRING, JSON_ESCAPE, JSON_SLASH, JSON_LINE_COMMENT,
+           JSON_BLOCK_COMMENT, JSON_BLOCK_COMMENT_STAR };
+    switch (state) {
+        case JSON_STRING:
+            if (c == '\\')
+                state = JSON_ESCAPE;
+            else if (c == '"')
+                state = JSON_TEXT;
+            return false;
+        case JSON_ESCAPE:
+            state = JSON_STRING;
+            return false;
+        case JSON_SLASH:
+            state = c == '/' ? JSON_LINE_COMMENT : c == '*' ? JSON_BLOCK_COMMENT : JSON_TEXT;
+            return false;
+        case JSON_LINE_COMMENT:
+            return false;
+        case JSON_BLOCK_COMMENT:
+            if (c == '*')
+                state = JSON_BLOCK_COMMENT_STAR;
+            return false;
+        case JSON_BLOCK_COMMENT_STAR:
+            state = c == '/' ? JSON_TEXT : c == '*' ? JSON_BLOCK_COMMENT_STAR : JSON_BLOCK_COMMENT;
+            return false;
+        default:
+            if (c == '"')
+                state = JSON_STRING;
+            else if (c == '/')
+                state = JSON_SLASH;
+            return c == ',' || c == '{' || c == '[';
+    }
+}
+
 char *FileStorage::Impl::gets(size_t maxCount) {
+    const bool split = maxCount == 0 && stream_handler && fmt == FileStorage::FORMAT_JSON;
+    int split_state = 0;
+
     if (strbuf) {
         size_t i = strbufpos, len = strbufsize;
         const char *instr = strbuf;
@@ -817,6 +838,10 @@ char *FileStorage::Impl::gets(size_t maxCount) {
                     i++;
                 break;
             }
+            if (split && isJSONSplitPoint(c, split_state) && i - strbufpos >= CV_FS_STREAM_CHUNK_SIZE) {
+                i++;
+                break;
+            }
         }
         size_t count = i - strbufpos;
         if (maxCount == 0 || maxCount > count)
@@ -830,7 +855,7 @@ char *FileStorage::Impl::gets(size_t maxCount) {
 
     const size_t MAX_BLOCK_SIZE = INT_MAX / 2; // hopefully, that will be enough
     if (maxCount == 0)
-        maxCount = MAX_BLOCK_SIZE;
+        maxCount = split ? CV_FS_STREAM_CHUNK_SIZE : MAX_BLOCK_SIZE;
     else
         CV_Assert(maxCount < MAX_BLOCK_SIZE);
     size_t ofs = 0;
@@ -848,6 +873,24 @@ char *FileStorage::Impl::gets(size_t maxCount) {
         if (delta == count)
             buffer.resize((size_t) (buffer.size() * 1.5));
     }
+    if (split && ofs > 0 && buffer[ofs - 1] != '\n') {
+        // the line is longer than the chunk, read it up to the nearest split point
+        bool can_split = false;
+        for (size_t i = 0; i < ofs; i++)
+            can_split = isJSONSplitPoint(buffer[i], split_state);
+        while (!can_split) {
+            int c = getcFromFile();
+            if (c == EOF)
+                break;
+            if (ofs + 16 >= buffer.size())
+                buffer.resize((size_t) (buffer.size() * 1.5));
+            buffer[ofs++] = (char) c;
+            if (c == '\n')
+                break;
+            can_split = isJSONSplitPoint((char) c, split_state);
+        }
+        buffer[ofs] = '\0';
+    }
     return ofs > 0 ? &buffer[0] : 0;
 }
 
@@ -1076,6 +1119,9 @@ void FileStorage::Impl::writeRawData(const std::string &dt, const void *_data, s
         switch_to_Base64_state(FileStorage_API::Base64State::NotUse);
     }
 
+    if (getEmitter().writeRawData(dt.c_str(), _data, len))
+        return;
+
     size_t elemSize = fs::calcStructSize(dt.c_str(), 0);
     CV_Assert(elemSize);
     CV_Assert(len % elemSize == 0);
@@ -1533,7 +1579,16 @@ FileNode FileStorage::Impl::addNode(FileNode &collection, const std::string &key
                                     int elem_type, const void *value, int len) {
     FileStorage_API *fs = this;
     bool noname = key.empty() || (fmt == FileStorage::FORMAT_XML && strcmp(key.c_str(), "_") == 0);
+    if (stream_handler)
+        streamCompleteNodes(collection);
     convertToCollection(noname ? FileNode::SEQ : FileNode::MAP, collection);
+    if (stream_handler) {
+        StreamNode &parent = stream_stack.back();
+        if (!parent.started && parent.depth < stream_max_depth) {
+            parent.started = true;
+            stream_handler->startCollection(parent.key, collection.type(), parent.depth);
+        }
+    }
 
     bool isseq = collection.empty() ? false : collection.isSeq();
     if (noname != isseq)
@@ -1582,10 +1637,21 @@ FileNode FileStorage::Impl::addNode(FileNode &collection, const std::string &key
     int nelems = readInt(cp + 5);
     writeInt(cp + 5, nelems + 1);
 
+    if (stream_handler) {
+        StreamNode elem;
+        elem.node = node;
+        elem.key = noname ? std::string() : key;
+        elem.depth = stream_stack.back().depth + 1;
+        elem.started = false;
+        stream_stack.push_back(elem);
+    }
+
     return node;
 }
 
 void FileStorage::Impl::finalizeCollection(FileNode &collection) {
+    if (stream_handler)
+        streamCompleteNodes(collection);
     if (!collection.isSeq() && !collection.isMap())
         return;
     uchar *ptr0 = collection.ptr(), *ptr = ptr0 + 1;
@@ -1607,6 +1673,62 @@ void FileStorage::Impl::finalizeCollection(FileNode &collection) {
     writeInt(ptr, (int) rawSize);
 }
 
+void FileStorage::Impl::streamCompleteNodes(const FileNode &collection) {
+    // positions of the nodes in the stack can be outdated if the nodes have been moved
+    // to the next block (see reserveNodeSpace()), normalizeNodeOfs() fixes them
+    size_t blockIdx = collection.blockIdx, ofs = collection.ofs;
+    normalizeNodeOfs(blockIdx, ofs);
+    while (!stream_stack.empty()) {
+        StreamNode &top = stream_stack.back();
+        size_t nodeBlockIdx = top.node.blockIdx, nodeOfs = top.node.ofs;
+        normalizeNodeOfs(nodeBlockIdx, nodeOfs);
+        if (nodeBlockIdx == blockIdx && nodeOfs == ofs)
+            return;
+
+        // the parser has started the next element of the collection or the collection is finished,
+        // so the top node is complete
+        StreamNode elem = top;
+        stream_stack.pop_back();
+        if (elem.depth > stream_max_depth)
+            continue; // the node is passed to the handler with its parent
+
+        FileNode node(fs_ext, nodeBlockIdx, nodeOfs);
+        int type = node.type();
+        if (elem.started || (elem.depth < stream_max_depth && FileNode::isCollection(type))) {
+            if (!elem.started)
+                stream_handler->startCollection(elem.key, type, elem.depth);
+            stream_handler->endCollection(elem.key, type, elem.depth);
+        } else
+            stream_handler->node(elem.key, node, elem.depth);
+
+        // release the node memory, it is the last node in the storage
+        fs_data.resize(nodeBlockIdx + 1);
+        fs_data_ptrs.resize(nodeBlockIdx + 1);
+        fs_data_blksz.resize(nodeBlockIdx + 1);
+        freeSpaceOfs = nodeOfs;
+    }
+    CV_Error(cv::Error::StsInternal, "The collection is not found in the stack of the streaming reader");
+}
+
+bool FileStorage::Impl::readStream(const char *filename_or_buf, FileStorageStreamHandler &handler,
+                                   int maxDepth, int _flags, const char *encoding) {
+    CV_Assert((_flags & ~(FileStorage::MEMORY | FileStorage::FORMAT_MASK)) == FileStorage::READ);
+    CV_Assert(maxDepth >= 0);
+    bool ok = false;
+    stream_handler = &handler;
+    stream_max_depth = maxDepth;
+    try {
+        ok = open(filename_or_buf, _flags, encoding);
+    }
+    catch (...)
+    {
+        stream_handler = 0;
+        throw;
+    }
+    stream_handler = 0;
+    return ok;
+}
+
 void FileStorage::Impl::normalizeNodeOfs(size_t &blockIdx, size_t &ofs) const {
     while (ofs >= fs_data_blksz[blockIdx]) {
         if (blockIdx == fs_data_blksz.size() - 1) {
@@ -1984,6 +2106,46 @@ int FileStorage::getFormat() const
     return p->fmt;
 }
 
+// passes the node tree of the binary storage to the stream handler
+static void readBinaryStream(FileStorageStreamHandler& handler, const std::string& key,
+                             const FileNode& node, int depth, int maxDepth)
+{
+    // elements of raw data can't be passed to the handler one by one
+    if( depth < maxDepth && FileNode::isCollection(node.type()) && !fs::getBinaryRawDataNode(node) )
+    {
+        handler.startCollection(key, node.type(), depth);
+        for( FileNodeIterator it = node.begin(); it != node.end(); ++it )
+        {
+            FileNode elem = *it;
+            readBinaryStream(handler, elem.isNamed() ? elem.name() : std::string(), elem, depth + 1, maxDepth);
+        }
+        handler.endCollection(key, node.type(), depth);
+    }
+    else
+        handler.node(key, node, depth);
+}
+
+bool FileStorage::readStream(const String& filename, FileStorageStreamHandler& handler, int maxDepth,
+                             int flags, const String& encoding)
+{
+    FileStorage fs;
+    if( !fs.p->readStream(filename.c_str(), handler, maxDepth, flags, encoding.c_str()) )
+        return false;
+    if( fs.p->fmt == FORMAT_BINARY )
+    {
+        // the storage is memory-mapped, the nodes are read in place
+        for( size_t i = 0; i < fs.p->roots.size(); i++ )
+            readBinaryStream(handler, std::string(), fs.p->roots[i], 0, maxDepth);
+    }
+    return true;
+}
+
+FileStorageStreamHandler::~FileStorageStreamHandler() {}
+
+void FileStorageStreamHandler::startCollection(const String&, int, int) {}
+
+void FileStorageStreamHandler::endCollection(const String&, int, int) {}
+
 FileNode FileStorage::operator [](const char* key) const
 {
     return this->operator[](std::string(key));
@@ -2440,6 +2602,90 @@ void FileNode::setValue( int type, const void* value, int len )
     }
 }
 
+static void getScalarLayout(const char* dt, std::vector<std::pair<size_t, int> >& layout, size_t& esz)
+{
+    int fmt_pairs[CV_FS_MAX_FMT_PAIRS*2];
+    int fmt_pair_count = fs::decodeFormat( dt, fmt_pairs, CV_FS_MAX_FMT_PAIRS );
+    size_t offset = 0;
+    layout.clear();
+    for( int k = 0; k < fmt_pair_count; k++ )
+    {
+        int depth = fmt_pairs[k*2+1];
+        size_t elem_size = CV_ELEM_SIZE(depth);
+        offset = alignSize( offset, (int)elem_size );
+        for( int i = 0; i < fmt_pairs[k*2]; i++, offset += elem_size )
+            layout.push_back(std::make_pair(offset, depth));
+    }
+    esz = fs::calcStructSize( dt, 0 );
+}
+
+static double readScalar(const uchar* p, int depth)
+{
+    switch( depth )
+    {
+    case CV_8U: return *p;
+    case CV_8S: return *(const schar*)p;
+    case CV_16U: return *(const ushort*)p;
+    case CV_16S: return *(const short*)p;
+    case CV_32S: return *(const int*)p;
+    case CV_32F: return *(const float*)p;
+    case CV_64F: return *(const double*)p;
+    case CV_16F: return (float)*(const hfloat*)p;
+    default: CV_Error( Error::StsUnsupportedFormat, "Unsupported type" );
+    }
+}
+
+static void writeScalar(uchar* p, int depth, double val)
+{
+    switch( depth )
+    {
+    case CV_8U: *p = saturate_cast<uchar>(val); break;
+    case CV_8S: *(schar*)p = saturate_cast<schar>(val); break;
+    case CV_16U: *(ushort*)p = saturate_cast<ushort>(val); break;
+    case CV_16S: *(short*)p = saturate_cast<short>(val); break;
+    case CV_32S: *(int*)p = saturate_cast<int>(val); break;
+    case CV_32F: *(float*)p = (float)val; break;
+    case CV_64F: *(double*)p = val; break;
+    case CV_16F: *(hfloat*)p = hfloat((float)val); break;
+    default: CV_Error( Error::StsUnsupportedFormat, "Unsupported type" );
+    }
+}
+
+// reads elements [idx, nelems) of raw data block of the binary storage, returns the number of read elements
+static size_t readBinaryRawData(const FileStorage::Impl* fs, const uchar* node, size_t idx, size_t nelems,
+                                const String& fmt, uchar* dst, size_t maxsz)
+{
+    size_t size = 0;
+    const char* dt = 0;
+    const uchar* src = fs::getBinaryRawData(fs, node, size, dt);
+
+    std::vector<std::pair<size_t, int> > src_layout, dst_layout;
+    size_t src_esz = 0, dst_esz = 0;
+    getScalarLayout(dt, src_layout, src_esz);
+    getScalarLayout(fmt.c_str(), dst_layout, dst_esz);
+    CV_Assert( !src_layout.empty() && !dst_layout.empty() && maxsz % dst_esz == 0 );
+    const size_t src_cn = src_layout.size(), dst_cn = dst_layout.size();
+    const size_t count = std::min(maxsz / dst_esz * dst_cn, nelems - idx);
+    if( (idx + count + src_cn - 1) / src_cn * src_esz > size )
+        CV_Error( Error::StsParseError, "Raw data block of binary storage is too small" );
+
+    if( src_layout == dst_layout && src_esz == dst_esz && idx % src_cn == 0 && count % src_cn == 0 )
+    {
+        memcpy(dst, src + idx / src_cn * src_esz, count / src_cn * src_esz);
+        return count;
+    }
+
+    for( size_t i = 0; i < count; i++ )
+    {
+        size_t j = idx + i;
+        const std::pair<size_t, int>& s = src_layout[j % src_cn];
+        const std::pair<size_t, int>& d = dst_layout[i % dst_cn];
+        writeScalar(dst + i / dst_cn * dst_esz + d.first, d.second,
+                    readScalar(src + j / src_cn * src_esz + s.first, s.second));
+    }
+    return count;
+}
+
 FileNodeIterator::FileNodeIterator()
 {
     fs = 0;
@@ -2518,6 +2764,8 @@ FileNodeIterator& FileNodeIterator::operator=(const FileNodeIterator& it)
 
 FileNode FileNodeIterator::operator *() const
 {
+    if( fs && idx < nodeNElems && *fs->getNodePtr(blockIdx, ofs) == CV_FS_RAW_DATA_TAG )
+        CV_Error( Error::StsNotImplemented, "Elements of raw data in binary storage can be read by readRaw() only" );
     return FileNode(idx < nodeNElems ? fs : NULL, blockIdx, ofs);
 }
 
@@ -2527,7 +2775,16 @@ FileNodeIterator& FileNodeIterator::operator ++ ()
         return *this;
     idx++;
     FileNode n(fs, blockIdx, ofs);
-    ofs += n.rawSize();
+    const uchar* p = n.ptr();
+    if( *p == CV_FS_RAW_DATA_TAG )
+    {
+        // all elements are stored in one raw data block
+        if( idx < nodeNElems )
+            return *this;
+        ofs += fs::getBinaryRawDataNodeSize(p);
+    }
+    else
+        ofs += n.rawSize();
     if( ofs >= blockSize )
     {
         fs->normalizeNodeOfs(blockIdx, ofs);
@@ -2553,7 +2810,21 @@ FileNodeIterator& FileNodeIterator::operator += (int _ofs)
 
 FileNodeIterator& FileNodeIterator::readRaw( const String& fmt, void* _data0, size_t maxsz)
 {
-    if( fs && idx < nodeNElems )
+    if( fs && idx < nodeNElems && *fs->getNodePtr(blockIdx, ofs) == CV_FS_RAW_DATA_TAG )
+    {
+        const uchar* p = fs->getNodePtr(blockIdx, ofs);
+        idx += readBinaryRawData(fs, p, idx, nodeNElems, fmt, (uchar*)_data0, maxsz);
+        if( idx == nodeNElems )
+        {
+            ofs += fs::getBinaryRawDataNodeSize(p);
+            if( ofs >= blockSize )
+            {
+                fs->normalizeNodeOfs(blockIdx, ofs);
+                blockSize = fs->fs_data_blksz[blockIdx];
+            }
+        }
+    }
+    else if( fs && idx < nodeNElems )
     {
         uchar* data0 = (uchar*)_data0;
         int fmt_pairs[CV_FS_MAX_FMT_PAIRS*2];
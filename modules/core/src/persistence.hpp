@@ -44,6 +44,11 @@ enum
 #define CV_FS_MAX_LEN 4096
 #define CV_FS_MAX_FMT_PAIRS  128
 
+//! tag of the node which references raw data block of the binary storage (instead of sequence elements)
+#define CV_FS_RAW_DATA_TAG 0xFF
+//! minimal length of JSON line chunks in the streaming mode, see FileStorage::readStream()
+#define CV_FS_STREAM_CHUNK_SIZE (1 << 16)
+
 /****************************************************************************************\
 *                            Common macros and type definitions                          *
 \****************************************************************************************/
@@ -82,6 +87,75 @@ inline char* cv_skip_BOM(char* ptr)
 
 namespace cv
 {
+
+#if defined __i386__ || defined(_M_IX86) || defined __x86_64__ || defined(_M_X64) || \
+    (defined (__LITTLE_ENDIAN__) && __LITTLE_ENDIAN__)
+#define CV_LITTLE_ENDIAN_MEM_ACCESS 1
+#else
+#define CV_LITTLE_ENDIAN_MEM_ACCESS 0
+#endif
+
+inline int readInt(const uchar* p)
+{
+    // On little endian CPUs, both branches produce the same result. On big endian, only the else branch does.
+#if CV_LITTLE_ENDIAN_MEM_ACCESS
+    int val;
+    memcpy(&val, p, sizeof(val));
+    return val;
+#else
+    int val = (int)(p[0] | (p[1] << 8) | (p[2] << 16) | (p[3] << 24));
+    return val;
+#endif
+}
+
+inline double readReal(const uchar* p)
+{
+    // On little endian CPUs, both branches produce the same result. On big endian, only the else branch does.
+#if CV_LITTLE_ENDIAN_MEM_ACCESS
+    double val;
+    memcpy(&val, p, sizeof(val));
+    return val;
+#else
+    unsigned val0 = (unsigned)(p[0] | (p[1] << 8) | (p[2] << 16) | (p[3] << 24));
+    unsigned val1 = (unsigned)(p[4] | (p[5] << 8) | (p[6] << 16) | (p[7] << 24));
+    Cv64suf val;
+    val.u = val0 | ((uint64)val1 << 32);
+    return val.f;
+#endif
+}
+
+inline void writeInt(uchar* p, int ival)
+{
+    // On little endian CPUs, both branches produce the same result. On big endian, only the else branch does.
+#if CV_LITTLE_ENDIAN_MEM_ACCESS
+    memcpy(p, &ival, sizeof(ival));
+#else
+    p[0] = (uchar)ival;
+    p[1] = (uchar)(ival >> 8);
+    p[2] = (uchar)(ival >> 16);
+    p[3] = (uchar)(ival >> 24);
+#endif
+}
+
+inline void writeReal(uchar* p, double fval)
+{
+    // On little endian CPUs, both branches produce the same result. On big endian, only the else branch does.
+#if CV_LITTLE_ENDIAN_MEM_ACCESS
+    memcpy(p, &fval, sizeof(fval));
+#else
+    Cv64suf v;
+    v.f = fval;
+    p[0] = (uchar)v.u;
+    p[1] = (uchar)(v.u >> 8);
+    p[2] = (uchar)(v.u >> 16);
+    p[3] = (uchar)(v.u >> 24);
+    p[4] = (uchar)(v.u >> 32);
+    p[5] = (uchar)(v.u >> 40);
+    p[6] = (uchar)(v.u >> 48);
+    p[7] = (uchar)(v.u >> 56);
+#endif
+}
+
 namespace fs
 {
 int strcasecmp(const char* str1, const char* str2);
@@ -95,6 +169,9 @@ CV_DEPRECATED char* encodeFormat( int elem_type, char* dt );
 char* encodeFormat( int elem_type, char* dt, size_t dt_len );
 int decodeFormat( const char* dt, int* fmt_pairs, int max_len );
 int decodeSimpleFormat( const char* dt );
+
+//! creates matrix which references raw data block of the binary storage, returns false if node has no suitable block
+bool mapBinaryRawData( const FileNode& node, int dims, const int* sizes, int type, Mat& m );
 }
 
 
@@ -198,6 +275,10 @@ public:
     virtual void writeScalar(const char* key, const char* value) = 0;
     virtual void writeComment(const char* comment, bool eol_comment) = 0;
     virtual void startNextStream() = 0;
+    //! stores raw data without conversion to text, returns false to write it element by element through writeScalar()
+    virtual bool writeRawData(const char* /*dt*/, const void* /*data*/, size_t /*len*/) { return false; }
+    //! called on release() after all structures are closed
+    virtual void endWriteStorage() {}
 };
 
 class FileStorageParser
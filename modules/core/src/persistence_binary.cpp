@@ -0,0 +1,626 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html
+
+#include "precomp.hpp"
+#include "persistence.hpp"
+#include "persistence_impl.hpp"
+
+#if defined __unix__ || defined __APPLE__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/*
+  Layout of the binary storage:
+
+  - header (CV_FS_BINARY_HEADER_SIZE bytes): signature, byte order mark, version,
+    offsets and sizes of the node tree and of the names table;
+  - raw data blocks written by FileStorage::writeRaw(), every block is aligned by CV_FS_BINARY_DATA_ALIGN bytes;
+  - node tree in the same representation as FileStorage::Impl uses in memory (see FileStorage::Impl::addNode());
+  - names table (FileStorage::Impl::str_hash_data).
+
+  Sequences which are filled by writeRaw() contain a single raw data node instead of their elements:
+  CV_FS_RAW_DATA_TAG, 64-bit offset and size of the data block, format string of the elements.
+  Raw data is stored with the native byte order.
+*/
+
+namespace cv
+{
+
+enum
+{
+    CV_FS_BINARY_HEADER_SIZE = 64,
+    CV_FS_BINARY_DATA_ALIGN = 64,
+    CV_FS_BINARY_VERSION = 1,
+    CV_FS_BINARY_MAX_DEPTH = 1024
+};
+
+static const char binary_signature[16] = "%OPENCV-BINARY\n";
+static const unsigned binary_byte_order_mark = 0x01020304;
+
+static inline void writeUInt64(uchar* p, uint64 val)
+{
+    writeInt(p, (int)(unsigned)val);
+    writeInt(p + 4, (int)(unsigned)(val >> 32));
+}
+
+static inline uint64 readUInt64(const uchar* p)
+{
+    return (uint64)(unsigned)readInt(p) | ((uint64)(unsigned)readInt(p + 4) << 32);
+}
+
+//! Memory of the opened binary storage. It is shared with the matrices which reference raw data blocks.
+class BinaryStorageData
+{
+public:
+    BinaryStorageData() : data_(0), size_(0), mapped_(false) {}
+    ~BinaryStorageData() { close(); }
+
+    // The file is mapped with copy-on-write access, so matrices which reference the data can be modified
+    // without changes in the file. The file must not be truncated while it is mapped: pages which are not
+    // touched yet are still read from the file, access beyond its new end raises SIGBUS.
+    bool open(const std::string& filename)
+    {
+        close();
+#if defined _WIN32 && !defined WINRT
+        HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL, NULL);
+        if (file != INVALID_HANDLE_VALUE)
+        {
+            LARGE_INTEGER size;
+            if (GetFileSizeEx(file, &size) && size.QuadPart > 0 && (uint64)size.QuadPart <= (uint64)SIZE_MAX)
+            {
+                HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+                if (mapping)
+                {
+                    data_ = (uchar*)MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+                    if (data_)
+                    {
+                        size_ = (size_t)size.QuadPart;
+                        mapped_ = true;
+                    }
+                    CloseHandle(mapping); // the view keeps the mapping alive
+                }
+            }
+            CloseHandle(file);
+        }
+#elif defined __unix__ || defined __APPLE__
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd >= 0)
+        {
+            struct stat st;
+            if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0 && (uint64)st.st_size <= (uint64)SIZE_MAX)
+            {
+                void* ptr = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+                if (ptr != MAP_FAILED)
+                {
+                    data_ = (uchar*)ptr;
+                    size_ = (size_t)st.st_size;
+                    mapped_ = true;
+                }
+            }
+            ::close(fd); // the mapping stays valid
+        }
+#endif
+        if (!data_)
+        {
+            // no memory mapping on this platform, read the whole file
+            FILE* f = fopen(filename.c_str(), "rb");
+            if (!f)
+                return false;
+            fseek(f, 0, SEEK_END);
+            long size = ftell(f);
+            fseek(f, 0, SEEK_SET);
+            if (size > 0)
+            {
+                data_ = (uchar*)fastMalloc((size_t)size);
+                size_ = fread(data_, 1, (size_t)size, f);
+            }
+            fclose(f);
+        }
+        return data_ != 0;
+    }
+
+    void close()
+    {
+        if (!data_)
+            return;
+        if (mapped_)
+        {
+#if defined _WIN32 && !defined WINRT
+            UnmapViewOfFile(data_);
+#elif defined __unix__ || defined __APPLE__
+            munmap(data_, size_);
+#endif
+        }
+        else
+            fastFree(data_);
+        data_ = 0;
+        size_ = 0;
+        mapped_ = false;
+    }
+
+    uchar* data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    uchar* data_;
+    size_t size_;
+    bool mapped_;
+
+    BinaryStorageData(const BinaryStorageData&); // copy disabled
+    BinaryStorageData& operator=(const BinaryStorageData&); // assign disabled
+};
+
+//! Allocator of matrices which reference raw data of the binary storage, keeps the storage memory alive.
+class BinaryStorageMatAllocator CV_FINAL : public MatAllocator
+{
+public:
+    UMatData* allocate(int dims, const int* sizes, int type, void* data, size_t* step,
+                       AccessFlag flags, UMatUsageFlags usageFlags) const CV_OVERRIDE
+    {
+        // re-allocation of the matrix, e.g. Mat::create() with another size
+        return Mat::getStdAllocator()->allocate(dims, sizes, type, data, step, flags, usageFlags);
+    }
+
+    bool allocate(UMatData* u, AccessFlag /*accessFlags*/, UMatUsageFlags /*usageFlags*/) const CV_OVERRIDE
+    {
+        return u != NULL;
+    }
+
+    void deallocate(UMatData* u) const CV_OVERRIDE
+    {
+        if (!u)
+            return;
+        CV_Assert(u->urefcount == 0);
+        CV_Assert(u->refcount == 0);
+        delete (Ptr<BinaryStorageData>*)u->userdata;
+        delete u;
+    }
+
+    static BinaryStorageMatAllocator& getInstance()
+    {
+        CV_SINGLETON_LAZY_INIT_REF(BinaryStorageMatAllocator, new BinaryStorageMatAllocator())
+    }
+};
+
+//////////////////////////////////////////////// Writer ////////////////////////////////////////////////
+
+class BinaryEmitter : public FileStorageEmitter
+{
+public:
+    BinaryEmitter(FileStorage::Impl* _fs) : fs(_fs), fileSize(0), rawDataSize(0)
+    {
+        uchar header[CV_FS_BINARY_HEADER_SIZE] = {0};
+        putBytes(header, sizeof(header));
+
+        // the same root collection as the parsers create
+        FileNode roots(fs, 0, 0);
+        uchar* ptr = fs->reserveNodeSpace(roots, 9);
+        *ptr = FileNode::SEQ;
+        writeInt(ptr + 1, 4);
+        writeInt(ptr + 5, 0);
+        nodes.push_back(roots);
+        startNextStream();
+    }
+
+    FStructData startWriteStruct(const FStructData& /*parent*/, const char* key,
+                                 int struct_flags, const char* type_name) CV_OVERRIDE
+    {
+        nodes.push_back(addNode(key, struct_flags & FileNode::TYPE_MASK, 0));
+        return FStructData(type_name ? type_name : "", struct_flags, 0);
+    }
+
+    void endWriteStruct(const FStructData& /*current_struct*/) CV_OVERRIDE
+    {
+        CV_Assert(nodes.size() > 1);
+        fs->finalizeCollection(nodes.back());
+        nodes.pop_back();
+        rawDataNode = FileNode();
+    }
+
+    void write(const char* key, int value) CV_OVERRIDE
+    {
+        addNode(key, FileNode::INT, &value);
+    }
+
+    void write(const char* key, double value) CV_OVERRIDE
+    {
+        addNode(key, FileNode::REAL, &value);
+    }
+
+    void write(const char* key, const char* str, bool /*quote*/) CV_OVERRIDE
+    {
+        addNode(key, FileNode::STRING, str);
+    }
+
+    void writeScalar(const char* key, const char* data) CV_OVERRIDE
+    {
+        // numbers which are produced by FileStorage::Impl::writeRawData()
+        char* endptr = 0;
+        long ival = strtol(data, &endptr, 10);
+        if (*endptr == '\0' && endptr != data && ival >= INT_MIN && ival <= INT_MAX)
+        {
+            write(key, (int)ival);
+            return;
+        }
+        double fval = fs->strtod((char*)data, &endptr);
+        if (*endptr == '\0' && endptr != data)
+            write(key, fval);
+        else
+            write(key, data, false);
+    }
+
+    void writeComment(const char* /*comment*/, bool /*eol_comment*/) CV_OVERRIDE
+    {
+        // comments are not stored
+    }
+
+    void startNextStream() CV_OVERRIDE
+    {
+        CV_Assert(nodes.size() == 1);
+        nodes.push_back(fs->addNode(nodes[0], std::string(), FileNode::MAP, 0, -1));
+        initCollection(nodes.back());
+    }
+
+    bool writeRawData(const char* dt, const void* data, size_t len) CV_OVERRIDE
+    {
+        FileNode& collection = nodes.back();
+        if (!collection.isSeq())
+            return false;
+
+        uchar* ptr;
+        const bool append = !rawDataNode.empty();
+        if (append)
+        {
+            ptr = rawDataNode.ptr();
+            if (rawDataFormat != dt)
+                CV_Error(Error::StsNotImplemented, "Binary storage can't store raw data of different types in one sequence");
+        }
+        else
+        {
+            // elements of non-empty sequence are stored as separate nodes
+            if (collection.size() > 0)
+                return false;
+            size_t dtlen = strlen(dt);
+            rawDataNode = FileNode(fs, fs->fs_data_ptrs.size() - 1, fs->freeSpaceOfs);
+            ptr = fs->reserveNodeSpace(rawDataNode, 1 + 16 + dtlen + 1);
+            *ptr = (uchar)CV_FS_RAW_DATA_TAG;
+            memcpy(ptr + 17, dt, dtlen + 1);
+            rawDataFormat = dt;
+
+            static const uchar zeros[CV_FS_BINARY_DATA_ALIGN] = {0};
+            putBytes(zeros, alignSize(fileSize, CV_FS_BINARY_DATA_ALIGN) - fileSize);
+            rawDataOffset = fileSize;
+            rawDataSize = 0;
+        }
+
+        size_t elemSize = fs::calcStructSize(dt, 0);
+        CV_Assert(elemSize > 0 && len % elemSize == 0);
+        int fmt_pairs[CV_FS_MAX_FMT_PAIRS*2];
+        int fmt_pair_count = fs::decodeFormat(dt, fmt_pairs, CV_FS_MAX_FMT_PAIRS);
+        size_t nscalars = 0;
+        for (int k = 0; k < fmt_pair_count; k++)
+            nscalars += fmt_pairs[k*2];
+
+        putBytes(data, len);
+        rawDataSize += len;
+        writeUInt64(ptr + 1, rawDataOffset);
+        writeUInt64(ptr + 9, rawDataSize);
+
+        uchar* cp = collection.ptr() + 1 + (collection.isNamed() ? 4 : 0);
+        writeInt(cp + 4, (int)(readInt(cp + 4) + nscalars*(len / elemSize)));
+        fs->setNonEmpty();
+        return true;
+    }
+
+    void endWriteStorage() CV_OVERRIDE
+    {
+        while (nodes.size() > 1)
+        {
+            fs->finalizeCollection(nodes.back());
+            nodes.pop_back();
+        }
+        fs->finalizeCollection(nodes[0]);
+
+        static const uchar zeros[8] = {0};
+        putBytes(zeros, alignSize(fileSize, 8) - fileSize);
+        uint64 treeOffset = fileSize;
+        size_t nblocks = fs->fs_data_ptrs.size();
+        for (size_t i = 0; i < nblocks; i++)
+            putBytes(fs->fs_data_ptrs[i], i + 1 < nblocks ? fs->fs_data_blksz[i] : fs->freeSpaceOfs);
+        uint64 stringsOffset = fileSize;
+        putBytes(&fs->str_hash_data[0], fs->str_hash_data.size());
+
+        uchar header[CV_FS_BINARY_HEADER_SIZE] = {0};
+        memcpy(header, binary_signature, sizeof(binary_signature));
+        memcpy(header + 16, &binary_byte_order_mark, 4);
+        writeInt(header + 20, CV_FS_BINARY_VERSION);
+        writeUInt64(header + 24, treeOffset);
+        writeUInt64(header + 32, stringsOffset - treeOffset);
+        writeUInt64(header + 40, stringsOffset);
+        writeUInt64(header + 48, fileSize - stringsOffset);
+        CV_Assert(fs->file);
+        if (fseek(fs->file, 0, SEEK_SET) != 0 || fwrite(header, 1, sizeof(header), fs->file) != sizeof(header))
+            CV_Error(Error::StsError, "Can't write header of the binary storage");
+    }
+
+protected:
+    FileNode addNode(const char* key, int type, const void* value)
+    {
+        if (!rawDataNode.empty())
+            CV_Error(Error::StsNotImplemented, "Binary storage can't store raw data and other nodes in one sequence");
+        FileNode node = fs->addNode(nodes.back(), key ? std::string(key) : std::string(), type, value, -1);
+        if (FileNode::isCollection(type))
+            initCollection(node);
+        fs->setNonEmpty();
+        return node;
+    }
+
+    void initCollection(FileNode& node)
+    {
+        uchar* ptr = node.ptr() + 1 + (node.isNamed() ? 4 : 0);
+        writeInt(ptr, 4);
+        writeInt(ptr + 4, 0);
+    }
+
+    void putBytes(const void* data, size_t len)
+    {
+        CV_Assert(fs->file);
+        if (len > 0 && fwrite(data, 1, len, fs->file) != len)
+            CV_Error(Error::StsError, "Can't write data to the binary storage");
+        fileSize += len;
+    }
+
+    FileStorage::Impl* fs;
+    std::vector<FileNode> nodes;
+    uint64 fileSize;
+
+    // raw data block of the current sequence
+    FileNode rawDataNode;
+    std::string rawDataFormat;
+    uint64 rawDataOffset;
+    uint64 rawDataSize;
+};
+
+Ptr<FileStorageEmitter> createBinaryEmitter(FileStorage::Impl* fs)
+{
+    return makePtr<BinaryEmitter>(fs);
+}
+
+//////////////////////////////////////////////// Reader ////////////////////////////////////////////////
+
+bool isBinaryStorage(const std::string& filename)
+{
+    FILE* f = fopen(filename.c_str(), "rb");
+    if (!f)
+        return false;
+    char buf[sizeof(binary_signature)] = {0};
+    bool ok = fread(buf, 1, sizeof(buf), f) == sizeof(buf) && memcmp(buf, binary_signature, sizeof(buf)) == 0;
+    fclose(f);
+    return ok;
+}
+
+// The node tree is used in place, so it is checked completely before the storage is opened:
+// every node must be inside of its parent collection, names must reference the beginning of a name,
+// raw data blocks must be inside of the data area and be large enough for all elements of the sequence.
+// The functions return the offset of the next node or 0 if the node is corrupted.
+
+static size_t validateRawDataNode(const uchar* tree, size_t end, size_t ofs, size_t nelems,
+                                  uint64 dataBegin, uint64 dataEnd)
+{
+    if (end - ofs < 1 + 16 + 1)
+        return 0;
+    const uchar* p = tree + ofs;
+    const uchar* dtEnd = (const uchar*)memchr(p + 17, 0, end - ofs - 17);
+    if (!dtEnd || dtEnd == p + 17)
+        return 0;
+    uint64 dataOfs = readUInt64(p + 1), dataSize = readUInt64(p + 9);
+    if (dataOfs < dataBegin || dataOfs > dataEnd || dataSize > dataEnd - dataOfs)
+        return 0;
+
+    const char* dt = (const char*)p + 17;
+    int fmt_pairs[CV_FS_MAX_FMT_PAIRS*2];
+    int fmt_pair_count = fs::decodeFormat(dt, fmt_pairs, CV_FS_MAX_FMT_PAIRS);
+    size_t elemSize = (size_t)fs::calcStructSize(dt, 0), nscalars = 0;
+    for (int k = 0; k < fmt_pair_count; k++)
+        nscalars += fmt_pairs[k*2];
+    if (elemSize == 0 || nscalars == 0 || nelems % nscalars != 0 || nelems / nscalars > dataSize / elemSize)
+        return 0;
+    return (size_t)(dtEnd + 1 - tree);
+}
+
+static size_t validateNode(const uchar* tree, size_t end, size_t ofs, bool named,
+                           const std::vector<char>& strings, uint64 dataBegin, uint64 dataEnd, int depth)
+{
+    if (ofs >= end || depth > CV_FS_BINARY_MAX_DEPTH)
+        return 0;
+    const uchar* p = tree + ofs;
+    int tag = *p, type = tag & FileNode::TYPE_MASK;
+    if ((tag & ~(FileNode::TYPE_MASK | FileNode::NAMED)) != 0 || type > FileNode::MAP ||
+        ((tag & FileNode::NAMED) != 0) != named)
+        return 0;
+    size_t hdrSize = named ? 5 : 1;
+    if (end - ofs < hdrSize)
+        return 0;
+    if (named)
+    {
+        size_t nameofs = (size_t)(unsigned)readInt(p + 1);
+        if (nameofs == 0 || nameofs >= strings.size() || strings[nameofs - 1] != 0)
+            return 0;
+    }
+    ofs += hdrSize;
+    p += hdrSize;
+    size_t left = end - ofs;
+
+    switch (type)
+    {
+    case FileNode::NONE:
+        return ofs;
+    case FileNode::INT:
+        return left >= 4 ? ofs + 4 : 0;
+    case FileNode::REAL:
+        return left >= 8 ? ofs + 8 : 0;
+    case FileNode::STRING:
+    {
+        if (left < 4)
+            return 0;
+        size_t len = (size_t)(unsigned)readInt(p);
+        if (len == 0 || len > left - 4 || p[4 + len - 1] != 0)
+            return 0;
+        return ofs + 4 + len;
+    }
+    default:
+    {
+        if (left < 8)
+            return 0;
+        size_t rawSize = (size_t)(unsigned)readInt(p), nelems = (size_t)(unsigned)readInt(p + 4);
+        if (rawSize < 4 || rawSize > left - 4)
+            return 0;
+        size_t collectionEnd = ofs + 4 + rawSize, child = ofs + 8;
+        if (type == FileNode::SEQ && nelems > 0 && child < collectionEnd && tree[child] == CV_FS_RAW_DATA_TAG)
+            child = validateRawDataNode(tree, collectionEnd, child, nelems, dataBegin, dataEnd);
+        else
+        {
+            for (size_t i = 0; i < nelems && child != 0; i++)
+                child = validateNode(tree, collectionEnd, child, type == FileNode::MAP,
+                                     strings, dataBegin, dataEnd, depth + 1);
+        }
+        return child == collectionEnd ? collectionEnd : 0;
+    }
+    }
+}
+
+void openBinaryStorage(FileStorage::Impl* fs)
+{
+    Ptr<BinaryStorageData> data = makePtr<BinaryStorageData>();
+    if (!data->open(fs->filename))
+        CV_Error_(Error::StsError, ("Can't read binary storage '%s'", fs->filename.c_str()));
+
+    const uchar* header = data->data();
+    const uint64 size = data->size();
+    if (size < CV_FS_BINARY_HEADER_SIZE || memcmp(header, binary_signature, sizeof(binary_signature)) != 0)
+        CV_Error(Error::StsParseError, "Invalid binary storage");
+    if (memcmp(header + 16, &binary_byte_order_mark, 4) != 0)
+        CV_Error(Error::StsNotImplemented, "Binary storage has been written on the platform with other byte order");
+    if (readInt(header + 20) != CV_FS_BINARY_VERSION)
+        CV_Error_(Error::StsNotImplemented, ("Unsupported version of binary storage: %d", readInt(header + 20)));
+
+    uint64 treeOffset = readUInt64(header + 24), treeSize = readUInt64(header + 32);
+    uint64 stringsOffset = readUInt64(header + 40), stringsSize = readUInt64(header + 48);
+    // raw data blocks, node tree and names table follow each other
+    if (treeSize < 9 || treeOffset < CV_FS_BINARY_HEADER_SIZE || treeOffset > size || treeSize > size - treeOffset ||
+        stringsSize < 1 || stringsOffset < treeOffset + treeSize || stringsOffset > size ||
+        stringsSize > size - stringsOffset ||
+        header[stringsOffset] != 0 || header[stringsOffset + stringsSize - 1] != 0)
+        CV_Error(Error::StsParseError, "Binary storage is corrupted");
+
+    const char* strings = (const char*)header + stringsOffset;
+    std::vector<char> str_hash_data(strings, strings + stringsSize);
+    const uchar* tree = header + treeOffset;
+    if (tree[0] != FileNode::SEQ ||
+        validateNode(tree, (size_t)treeSize, 0, false, str_hash_data,
+                     CV_FS_BINARY_HEADER_SIZE, treeOffset, 0) != treeSize)
+        CV_Error(Error::StsParseError, "Binary storage is corrupted");
+
+    // node tree is used directly from the storage memory
+    fs->fs_data.clear();
+    fs->fs_data_ptrs.assign(1, data->data() + treeOffset);
+    fs->fs_data_blksz.assign(1, (size_t)treeSize);
+    fs->freeSpaceOfs = (size_t)treeSize;
+
+    fs->str_hash_data.swap(str_hash_data);
+    fs->str_hash.clear();
+    for (size_t ofs = 1; ofs < stringsSize;)
+    {
+        std::string key(strings + ofs);
+        fs->str_hash.insert(std::make_pair(key, (unsigned)ofs));
+        ofs += key.size() + 1;
+    }
+
+    fs->binary_data = data;
+    fs->fmt = FileStorage::FORMAT_BINARY;
+    fs->is_opened = true;
+
+    FileNode roots_node(fs, 0, 0);
+    if (!roots_node.isSeq())
+        CV_Error(Error::StsParseError, "Binary storage is corrupted");
+    size_t i, nroots = roots_node.size();
+    FileNodeIterator it = roots_node.begin();
+    for (i = 0; i < nroots; i++, ++it)
+        fs->roots.push_back(*it);
+}
+
+namespace fs {
+
+const uchar* getBinaryRawData(const FileStorage::Impl* fs, const uchar* node, size_t& size, const char*& dt)
+{
+    CV_Assert(fs && node && *node == CV_FS_RAW_DATA_TAG);
+    const uchar* data = fs->binary_data ? fs->binary_data->data() : 0;
+    uint64 ofs = readUInt64(node + 1);
+    uint64 sz = readUInt64(node + 9);
+    if (!data || ofs > fs->binary_data->size() || sz > fs->binary_data->size() - ofs)
+        CV_Error(Error::StsParseError, "Binary storage is corrupted");
+    size = (size_t)sz;
+    dt = (const char*)node + 17;
+    return data + ofs;
+}
+
+size_t getBinaryRawDataNodeSize(const uchar* node)
+{
+    CV_DbgAssert(*node == CV_FS_RAW_DATA_TAG);
+    return 1 + 16 + strlen((const char*)node + 17) + 1;
+}
+
+const uchar* getBinaryRawDataNode(const FileNode& seq)
+{
+    FileStorage::Impl* fs = seq.fs;
+    if (!fs || !fs->binary_data || !seq.isSeq() || seq.size() == 0)
+        return 0;
+
+    size_t blockIdx = seq.blockIdx, ofs = seq.ofs + 1 + (seq.isNamed() ? 4 : 0) + 8;
+    fs->normalizeNodeOfs(blockIdx, ofs);
+    const uchar* p = fs->getNodePtr(blockIdx, ofs);
+    return *p == CV_FS_RAW_DATA_TAG ? p : 0;
+}
+
+bool mapBinaryRawData(const FileNode& node, int dims, const int* sizes, int type, Mat& m)
+{
+    const uchar* p = getBinaryRawDataNode(node);
+    if (!p)
+        return false;
+    FileStorage::Impl* fs = node.fs;
+
+    size_t size = 0;
+    const char* dt = 0;
+    uchar* data = (uchar*)getBinaryRawData(fs, p, size, dt);
+
+    int fmt_pairs[CV_FS_MAX_FMT_PAIRS*2];
+    if (decodeFormat(dt, fmt_pairs, CV_FS_MAX_FMT_PAIRS) != 1 ||
+        CV_MAKETYPE(fmt_pairs[1], fmt_pairs[0]) != type)
+        return false;
+    size_t total = CV_ELEM_SIZE(type);
+    for (int i = 0; i < dims; i++)
+        total *= sizes[i];
+    if (total != size || ((size_t)data & (CV_ELEM_SIZE1(type) - 1)) != 0)
+        return false;
+
+    // matrices read from the same node share the data, see FileStorage::FORMAT_BINARY
+    BinaryStorageMatAllocator& allocator = BinaryStorageMatAllocator::getInstance();
+    m = Mat(dims, sizes, type, data);
+    UMatData* u = new UMatData(&allocator);
+    u->data = u->origdata = data;
+    u->size = size;
+    u->userdata = new Ptr<BinaryStorageData>(fs->binary_data);
+    u->refcount = 1;
+    m.u = u;
+    m.allocator = &allocator;
+    return true;
+}
+
+} // namespace fs
+
+} // namespace cv
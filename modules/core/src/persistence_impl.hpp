@@ -14,6 +14,8 @@
 namespace cv
 {
 
+class BinaryStorageData;
+
 enum Base64State{
     Uncertain,
     NotUse,
@@ -39,6 +41,8 @@ public:
 
     char* getsFromFile( char* buf, int count );
 
+    int getcFromFile();
+
     char* gets( size_t maxCount );
 
     char* gets();
@@ -97,6 +101,12 @@ public:
 
     int getFormat() const;
 
+    bool readStream( const char* filename_or_buf, FileStorageStreamHandler& handler, int maxDepth,
+                     int _flags, const char* encoding );
+
+    // passes the complete nodes after the specified collection to the stream handler
+    void streamCompleteNodes( const FileNode& collection );
+
     char* bufferPtr() const;
     char* bufferStart() const;
     char* bufferEnd() const;
@@ -237,6 +247,20 @@ public:
     str_hash_t str_hash;
     std::vector<char> str_hash_data;
 
+    Ptr<BinaryStorageData> binary_data; //!< content of the opened binary storage
+
+    // streaming reading, see FileStorage::readStream()
+    struct StreamNode
+    {
+        FileNode node;
+        std::string key;
+        int depth;
+        bool started; //!< startCollection() has been called for the node
+    };
+    FileStorageStreamHandler* stream_handler;
+    int stream_max_depth;
+    std::vector<StreamNode> stream_stack; //!< the node which is being parsed and its parents
+
     std::vector<char> strbufv;
     char* strbuf;
     size_t strbufsize;
@@ -244,6 +268,19 @@ public:
     int lineno;
 };
 
+Ptr<FileStorageEmitter> createBinaryEmitter(FileStorage::Impl* fs);
+bool isBinaryStorage(const std::string& filename);
+void openBinaryStorage(FileStorage::Impl* fs);
+
+namespace fs {
+//! returns raw data block which is referenced by the node with CV_FS_RAW_DATA_TAG tag
+const uchar* getBinaryRawData(const FileStorage::Impl* fs, const uchar* node, size_t& size, const char*& dt);
+//! size of the node with CV_FS_RAW_DATA_TAG tag
+size_t getBinaryRawDataNodeSize(const uchar* node);
+//! returns the node with CV_FS_RAW_DATA_TAG tag if the sequence elements are stored as raw data, NULL otherwise
+const uchar* getBinaryRawDataNode(const FileNode& seq);
+}
+
 }
 
 #endif
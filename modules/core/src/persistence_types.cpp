@@ -129,27 +129,34 @@ void read(const FileNode& node, Mat& m, const Mat& default_mat)
 
     elem_type = fs::decodeSimpleFormat( dt.c_str() );
 
+    int sizes[CV_MAX_DIM] = {0}, dims;
     read(node["rows"], rows, -1);
     if( rows >= 0 )
     {
         read(node["cols"], cols, -1);
-        m.create(rows, cols, elem_type);
+        dims = 2;
+        sizes[0] = rows;
+        sizes[1] = cols;
     }
     else
     {
-        int sizes[CV_MAX_DIM] = {0}, dims;
         FileNode sizes_node = node["sizes"];
         CV_Assert( !sizes_node.empty() );
 
         dims = (int)sizes_node.size();
+        CV_Assert( 0 < dims && dims <= CV_MAX_DIM );
         sizes_node.readRaw("i", sizes, dims*sizeof(sizes[0]));
-
-        m.create(dims, sizes, elem_type);
     }
 
     FileNode data_node = node["data"];
     CV_Assert(!data_node.empty());
 
+    // binary storage: matrix references the raw data without copying
+    if( fs::mapBinaryRawData(data_node, dims, sizes, elem_type, m) )
+        return;
+
+    m.create(dims, sizes, elem_type);
+
     size_t nelems = data_node.size();
     CV_Assert(nelems == m.total()*m.channels());
 
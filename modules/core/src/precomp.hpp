@@ -352,10 +352,11 @@ struct CoreTLSData
         oclExecutionContextInitialized(false), useOpenCL(-1),
 //#endif
         useIPP(-1),
-        useIPP_NE(-1)
+        useIPP_NE(-1),
 #ifdef HAVE_OPENVX
-        ,useOpenVX(-1)
+        useOpenVX(-1),
 #endif
+        parallelForDepth(0)
     {}
 
     RNG rng;
@@ -369,6 +370,7 @@ struct CoreTLSData
 #ifdef HAVE_OPENVX
     int useOpenVX; // 1 - use, 0 - do not use, -1 - auto/not initialized
 #endif
+    int parallelForDepth; // > 0 inside of parallel_for_() call or body
 };
 
 CoreTLSData& getCoreTlsData();
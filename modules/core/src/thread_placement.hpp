@@ -0,0 +1,130 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+#ifndef OPENCV_CORE_THREAD_PLACEMENT_HPP
+#define OPENCV_CORE_THREAD_PLACEMENT_HPP
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace cv {
+
+/** Placement of the thread pool threads on CPUs and NUMA nodes
+
+Worker thread with index N (1..) is placed on CPU `getCpu(N)`. CPUs of different NUMA nodes are interleaved, so any
+number of threads is spread evenly between nodes and the placement of a thread doesn't depend on the number of threads
+in the pool. The thread which calls parallel_for_() is not pinned, it works on the node of the CPU it is running on.
+*/
+class ThreadPlacement
+{
+public:
+    ThreadPlacement() {}
+
+    /// node_cpus - allowed CPUs of every NUMA node, nodes without CPUs are skipped
+    explicit ThreadPlacement(const std::vector< std::vector<int> >& node_cpus_)
+    {
+        for (size_t n = 0; n < node_cpus_.size(); n++)
+        {
+            if (!node_cpus_[n].empty())
+                node_cpus.push_back(node_cpus_[n]);
+        }
+        for (size_t i = 0, added = 1; added > 0; i++)
+        {
+            added = 0;
+            for (size_t n = 0; n < node_cpus.size(); n++)
+            {
+                if (i < node_cpus[n].size())
+                {
+                    cpus.push_back(node_cpus[n][i]);
+                    nodes.push_back((int)n);
+                    added++;
+                }
+            }
+        }
+    }
+
+    bool empty() const { return cpus.empty(); }
+
+    int getNumNodes() const { return (int)node_cpus.size(); }
+
+    int getNode(unsigned thread_idx) const
+    {
+        return cpus.empty() ? 0 : nodes[thread_idx % nodes.size()];
+    }
+
+    int getCpu(unsigned thread_idx) const
+    {
+        return cpus.empty() ? -1 : cpus[thread_idx % cpus.size()];
+    }
+
+    const std::vector<int>& getNodeCpus(int node) const
+    {
+        return node_cpus[node];
+    }
+
+    /// NUMA node of the CPU, 0 for CPUs which are not allowed for the process
+    int getCpuNode(int cpu) const
+    {
+        for (size_t i = 0; i < cpus.size(); i++)
+        {
+            if (cpus[i] == cpu)
+                return nodes[i];
+        }
+        return 0;
+    }
+
+    /** Splits range of 'size' tasks between NUMA nodes proportionally to the number of threads on them
+
+    Returns bounds of the parts, the part of node n is [bounds[n], bounds[n + 1]).
+    */
+    static std::vector<int> splitRange(int size, const std::vector<int>& node_threads)
+    {
+        int num_threads = 0;
+        for (size_t n = 0; n < node_threads.size(); n++)
+            num_threads += node_threads[n];
+        std::vector<int> bounds(node_threads.size() + 1, 0);
+        int threads_before = 0;
+        for (size_t n = 0; n < node_threads.size(); n++)
+        {
+            threads_before += node_threads[n];
+            bounds[n + 1] = num_threads > 0 ? (int)((long long)size * threads_before / num_threads) : size;
+        }
+        return bounds;
+    }
+
+    /// parses lists of CPUs and nodes from sysfs like "0-3,8,10-11", stops at the first malformed item
+    static std::vector<int> parseList(const std::string& str)
+    {
+        std::vector<int> result;
+        const char* ptr = str.c_str();
+        while (*ptr)
+        {
+            int first = 0, last = 0, len = 0;
+            if (sscanf(ptr, "%d-%d%n", &first, &last, &len) == 2 && len > 0)
+                ;
+            else if (sscanf(ptr, "%d%n", &first, &len) == 1 && len > 0)
+                last = first;
+            else
+                break;
+            if (first < 0 || last < first)
+                break;
+            for (int i = first; i <= last; i++)
+                result.push_back(i);
+            ptr += len;
+            if (*ptr != ',')
+                break;
+            ptr++;
+        }
+        return result;
+    }
+
+protected:
+    std::vector<int> cpus;  // CPU of every thread
+    std::vector<int> nodes;  // NUMA node (index in node_cpus) of every thread
+    std::vector< std::vector<int> > node_cpus;  // allowed CPUs of NUMA nodes
+};
+
+}  // namespace cv
+
+#endif  // OPENCV_CORE_THREAD_PLACEMENT_HPP
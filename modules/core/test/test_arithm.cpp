@@ -2375,6 +2375,65 @@ INSTANTIATE_TEST_CASE_P(Arithm, TransposeND, testing::Combine(
     testing::Values(perf::MatType(CV_8UC1), CV_32FC1)
 ));
 
+typedef testing::TestWithParam<perf::MatType> Transpose2D;
+
+// elements are compared bitwise, so NaNs of the floating-point types are checked too
+static Mat transposeTestBytes(const Mat& m)
+{
+    return Mat(m.rows, m.cols*(int)m.elemSize(), CV_8UC1, m.data, m.step);
+}
+
+TEST_P(Transpose2D, tiles_inplace_rotate)
+{
+    const int type = GetParam();
+    const size_t esz = CV_ELEM_SIZE(type);
+    const Size sizes[] = { Size(1000, 333), Size(17, 1500), Size(257, 257), Size(64, 64), Size(33, 18), Size(5, 3) };
+    for (size_t k = 0; k < sizeof(sizes)/sizeof(sizes[0]); k++)
+    {
+        const Size sz = sizes[k];
+        SCOPED_TRACE(cv::format("size=%dx%d", sz.width, sz.height));
+        Mat big(sz.height + 2, sz.width + 3, type);
+        Mat bigBytes = transposeTestBytes(big);
+        randu(bigBytes, Scalar::all(0), Scalar::all(256));
+        Mat src = big(Rect(Point(1, 1), sz)); // non-continuous
+        Mat ref(sz.width, sz.height, type);
+        for (int y = 0; y < sz.height; y++)
+            for (int x = 0; x < sz.width; x++)
+                memcpy(ref.ptr(x) + y*esz, src.ptr(y) + x*esz, esz);
+
+        Mat dst, expected;
+        cv::transpose(src, dst);
+        EXPECT_EQ(0, cvtest::norm(transposeTestBytes(ref), transposeTestBytes(dst), NORM_INF));
+
+        cv::rotate(src, dst, ROTATE_90_CLOCKWISE);
+        cv::flip(ref, expected, 1);
+        EXPECT_EQ(0, cvtest::norm(transposeTestBytes(expected), transposeTestBytes(dst), NORM_INF));
+
+        cv::rotate(src, dst, ROTATE_90_COUNTERCLOCKWISE);
+        cv::flip(ref, expected, 0);
+        EXPECT_EQ(0, cvtest::norm(transposeTestBytes(expected), transposeTestBytes(dst), NORM_INF));
+
+        if (sz.width == sz.height)
+        {
+            Mat inplace = src.clone();
+            cv::transpose(inplace, inplace);
+            EXPECT_EQ(0, cvtest::norm(transposeTestBytes(ref), transposeTestBytes(inplace), NORM_INF));
+
+            inplace = src.clone();
+            uchar* data = inplace.data;
+            cv::rotate(inplace, inplace, ROTATE_90_CLOCKWISE);
+            EXPECT_EQ(data, inplace.data);
+            cv::flip(ref, expected, 1);
+            EXPECT_EQ(0, cvtest::norm(transposeTestBytes(expected), transposeTestBytes(inplace), NORM_INF));
+        }
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(Arithm, Transpose2D, testing::Values(
+    perf::MatType(CV_8UC1), CV_8UC2, CV_8UC3, CV_8SC3, CV_8UC4, CV_16UC1, CV_16SC3, CV_16UC4,
+    CV_32SC1, CV_32SC2, CV_32FC2, CV_32FC3, CV_64FC1, CV_64FC4
+));
+
 class FlipND : public testing::TestWithParam< tuple<std::vector<int>, perf::MatType> >
 {
 public:
@@ -1985,4 +1985,269 @@ INSTANTIATE_TEST_CASE_P( /*nothing*/,
     Core_InputOutput_regression_25073,
     Values("test.json", "test.xml", "test.yml") );
 
+TEST(Core_InputOutput, FileStorage_binary)
+{
+    const std::string fname = cv::tempfile(".bin");
+    RNG& rng = theRNG();
+    Mat m32f(7, 11, CV_32FC3), big(40, 50, CV_8UC1), m16s;
+    rng.fill(m32f, RNG::UNIFORM, -100, 100);
+    rng.fill(big, RNG::UNIFORM, 0, 256);
+    Mat roi = big(Rect(3, 5, 17, 9));
+    const int sizes[] = { 3, 4, 5 };
+    m16s.create(3, sizes, CV_16S);
+    rng.fill(m16s, RNG::UNIFORM, -1000, 1000);
+    std::vector<int> ivec;
+    for (int i = 0; i < 100; i++)
+        ivec.push_back(i*i - 50);
+
+    {
+        FileStorage fs(fname, FileStorage::WRITE | FileStorage::FORMAT_BINARY);
+        ASSERT_TRUE(fs.isOpened());
+        fs << "name" << "binary storage";
+        fs << "pi" << CV_PI;
+        fs << "m32f" << m32f;
+        fs << "roi" << roi;
+        fs << "m16s" << m16s;
+        fs << "ivec" << ivec;
+        fs << "mixed" << "[" << 1 << 2.5 << "text" << "]";
+        fs << "map" << "{" << "a" << 5 << "b" << "[:" << 1 << 2 << 3 << "]" << "}";
+    }
+
+    Mat m;
+    {
+        FileStorage fs(fname, FileStorage::READ);
+        ASSERT_TRUE(fs.isOpened());
+        EXPECT_EQ(FileStorage::FORMAT_BINARY, fs.getFormat());
+        EXPECT_EQ("binary storage", (std::string)fs["name"]);
+        EXPECT_EQ(CV_PI, (double)fs["pi"]);
+
+        fs["m32f"] >> m;
+        EXPECT_EQ(0, cvtest::norm(m, m32f, NORM_INF));
+        // data is referenced without copying
+        Mat m2 = fs["m32f"].mat();
+        EXPECT_EQ(m.data, m2.data);
+
+        EXPECT_EQ(0, cvtest::norm(fs["roi"].mat(), roi, NORM_INF));
+        Mat r16s = fs["m16s"].mat();
+        ASSERT_EQ(3, r16s.dims);
+        EXPECT_EQ(0, cvtest::norm(r16s, m16s, NORM_INF));
+
+        std::vector<int> ivec2;
+        fs["ivec"] >> ivec2;
+        EXPECT_EQ(ivec, ivec2);
+        std::vector<double> dvec;
+        fs["ivec"] >> dvec;
+        ASSERT_EQ(ivec.size(), dvec.size());
+        for (size_t i = 0; i < ivec.size(); i++)
+            EXPECT_EQ((double)ivec[i], dvec[i]);
+        EXPECT_ANY_THROW((int)fs["ivec"][0]);
+
+        FileNode mixed = fs["mixed"];
+        ASSERT_EQ(3u, mixed.size());
+        EXPECT_EQ(1, (int)mixed[0]);
+        EXPECT_EQ(2.5, (double)mixed[1]);
+        EXPECT_EQ("text", (std::string)mixed[2]);
+
+        FileNode map = fs["map"];
+        EXPECT_EQ(5, (int)map["a"]);
+        std::vector<int> b;
+        map["b"] >> b;
+        ASSERT_EQ(3u, b.size());
+        EXPECT_EQ(3, b[2]);
+    }
+
+    // matrix outlives the storage, its modification doesn't change the file
+    Mat expected = m.clone();
+    m.setTo(Scalar::all(0));
+    {
+        FileStorage fs(fname, FileStorage::READ);
+        EXPECT_EQ(0, cvtest::norm(fs["m32f"].mat(), expected, NORM_INF));
+    }
+    EXPECT_EQ(0, remove(fname.c_str()));
+}
+
+namespace {
+struct StreamEventLog CV_FINAL : public FileStorageStreamHandler
+{
+    void startCollection(const String& key, int type, int depth) CV_OVERRIDE
+    {
+        log << depth << ":" << key << (type == FileNode::MAP ? "{" : "[") << " ";
+    }
+    void endCollection(const String& /*key*/, int type, int /*depth*/) CV_OVERRIDE
+    {
+        log << (type == FileNode::MAP ? "}" : "]") << " ";
+    }
+    void node(const String& key, const FileNode& node, int depth) CV_OVERRIDE
+    {
+        log << depth << ":" << key << "=";
+        if (node.isInt())
+            log << (int)node;
+        else if (node.isString())
+            log << (std::string)node;
+        else
+        {
+            log << "#" << node.size();
+            if (node.isMap() && !node["mat"].empty())
+                mats.push_back(node["mat"].mat());
+        }
+        log << " ";
+    }
+    std::ostringstream log;
+    std::vector<Mat> mats;
+};
+}
+
+TEST(Core_InputOutput, FileStorage_readStream)
+{
+    Mat m1(5, 7, CV_32FC2), m2(3, 4, CV_8U);
+    randu(m1, -10, 10);
+    randu(m2, 0, 256);
+    const char* exts[] = { ".yml", ".xml", ".json", ".bin" };
+    for (size_t i = 0; i < sizeof(exts)/sizeof(exts[0]); i++)
+    {
+        SCOPED_TRACE(exts[i]);
+        const std::string fname = cv::tempfile(exts[i]);
+        {
+            FileStorage fs(fname, FileStorage::WRITE | (i == 3 ? FileStorage::FORMAT_BINARY : 0));
+            fs << "version" << 2;
+            fs << "images" << "[";
+            fs << "{" << "id" << 1 << "mat" << m1 << "}";
+            fs << "{" << "id" << 2 << "mat" << m2 << "}";
+            fs << "]";
+            fs << "ids" << "[:" << 5 << 6 << 7 << "]";
+            fs << "name" << "test";
+        }
+        StreamEventLog handler;
+        ASSERT_TRUE(FileStorage::readStream(fname, handler, 2));
+        EXPECT_EQ("0:{ 1:version=2 1:images[ 2:=#2 2:=#2 ] 1:ids[ 2:=5 2:=6 2:=7 ] 1:name=test } ",
+                  handler.log.str());
+        ASSERT_EQ(2u, handler.mats.size());
+        EXPECT_EQ(0, cvtest::norm(handler.mats[0], m1, NORM_INF));
+        EXPECT_EQ(0, cvtest::norm(handler.mats[1], m2, NORM_INF));
+
+        StreamEventLog handler0;
+        ASSERT_TRUE(FileStorage::readStream(fname, handler0, 0));
+        EXPECT_EQ("0:=#4 ", handler0.log.str());
+        EXPECT_EQ(0, remove(fname.c_str()));
+    }
+}
+
+TEST(Core_InputOutput, FileStorage_readStream_long_json_line)
+{
+    // elements are split by the chunks of the reader, the strings contain the split characters
+    const int N = 20000;
+    std::string json = "{\"items\":[";
+    for (int i = 0; i < N; i++)
+        json += format("%s{\"id\":%d,\"name\":\"a,b{c[d\\\"%d\"}", i > 0 ? "," : "", i, i);
+    json += "],\"count\":" + format("%d", N) + "}";
+    ASSERT_GT(json.size(), (size_t)1 << 16);
+
+    struct Handler CV_FINAL : public FileStorageStreamHandler
+    {
+        Handler() : count(0), ok(true), total(-1) {}
+        void node(const String& key, const FileNode& node, int depth) CV_OVERRIDE
+        {
+            if (depth == 1)
+            {
+                total = (int)node;
+                return;
+            }
+            ok = ok && key.empty() && (int)node["id"] == count &&
+                (std::string)node["name"] == format("a,b{c[d\"%d", count);
+            count++;
+        }
+        int count;
+        bool ok;
+        int total;
+    };
+
+    const std::string fname = cv::tempfile(".json");
+    {
+        std::ofstream f(fname.c_str());
+        f << json;
+    }
+    Handler h1, h2;
+    ASSERT_TRUE(FileStorage::readStream(fname, h1, 2));
+    EXPECT_TRUE(h1.ok);
+    EXPECT_EQ(N, h1.count);
+    EXPECT_EQ(N, h1.total);
+    ASSERT_TRUE(FileStorage::readStream(json, h2, 2, FileStorage::READ | FileStorage::MEMORY));
+    EXPECT_TRUE(h2.ok);
+    EXPECT_EQ(N, h2.count);
+    EXPECT_EQ(0, remove(fname.c_str()));
+}
+
+static void readAllNodes(const FileNode& node)
+{
+    if (node.isSeq() || node.isMap())
+    {
+        Mat m;
+        node >> m;
+        std::vector<double> values;
+        node >> values;
+        for (FileNodeIterator it = node.begin(); it != node.end(); ++it)
+            readAllNodes(*it);
+    }
+    else
+    {
+        (void)node.name();
+        (void)node.string();
+        (void)node.real();
+    }
+}
+
+TEST(Core_InputOutput, FileStorage_binary_corrupted)
+{
+    const std::string fname = cv::tempfile(".bin");
+    {
+        FileStorage fs(fname, FileStorage::WRITE | FileStorage::FORMAT_BINARY);
+        ASSERT_TRUE(fs.isOpened());
+        fs << "m" << Mat(3, 4, CV_32SC2, Scalar(1, 2));
+        fs << "ivec" << std::vector<int>(5, 7);
+        fs << "map" << "{" << "s" << "text" << "x" << 1.5 << "seq" << "[" << 1 << "]" << "}";
+    }
+    std::vector<uchar> content;
+    {
+        std::ifstream f(fname.c_str(), std::ios::in | std::ios::binary);
+        content.assign(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+    }
+    ASSERT_GT(content.size(), 64u);
+    size_t treeOffset = 0;
+    memcpy(&treeOffset, &content[24], sizeof(int));
+
+    // every byte of the node tree and names is damaged, the storage must be rejected or read without crashes
+    const uchar values[] = { 0, 1, 0x7f, 0xff };
+    for (size_t i = treeOffset; i < content.size(); i++)
+    {
+        for (size_t k = 0; k < sizeof(values); k++)
+        {
+            if (content[i] == values[k])
+                continue;
+            std::vector<uchar> damaged = content;
+            damaged[i] = values[k];
+            {
+                std::ofstream f(fname.c_str(), std::ios::out | std::ios::binary);
+                f.write((const char*)&damaged[0], damaged.size());
+            }
+            try
+            {
+                FileStorage fs(fname, FileStorage::READ);
+                readAllNodes(fs.root());
+            }
+            catch (const cv::Exception&)
+            {
+                // expected for most of the damaged files
+            }
+        }
+    }
+
+    // truncated storage
+    {
+        std::ofstream f(fname.c_str(), std::ios::out | std::ios::binary);
+        f.write((const char*)&content[0], content.size() - 1);
+    }
+    EXPECT_THROW(FileStorage(fname, FileStorage::READ), cv::Exception);
+    EXPECT_EQ(0, remove(fname.c_str()));
+}
+
 }} // namespace
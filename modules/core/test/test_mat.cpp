@@ -10,6 +10,9 @@
 #endif
 
 #include "opencv2/core/cuda.hpp"
+#include "opencv2/core/utils/arena_allocator.hpp"
+
+#include <thread>
 
 namespace opencv_test { namespace {
 
@@ -2244,6 +2247,91 @@ TEST(Core_MatExpr, issue_16689)
     }
 }
 
+typedef testing::TestWithParam<cvtest::MatDepth> Core_MatExpr_Fused;
+
+TEST_P(Core_MatExpr_Fused, elementwise_chains)
+{
+    const int depth = GetParam();
+    const Size sz(127, 61);  // not aligned to SIMD width
+    Mat a(sz, depth), b(sz, depth), c(sz, depth);
+    RNG& rng = theRNG();
+    rng.fill(a, RNG::UNIFORM, 0, 200);
+    rng.fill(b, RNG::UNIFORM, 0, 200);
+    rng.fill(c, RNG::UNIFORM, 0, 200);
+
+    // references are computed by the generic path: the sum of two operands is stored into a matrix first
+    {
+        MatExpr e = a + b - c;
+        EXPECT_EQ(depth, e.type());
+        EXPECT_FALSE(e.c.empty()) << "fused expression is expected";
+        Mat r = e, ab = a + b, ref = ab - c;
+        EXPECT_EQ(0, cvtest::norm(r, ref, NORM_INF));
+
+        Mat_<float> rf = e;  // conversion is applied to the result
+        EXPECT_EQ(0, cvtest::norm(rf, Mat_<float>(ref), NORM_INF));
+    }
+    {
+        Mat r = a*0.5 + b*0.25 - c*0.125 + 3, ab = a*0.5 + b*0.25, ref = ab - c*0.125 + 3;
+        EXPECT_EQ(0, cvtest::norm(r, ref, NORM_INF));
+    }
+    {
+        Mat r = 10 - (a - b - c*2), ab = a - b, ref = 10 - (ab - c*2);
+        EXPECT_EQ(0, cvtest::norm(r, ref, NORM_INF));
+    }
+    {
+        Mat r = c - (a - b), ab = a - b, ref = c - ab;
+        EXPECT_EQ(0, cvtest::norm(r, ref, NORM_INF));
+    }
+    {
+        // scalar factors and abs() are applied to the sum as the generic path does
+        Mat ab = a + b, r1 = (a + b - c)*0.5, ref1 = (ab - c)*0.5;
+        EXPECT_EQ(0, cvtest::norm(r1, ref1, NORM_INF));
+        Mat r2 = -(a + b - c), ref2 = -(ab - c);
+        EXPECT_EQ(0, cvtest::norm(r2, ref2, NORM_INF));
+        Mat r3 = abs(a + b - c), ref3 = abs(ab - c);
+        EXPECT_EQ(0, cvtest::norm(r3, ref3, NORM_INF));
+    }
+    {
+        MatExpr e = abs(a - b) > 20;
+        EXPECT_EQ(CV_8UC1, e.type());
+        Mat r = e, d, ref;
+        absdiff(a, b, d);
+        cv::compare(d, 20, ref, CMP_GT);
+        EXPECT_EQ(0, cvtest::norm(r, ref, NORM_INF));
+    }
+    {
+        Mat r = (a*0.5 + b*0.5) >= 100.5, s, ref;
+        addWeighted(a, 0.5, b, 0.5, 0, s);
+        cv::compare(s, 100.5, ref, CMP_GE);
+        EXPECT_EQ(0, cvtest::norm(r, ref, NORM_INF));
+    }
+    {
+        Mat r = 50 < a + b - c, ab = a + b, s = ab - c, ref;
+        cv::compare(s, 50, ref, CMP_GT);
+        EXPECT_EQ(0, cvtest::norm(r, ref, NORM_INF));
+    }
+}
+
+TEST(Core_MatExpr, fused_saturation_8u)
+{
+    const Size sz(67, 3);
+    Mat a(sz, CV_8UC1, Scalar::all(200)), b(sz, CV_8UC1, Scalar::all(200)), c(sz, CV_8UC1, Scalar::all(150));
+    // intermediate sums are saturated as without fusion: 200 + 200 -> 255
+    Mat r = a + b - c;
+    EXPECT_EQ(0, cvtest::norm(r, Mat(sz, CV_8UC1, Scalar::all(105)), NORM_INF));
+    r = (a + b - c) > 200;
+    EXPECT_EQ(0, cvtest::norm(r, NORM_INF));
+    // 150 - 200 -> 0
+    r = c - a + b;
+    EXPECT_EQ(0, cvtest::norm(r, Mat(sz, CV_8UC1, Scalar::all(200)), NORM_INF));
+    r = b - (c - a);
+    EXPECT_EQ(0, cvtest::norm(r, a, NORM_INF));
+    Mat_<float> rf = a + b - c;
+    EXPECT_EQ(0, cvtest::norm(rf, Mat(sz, CV_32FC1, Scalar::all(105)), NORM_INF));
+}
+
+INSTANTIATE_TEST_CASE_P(/**/, Core_MatExpr_Fused, testing::Values(CV_8U, CV_8S, CV_16U, CV_16S, CV_32F));
+
 #ifdef HAVE_EIGEN
 TEST(Core_Eigen, eigen2cv_check_Mat_type)
 {
@@ -2598,4 +2686,77 @@ TEST(Mat, Recreate1DMatWithSameMeta)
     EXPECT_NO_THROW(m.create(dims, depth));
 }
 
+TEST(Mat, ArenaAllocator)
+{
+    cv::utils::AllocatorStatisticsInterface& stats = cv::utils::getArenaAllocatorStatistics();
+    cv::utils::releaseArenaAllocatorCache();
+    MatAllocator* defaultAllocator = Mat::getDefaultAllocator();
+    {
+        cv::utils::ArenaAllocatorScope scope;
+        EXPECT_EQ(cv::utils::getArenaAllocator(), Mat::getDefaultAllocator());
+
+        const uint64_t allocations = stats.getNumberOfAllocations();
+        for (int i = 0; i < 100; i++)
+        {
+            Mat m(64, 64 + i % 8, CV_8UC3, Scalar::all(i));
+            EXPECT_EQ(cv::utils::getArenaAllocator(), m.u->currAllocator);
+            EXPECT_EQ(0u, (size_t)m.data % CV_MALLOC_ALIGN);
+            EXPECT_EQ(i, cvtest::norm(m, NORM_INF));
+        }
+        // all matrices fit the same size class, the block is reused
+        EXPECT_EQ(allocations + 1, stats.getNumberOfAllocations());
+
+        // matrix released by another thread is cached by that thread
+        Mat m(100, 100, CV_32FC1, Scalar::all(1));
+        std::thread t([&]() { m.release(); });
+        t.join();
+        Mat big(5000, 5000, CV_32FC1);  // isn't cached
+        big.release();
+        EXPECT_GT(stats.getCurrentUsage(), 0u);
+    }
+    EXPECT_EQ(defaultAllocator, Mat::getDefaultAllocator());
+    cv::utils::releaseArenaAllocatorCache();
+    EXPECT_EQ(0u, stats.getCurrentUsage());
+}
+
+TEST(Mat, StdBufferPool)
+{
+    BufferPoolController* c = Mat::getStdAllocator()->getBufferPoolController();
+    ASSERT_TRUE(c != NULL);
+    const size_t oldMaxReservedSize = c->getMaxReservedSize();
+    c->freeAllReservedBuffers();
+    c->setMaxReservedSize(64 << 20);
+    c->resetStatistics();
+
+    const Size sz(640, 480);
+    for (int i = 0; i < 10; i++)
+    {
+        Mat frame(sz, CV_8UC3, Scalar::all(i));
+        EXPECT_EQ(i, cvtest::norm(frame, NORM_INF));
+    }
+    BufferPoolStatistics stats = c->getStatistics();
+    EXPECT_EQ(1u, stats.misses);
+    EXPECT_EQ(9u, stats.hits);
+    EXPECT_GE(c->getReservedSize(), sz.area() * 3u);
+
+    {
+        Mat small(2, 2, CV_8UC1);  // isn't pooled
+        Mat big(4000, 4000, CV_8UC1);  // larger than 1/8 of the limit
+    }
+    stats = c->getStatistics();
+    EXPECT_EQ(1u, stats.misses);
+
+    c->setMaxReservedSize(sz.area() * 3 * 8 - 1);  // frame buffer doesn't fit anymore
+    EXPECT_EQ(0u, c->getReservedSize());
+
+    c->setMaxReservedSize(64 << 20);
+    { Mat frame(sz, CV_8UC3); }
+    EXPECT_GT(c->getReservedSize(), 0u);
+    c->freeAllReservedBuffers();
+    EXPECT_EQ(0u, c->getReservedSize());
+
+    c->setMaxReservedSize(oldMaxReservedSize);
+    c->resetStatistics();
+}
+
 }} // namespace
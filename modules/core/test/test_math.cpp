@@ -2788,6 +2788,37 @@ TEST(Core_SVD, flt)
     EXPECT_LE(cvtest::norm(B1, B, NORM_L2 + NORM_RELATIVE), FLT_EPSILON*10);
 }
 
+typedef testing::TestWithParam<tuple<perf::MatType, int> > Core_GEMM_Large;
+
+TEST_P(Core_GEMM_Large, accuracy)
+{
+    const int type = get<0>(GetParam()), flags = get<1>(GetParam());
+    const int m = 157, n = 301, len = 283; // not multiples of the packing block sizes
+    RNG& rng = theRNG();
+
+    Mat A = (flags & GEMM_1_T) ? Mat(len, m, type) : Mat(m, len, type);
+    Mat B = (flags & GEMM_2_T) ? Mat(n, len, type) : Mat(len, n, type);
+    Mat C = (flags & GEMM_3_T) ? Mat(n, m, type) : Mat(m, n, type);
+    rng.fill(A, RNG::UNIFORM, -1, 1);
+    rng.fill(B, RNG::UNIFORM, -1, 1);
+    rng.fill(C, RNG::UNIFORM, -1, 1);
+
+    Mat D, ref;
+    cv::gemm(A, B, 0.5, C, -2., D, flags);
+    cvtest::gemm(A, B, 0.5, C, -2., ref, flags);
+    double eps = type == CV_32F ? 1e-4 : 1e-10;
+    EXPECT_LE(cvtest::norm(D, ref, NORM_INF), eps);
+
+    cv::gemm(A, B, 1., noArray(), 0., D, flags & (GEMM_1_T | GEMM_2_T));
+    cvtest::gemm(A, B, 1., Mat(), 0., ref, flags & (GEMM_1_T | GEMM_2_T));
+    EXPECT_LE(cvtest::norm(D, ref, NORM_INF), eps);
+}
+
+INSTANTIATE_TEST_CASE_P(/**/, Core_GEMM_Large, testing::Combine(
+    testing::Values(CV_32F, CV_64F),
+    testing::Range(0, 8)
+));
+
 
 // TODO: eigenvv, invsqrt, cbrt, fastarctan, (round, floor, ceil(?)),
 
@@ -7,8 +7,14 @@
 #include "opencv2/core/utils/logger.hpp"
 
 #include <opencv2/core/utils/fp_control_utils.hpp>
+#include <opencv2/core/parallel/parallel_backend.hpp>
 
+#include "../src/parallel_impl.hpp"
+#include "../src/thread_placement.hpp"
+
+#include <atomic>
 #include <chrono>
+#include <mutex>
 #include <thread>
 
 namespace opencv_test { namespace {
@@ -304,6 +310,257 @@ TEST(Core_Parallel, propagate_fp_denormals_ignore_hint)
     }
 }
 
+class NestedParallelLoopBody : public cv::ParallelLoopBody
+{
+public:
+    NestedParallelLoopBody(std::vector<std::atomic<int> >& hits, int inner)
+        : hits_(hits), inner_(inner), innerCalls(0)
+    {}
+    void operator()(const cv::Range& r) const CV_OVERRIDE
+    {
+        for (int i = r.start; i < r.end; i++)
+        {
+            parallel_for_(cv::Range(0, inner_), [&](const cv::Range& ir) {
+                innerCalls++;
+                for (int j = ir.start; j < ir.end; j++)
+                    hits_[i * inner_ + j]++;
+            });
+        }
+    }
+
+    std::vector<std::atomic<int> >& hits_;
+    int inner_;
+    mutable std::atomic<int> innerCalls;
+};
+
+TEST(Core_Parallel, workstealing_backend_nested_and_concurrent)
+{
+    if (!cv::parallel::setParallelForBackend("WORKSTEALING"))
+        throw SkipTestException("WORKSTEALING parallel backend is not available");
+    const int prevThreads = cv::getNumThreads();
+    cv::setNumThreads(4);
+
+    const int outer = 16, inner = 32, callers = 3;
+    std::vector<std::atomic<int> > hits(callers * outer * inner);
+    for (size_t i = 0; i < hits.size(); i++)
+        hits[i] = 0;
+
+    std::vector<std::thread> threads;
+    std::atomic<int> nestedStripes(0);
+    for (int t = 0; t < callers; t++)
+    {
+        threads.push_back(std::thread([&, t]() {
+            std::vector<std::atomic<int> > local(outer * inner);
+            for (size_t i = 0; i < local.size(); i++)
+                local[i] = 0;
+            NestedParallelLoopBody body(local, inner);
+            parallel_for_(cv::Range(0, outer), body);
+            for (size_t i = 0; i < local.size(); i++)
+                hits[t * outer * inner + i] = local[i].load();
+            nestedStripes += body.innerCalls.load();
+        }));
+    }
+    for (size_t t = 0; t < threads.size(); t++)
+        threads[t].join();
+
+    for (size_t i = 0; i < hits.size(); i++)
+        ASSERT_EQ(1, hits[i].load()) << i;
+    // nested calls are split into stripes instead of running the whole range at once
+    EXPECT_GT(nestedStripes.load(), callers * outer);
+
+    Mat dst(1000, 100, CV_8SC1, Scalar::all(0));
+    EXPECT_THROW(parallel_for_(cv::Range(0, dst.rows), ThrowErrorParallelLoopBody(dst, dst.rows / 2)), cv::Exception);
+
+    cv::parallel::setParallelForBackend(std::string());
+    cv::setNumThreads(prevThreads);
+}
+
+TEST(Core_Parallel, workstealing_backend_nested_under_lock)
+{
+    if (!cv::parallel::setParallelForBackend("WORKSTEALING"))
+        throw SkipTestException("WORKSTEALING parallel backend is not available");
+    const int prevThreads = cv::getNumThreads();
+    cv::setNumThreads(4);
+
+    // a thread waiting for the nested call must not pick up a sibling stripe which locks the same mutex
+    const int outer = 64, inner = 16;
+    std::mutex mutex;
+    std::atomic<int> done(0);
+    parallel_for_(cv::Range(0, outer), [&](const cv::Range& r) {
+        for (int i = r.start; i < r.end; i++)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            parallel_for_(cv::Range(0, inner), [&](const cv::Range& ir) {
+                done += ir.size();
+            });
+        }
+    });
+    EXPECT_EQ(outer * inner, done.load());
+
+    cv::parallel::setParallelForBackend(std::string());
+    cv::setNumThreads(prevThreads);
+}
+
+TEST(Core_Parallel, concurrent_calls_and_counters)
+{
+    const int prevThreads = cv::getNumThreads();
+    cv::setNumThreads(4);
+    cv::resetParallelForCounters();
+
+    const int size = 1000, callers = 3, iterations = 20;
+    std::vector<std::thread> threads;
+    std::atomic<int> errors(0);
+    for (int t = 0; t < callers; t++)
+    {
+        threads.push_back(std::thread([&, t]() {
+            std::vector<int> data(size);
+            for (int it = 0; it < iterations; it++)
+            {
+                parallel_for_(cv::Range(0, size), [&](const cv::Range& r) {
+                    for (int i = r.start; i < r.end; i++)
+                        data[i] = i * t + it;
+                });
+                for (int i = 0; i < size; i++)
+                    if (data[i] != i * t + it)
+                        errors++;
+            }
+        }));
+    }
+    for (size_t t = 0; t < threads.size(); t++)
+        threads[t].join();
+    EXPECT_EQ(0, errors.load());
+
+    cv::ParallelForCounters counters = cv::getParallelForCounters();
+    EXPECT_EQ(callers * iterations, counters.calls);
+    EXPECT_EQ(counters.calls, counters.parallel + counters.nested + counters.serial);
+    EXPECT_EQ(0, counters.nested);
+
+    if (cv::getNumThreads() > 1)
+    {
+        // both calls must be inside the pool at the same time: every stripe waits for the other call
+        const int stripes = 4;
+        std::atomic<int> started(0), overlapped(0);
+        threads.clear();
+        for (int t = 0; t < 2; t++)
+        {
+            threads.push_back(std::thread([&]() {
+                std::atomic<bool> first(true);
+                parallel_for_(cv::Range(0, stripes), [&](const cv::Range&) {
+                    if (first.exchange(false))
+                        started++;
+                    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+                    while (started.load() < 2 && std::chrono::steady_clock::now() < deadline)
+                        std::this_thread::yield();
+                    if (started.load() == 2)
+                        overlapped++;
+                });
+            }));
+        }
+        for (size_t t = 0; t < threads.size(); t++)
+            threads[t].join();
+        EXPECT_EQ(2 * stripes, overlapped.load());
+    }
+
+    cv::resetParallelForCounters();
+    const int outer = 4, inner = 8;
+    std::vector<std::atomic<int> > hits(outer * inner);
+    for (size_t i = 0; i < hits.size(); i++)
+        hits[i] = 0;
+    NestedParallelLoopBody body(hits, inner);
+    parallel_for_(cv::Range(0, outer), body);
+    for (size_t i = 0; i < hits.size(); i++)
+        ASSERT_EQ(1, hits[i].load()) << i;
+    counters = cv::getParallelForCounters();
+    EXPECT_EQ(1 + outer, counters.calls);
+    EXPECT_EQ(outer, counters.nested);
+
+    cv::resetParallelForCounters();
+    counters = cv::getParallelForCounters();
+    EXPECT_EQ(0, counters.calls);
+    cv::setNumThreads(prevThreads);
+}
+
+TEST(Core_Parallel, thread_placement)
+{
+    typedef std::vector<int> V;
+    EXPECT_EQ(V({0, 1, 2, 3, 8, 10, 11}), ThreadPlacement::parseList("0-3,8,10-11"));
+    EXPECT_EQ(V({5}), ThreadPlacement::parseList("5"));
+    EXPECT_EQ(V(), ThreadPlacement::parseList(""));
+    // malformed items end the list
+    EXPECT_EQ(V({0, 1}), ThreadPlacement::parseList("0-1,x,4"));
+    EXPECT_EQ(V({0}), ThreadPlacement::parseList("0,"));
+    EXPECT_EQ(V(), ThreadPlacement::parseList("3-1"));
+    EXPECT_EQ(V(), ThreadPlacement::parseList("-2"));
+
+    // CPUs of nodes are interleaved, so threads are spread between nodes for any pool size
+    std::vector<V> node_cpus;
+    node_cpus.push_back(V({0, 1, 2, 3}));
+    node_cpus.push_back(V({4, 5}));
+    ThreadPlacement placement(node_cpus);
+    ASSERT_EQ(2, placement.getNumNodes());
+    const int cpus[] = { 0, 4, 1, 5, 2, 3 };
+    const int nodes[] = { 0, 1, 0, 1, 0, 0 };
+    for (unsigned i = 0; i < 12; i++)
+    {
+        EXPECT_EQ(cpus[i % 6], placement.getCpu(i)) << i;
+        EXPECT_EQ(nodes[i % 6], placement.getNode(i)) << i;
+    }
+    EXPECT_EQ(1, placement.getCpuNode(5));
+    EXPECT_EQ(0, placement.getCpuNode(2));
+    EXPECT_EQ(0, placement.getCpuNode(100));
+
+    // nodes without allowed CPUs are skipped
+    node_cpus[0].clear();
+    ThreadPlacement single(node_cpus);
+    EXPECT_EQ(1, single.getNumNodes());
+    EXPECT_EQ(0, single.getNode(3));
+    EXPECT_EQ(5, single.getCpu(3));
+    EXPECT_TRUE(ThreadPlacement().empty());
+    EXPECT_EQ(0, ThreadPlacement().getNode(3));
+
+    // parts of nodes are proportional to their threads
+    EXPECT_EQ(V({0, 7, 10}), ThreadPlacement::splitRange(10, V({3, 1})));
+    EXPECT_EQ(V({0, 0, 5}), ThreadPlacement::splitRange(5, V({0, 2})));
+    EXPECT_EQ(V({0, 1, 2, 3}), ThreadPlacement::splitRange(3, V({1, 1, 1})));
+}
+
+TEST(Core_Parallel, numa_partitioning)
+{
+    const char* framework = cv::currentParallelFramework();
+    if (!framework || std::string(framework) != "pthreads")
+        throw SkipTestException("pthreads thread pool is not used");
+    const int prevThreads = cv::getNumThreads();
+    cv::setNumThreads(4);
+
+    std::vector< std::vector<int> > node_cpus(3);
+    node_cpus[0].push_back(0);
+    node_cpus[1].push_back(1);
+    node_cpus[2].push_back(2);
+    node_cpus[2].push_back(3);
+    cv::details::setThreadPoolNumaNodes(node_cpus);
+
+    const int sizes[] = { 2, 3, 5, 64, 1000 };
+    const double nstripes[] = { -1, 2, 7 };
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+    {
+        for (size_t j = 0; j < sizeof(nstripes) / sizeof(nstripes[0]); j++)
+        {
+            std::vector<std::atomic<int> > hits(sizes[i]);
+            for (size_t k = 0; k < hits.size(); k++)
+                hits[k] = 0;
+            parallel_for_(cv::Range(0, sizes[i]), [&](const cv::Range& r) {
+                for (int k = r.start; k < r.end; k++)
+                    hits[k]++;
+            }, nstripes[j]);
+            for (size_t k = 0; k < hits.size(); k++)
+                ASSERT_EQ(1, hits[k].load()) << "size=" << sizes[i] << " nstripes=" << nstripes[j] << " i=" << k;
+        }
+    }
+
+    cv::details::setThreadPoolNumaNodes(std::vector< std::vector<int> >());
+    cv::setNumThreads(prevThreads);
+}
+
 TEST(Core_Version, consistency)
 {
     // this test verifies that OpenCV version loaded in runtime
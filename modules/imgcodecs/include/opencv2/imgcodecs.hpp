@@ -44,6 +44,7 @@
 #define OPENCV_IMGCODECS_HPP
 
 #include "opencv2/core.hpp"
+#include "opencv2/core/async.hpp"
 
 /**
   @defgroup imgcodecs Image file reading and writing
@@ -78,7 +79,9 @@ enum ImreadModes {
        IMREAD_REDUCED_COLOR_4      = 33, //!< If set, always convert image to the 3 channel BGR color image and the image size reduced 1/4.
        IMREAD_REDUCED_GRAYSCALE_8  = 64, //!< If set, always convert image to the single channel grayscale image and the image size reduced 1/8.
        IMREAD_REDUCED_COLOR_8      = 65, //!< If set, always convert image to the 3 channel BGR color image and the image size reduced 1/8.
-       IMREAD_IGNORE_ORIENTATION   = 128 //!< If set, do not rotate the image according to EXIF's orientation flag.
+       IMREAD_IGNORE_ORIENTATION   = 128, //!< If set, do not rotate the image according to EXIF's orientation flag.
+       IMREAD_YUV_I420             = 256, //!< If set, return 8-bit YCbCr 4:2:0 planes in a single channel Mat of (height*3/2) x width: the Y plane followed by the Cb and Cr planes. See the note below.
+       IMREAD_YUV_NV12             = 512  //!< If set, return 8-bit YCbCr 4:2:0 planes in a single channel Mat of (height*3/2) x width: the Y plane followed by the interleaved CbCr plane. See the note below.
      };
 
 //! Imwrite flags
@@ -93,6 +96,7 @@ enum ImwriteFlags {
        IMWRITE_PNG_COMPRESSION     = 16, //!< For PNG, it can be the compression level from 0 to 9. A higher value means a smaller size and longer compression time. If specified, strategy is changed to IMWRITE_PNG_STRATEGY_DEFAULT (Z_DEFAULT_STRATEGY). Default value is 1 (best speed setting).
        IMWRITE_PNG_STRATEGY        = 17, //!< One of cv::ImwritePNGFlags, default is IMWRITE_PNG_STRATEGY_RLE.
        IMWRITE_PNG_BILEVEL         = 18, //!< Binary level PNG, 0 or 1, default is 0.
+       IMWRITE_PNG_THREADS         = 19, //!< For PNG, number of threads used to compress the image data. 1 (default) - single-threaded, 0 or negative - cv::getNumThreads(). Ignored for bilevel images.
        IMWRITE_PXM_BINARY          = 32, //!< For PPM, PGM, or PBM, it can be a binary format flag, 0 or 1. Default value is 1.
        IMWRITE_EXR_TYPE            = (3 << 4) + 0 /* 48 */, //!< override EXR storage type (FLOAT (FP32) is default)
        IMWRITE_EXR_COMPRESSION     = (3 << 4) + 1 /* 49 */, //!< override EXR compression type (ZIP_COMPRESSION = 3 is default)
@@ -104,6 +108,7 @@ enum ImwriteFlags {
        IMWRITE_TIFF_XDPI           = 257,//!< For TIFF, use to specify the X direction DPI
        IMWRITE_TIFF_YDPI           = 258,//!< For TIFF, use to specify the Y direction DPI
        IMWRITE_TIFF_COMPRESSION    = 259,//!< For TIFF, use to specify the image compression scheme. See cv::ImwriteTiffCompressionFlags. Note, for images whose depth is CV_32F, only libtiff's SGILOG compression scheme is used. For other supported depths, the compression scheme can be specified by this flag; LZW compression is the default.
+       IMWRITE_TIFF_THREADS        = 260,//!< For TIFF, number of threads used to compress the image strips. 1 (default) - single-threaded, 0 or negative - cv::getNumThreads(). Only used with LZW, Deflate and PackBits compression.
        IMWRITE_TIFF_ROWSPERSTRIP   = 278,//!< For TIFF, use to specify the number of rows per strip.
        IMWRITE_TIFF_PREDICTOR      = 317,//!< For TIFF, use to specify predictor. See cv::ImwriteTiffPredictorFlags.
        IMWRITE_JPEG2000_COMPRESSION_X1000 = 272,//!< For JPEG2000, use to specify the target compression rate (multiplied by 1000). The value can be from 0 to 1000. Default is 1000.
@@ -264,6 +269,13 @@ Currently, the following file formats are supported:
 -   Use the IMREAD_UNCHANGED flag to keep the floating point values from PFM image.
 -   By default number of pixels must be less than 2^30. Limit can be set using system
     variable OPENCV_IO_MAX_IMAGE_PIXELS
+-   Files can be memory-mapped and decoded in place, if the codec can read from memory. It is off by
+    default, set system variable OPENCV_IO_MMAP_MIN_FILE_SIZE to the smallest file size to be mapped.
+    A mapped file must not be truncated while it is read, the process is killed (SIGBUS) otherwise.
+-   With @ref IMREAD_YUV_I420 or @ref IMREAD_YUV_NV12 the planes are full range (JFIF) YCbCr with 2x2 subsampled
+    chroma, as stored by JPEG. Baseline YCbCr and grayscale JPEGs are returned without color conversion and
+    chroma upsampling, other images are decoded to BGR and converted. Odd sizes are rounded up to even ones,
+    EXIF orientation is not applied, and the modes can't be combined with regions or scaling.
 
 @param filename Name of file to be loaded.
 @param flags Flag that can take values of cv::ImreadModes
@@ -281,6 +293,42 @@ The image passing through the img parameter can be pre-allocated. The memory is
  */
 CV_EXPORTS_W void imread( const String& filename, OutputArray dst, int flags = IMREAD_COLOR );
 
+/** @brief Loads a rectangular region of an image from a file.
+
+The function decodes only the part of the image covered by roi where the codec allows it: JPEG skips
+the rows above and crops the scanlines to the iMCU columns of the region, TIFF decodes only the tiles
+(strips) intersecting the region, non-interlaced PNG stops after the last row of the region. So time
+and memory are proportional to the size of the region rather than to the size of the image. Other
+formats are decoded completely and cropped.
+
+The result is the same as `imread(filename, flags)(roi)` up to the chroma upsampling at the region
+borders of subsampled JPEG images.
+
+@param filename Name of file to be loaded.
+@param roi Region of the image to load. It must be inside of the image. With the IMREAD_REDUCED_* flags
+it refers to the reduced image. EXIF orientation is applied to the region after decoding, so the
+region is specified in the stored (not rotated) image coordinates.
+@param flags Flag that can take values of cv::ImreadModes
+@sa cv::imread, cv::imdecodeROI
+*/
+CV_EXPORTS_W Mat imreadROI( const String& filename, const Rect& roi, int flags = IMREAD_COLOR );
+
+/** @brief Loads an image from a file and resizes it to the given size.
+
+The result is close to `resize(imread(filename, flags), dsize)`, but the codecs which can reduce the
+resolution while decoding do so: JPEG decodes at the smallest M/8 scale (1/8, 1/4, 1/2 with libjpeg)
+which is still at least as large as dsize, WebP rescales to dsize directly, JPEG 2000 (OpenJPEG) skips
+the unneeded resolution levels. The reduced image is then resized to dsize with INTER_AREA (or INTER_CUBIC
+when it has to be enlarged), so decoding thumbnails of large images is much faster than the full decode.
+
+@param filename Name of file to be loaded.
+@param dsize Size of the output image, after the EXIF orientation is applied.
+@param flags Flag that can take values of cv::ImreadModes. The IMREAD_REDUCED_* flags disable the
+reduction by the codec.
+@sa cv::imread, cv::imdecodeScaled
+*/
+CV_EXPORTS_W Mat imreadScaled( const String& filename, const Size& dsize, int flags = IMREAD_COLOR );
+
 /** @brief Loads a multi-page image from a file.
 
 The function imreadmulti loads a multi-page image from the specified file into a vector of Mat objects.
@@ -381,6 +429,33 @@ failure the function returns empty cv::Mat object, but does not release user-pro
 */
 CV_EXPORTS Mat imdecode( InputArray buf, int flags, Mat* dst);
 
+/** @overload
+@param data Pointer to the encoded image. It is not copied, the decoders read it in place.
+@param size Size of the encoded image in bytes.
+@param flags The same flags as in cv::imread, see cv::ImreadModes.
+*/
+CV_EXPORTS Mat imdecode( const uchar* data, size_t size, int flags );
+
+/** @brief Reads a rectangular region of an image from a buffer in memory.
+
+See cv::imreadROI for the details.
+
+@param buf Input array or vector of bytes.
+@param roi Region of the image to decode. It must be inside of the image.
+@param flags The same flags as in cv::imread, see cv::ImreadModes.
+*/
+CV_EXPORTS_W Mat imdecodeROI( InputArray buf, const Rect& roi, int flags );
+
+/** @brief Reads an image from a buffer in memory and resizes it to the given size.
+
+See cv::imreadScaled for the details.
+
+@param buf Input array or vector of bytes.
+@param dsize Size of the output image.
+@param flags The same flags as in cv::imread, see cv::ImreadModes.
+*/
+CV_EXPORTS_W Mat imdecodeScaled( InputArray buf, const Size& dsize, int flags );
+
 /** @brief Reads a multi-page image from a buffer in memory.
 
 The function imdecodemulti reads a multi-page image from the specified buffer in the memory. If the buffer is too short or
@@ -396,6 +471,20 @@ See cv::imreadmulti for the list of supported formats and flags description.
 */
 CV_EXPORTS_W bool imdecodemulti(InputArray buf, int flags, CV_OUT std::vector<Mat>& mats, const cv::Range& range = Range::all());
 
+/** @brief Reads a batch of images from buffers in memory.
+
+The function decodes the buffers in parallel, the same way as cv::imdecode does for each of them. The decoder
+objects (and for JPEG also the libjpeg state) are kept by the worker threads and reused for the next images,
+so decoding many small images avoids most of the per-call setup.
+
+@param bufs Vector of input arrays or vectors of bytes, one per image.
+@param flags The same flags as in cv::imread, see cv::ImreadModes.
+@param dst Vector of the decoded images, resized to the number of buffers. Mats that already have the required
+size and type are decoded into without reallocation. Images that can't be decoded are left empty.
+@return true if all the images have been decoded.
+*/
+CV_EXPORTS_W bool imdecodeBatch(InputArrayOfArrays bufs, int flags, CV_OUT std::vector<Mat>& dst);
+
 /** @brief Encodes an image into a memory buffer.
 
 The function imencode compresses the image and stores it in the memory buffer that is resized to fit the
@@ -427,12 +516,14 @@ CV_EXPORTS_W bool haveImageWriter( const String& filename );
 The ImageCollection class provides iterator API to read multi page images on demand. Create iterator
 to the collection of the images and iterate over the collection. Decode the necessary page with operator*.
 
-The performance of page decoding is O(1) if collection is increment sequentially. If the user wants to access random page,
-then the time Complexity is O(n) because the collection has to be reinitialized every time in order to go to the correct page.
+The performance of page decoding is O(1) if collection is increment sequentially. TIFF files are indexed when the
+collection is opened, so any page is accessed in O(1) too. For other codecs random page access has O(n) time complexity
+because the collection has to be reinitialized every time in order to go to the correct page.
 However, the intermediate pages are not decoded during the process, so typically it's quite fast.
 This is required because multipage codecs does not support going backwards.
 After decoding the one page, it is stored inside the collection cache. Hence, trying to get Mat object from already decoded page is O(1).
-If you need memory, you can use .releaseCache() method to release cached index.
+If you need memory, you can use .releaseCache() method to release cached index, or limit the number of cached pages
+with .setCacheSize(), then the least recently used pages are released automatically.
 The space complexity is O(n) if all pages are decoded into memory. The user is able to decode and release images on demand.
 */
 class CV_EXPORTS ImageCollection {
@@ -459,6 +550,12 @@ public:
     const Mat& at(int index);
     const Mat& operator[](int index);
     void releaseCache(int index);
+    /** @brief Limits the number of decoded pages kept in the cache
+
+    When the limit is exceeded the least recently accessed page is released. References returned by at() or operator[]
+    for a released page become empty Mat objects, copy the Mat header to keep the data. 0 (the default) means no limit.
+    */
+    void setCacheSize(size_t maxPages);
     iterator begin();
     iterator end();
 
@@ -468,6 +565,129 @@ protected:
     Ptr<Impl> pImpl;
 };
 
+/** @brief To decode large images by horizontal strips
+
+The ImageStripDecoder class decodes an image from top to bottom, a strip of rows per read() call, so the whole
+decoded image never has to be kept in memory. The strips can be passed to resize(), cvtColor() etc. right away.
+
+JPEG, PNG (non-interlaced, libpng backend), TIFF and PxM (PBM, PGM, PPM) images are decoded incrementally.
+Other formats are decoded completely by open() and then returned by strips.
+
+Rows are returned in the order they are stored, the EXIF orientation is not applied.
+IMREAD_REDUCED_* and IMREAD_LOAD_GDAL flags are not supported.
+*/
+class CV_EXPORTS ImageStripDecoder {
+public:
+    ImageStripDecoder();
+    ImageStripDecoder(const String& filename, int flags = IMREAD_COLOR);
+
+    /** @brief Opens an image file and reads its header
+
+    @param filename Name of the file to be loaded.
+    @param flags Flag that can take values of cv::ImreadModes
+    @return true if the image can be decoded
+    */
+    bool open(const String& filename, int flags = IMREAD_COLOR);
+
+    /** @brief Opens an image stored in the memory buffer and reads its header
+
+    The buffer is not copied, it must stay valid until the decoding is finished.
+
+    @param buf Input array or vector of bytes.
+    @param flags Flag that can take values of cv::ImreadModes
+    @return true if the image can be decoded
+    */
+    bool openBuffer(InputArray buf, int flags = IMREAD_COLOR);
+
+    bool isOpened() const;
+    //! Size of the whole image
+    Size size() const;
+    //! Type of the returned strips, defined by the image and the flags as for cv::imread
+    int type() const;
+    //! Index of the row the next read() call starts from
+    int currentRow() const;
+
+    /** @brief Decodes the next strip of rows
+
+    @param strip Output strip of min(maxRows, size().height - currentRow()) rows of the whole image width.
+    It is not reallocated if it already has the required size and type.
+    @param maxRows Maximum number of rows to decode.
+    @return The number of decoded rows, 0 when the whole image has been read.
+    */
+    int read(OutputArray strip, int maxRows);
+
+    void release();
+
+    class Impl;
+protected:
+    Ptr<Impl> pImpl;
+};
+
+/** @brief Encodes and writes images in background threads
+
+The AsyncImageWriter class takes images to be written with cv::imwrite or encoded with cv::imencode, copies them into
+a bounded queue and returns immediately. The queue is served by a pool of worker threads, so encoding overlaps with
+the work of the calling thread, e.g. acquisition of the next frame.
+
+At most maxQueueSize images wait in the queue and one image per worker thread is being encoded, which bounds the memory
+used by the writer. When the queue is full, write() and encode() either wait for a free slot or drop the image,
+depending on the policy.
+
+Each call returns an AsyncArray which is completed when the image is processed: with an empty value by write() and
+with the encoded buffer by encode(). Failures (unsupported format, I/O errors, dropped images) are reported as
+exceptions raised by AsyncArray::get().
+
+The destructor waits until all queued images are written.
+*/
+class CV_EXPORTS AsyncImageWriter {
+public:
+    //! Behavior of write() and encode() when the queue is full
+    enum QueuePolicy {
+        QUEUE_BLOCK = 0, //!< wait until a worker takes an image from the queue
+        QUEUE_DROP  = 1  //!< don't queue the image, the returned AsyncArray raises an exception
+    };
+
+    /** @brief Starts the worker threads
+
+    @param numThreads Number of worker threads, cv::getNumThreads() if it is not positive.
+    @param maxQueueSize Maximum number of images waiting for a worker.
+    @param policy One of AsyncImageWriter::QueuePolicy
+    */
+    explicit AsyncImageWriter(int numThreads = 1, int maxQueueSize = 8, int policy = QUEUE_BLOCK);
+    ~AsyncImageWriter();
+
+    /** @brief Queues an image to be saved to a file, see cv::imwrite
+
+    @param filename Name of the file.
+    @param img Image to be saved, it is copied.
+    @param params Format-specific parameters, see cv::imwrite.
+    */
+    AsyncArray write(const String& filename, InputArray img, const std::vector<int>& params = std::vector<int>());
+
+    /** @brief Queues an image to be encoded into a memory buffer, see cv::imencode
+
+    The result is a 1-row CV_8UC1 matrix with the encoded image.
+
+    @param ext File extension that defines the output format. Must include a leading period.
+    @param img Image to be encoded, it is copied.
+    @param params Format-specific parameters, see cv::imwrite.
+    */
+    AsyncArray encode(const String& ext, InputArray img, const std::vector<int>& params = std::vector<int>());
+
+    //! Waits until all queued images are processed
+    void waitAll();
+
+    //! Number of images which are queued or being encoded
+    int pending() const;
+
+    //! Number of images dropped because the queue was full
+    int64 dropped() const;
+
+    class Impl;
+protected:
+    Ptr<Impl> pImpl;
+};
+
 //! @} imgcodecs
 
 } // cv
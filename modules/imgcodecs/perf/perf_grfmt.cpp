@@ -0,0 +1,172 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html
+
+#include "perf_precomp.hpp"
+
+namespace opencv_test
+{
+
+using namespace perf;
+
+namespace {
+
+struct CodecConfig
+{
+    const char* name;
+    const char* ext;
+    int nparams;
+    int params[4];
+};
+
+// Every grfmt backend with its typical parameter sets. Backends which are not built are skipped at runtime.
+static const CodecConfig codecConfigs[] =
+{
+    { "bmp",            ".bmp",  0, { 0 } },
+    { "pxm",            ".pnm",  0, { 0 } },
+    { "pam",            ".pam",  0, { 0 } },
+    { "pfm",            ".pfm",  0, { 0 } },
+    { "sunras",         ".ras",  0, { 0 } },
+    { "hdr",            ".hdr",  0, { 0 } },
+    { "exr",            ".exr",  0, { 0 } },
+    { "jpeg_q95",       ".jpg",  2, { IMWRITE_JPEG_QUALITY, 95 } },
+    { "jpeg_q50",       ".jpg",  2, { IMWRITE_JPEG_QUALITY, 50 } },
+    { "jpeg_prog",      ".jpg",  2, { IMWRITE_JPEG_PROGRESSIVE, 1 } },
+    { "png_fast",       ".png",  0, { 0 } },
+    { "png_c9",         ".png",  2, { IMWRITE_PNG_COMPRESSION, 9 } },
+    { "png_mt",         ".png",  2, { IMWRITE_PNG_THREADS, 0 } },
+    { "tiff_lzw",       ".tiff", 0, { 0 } },
+    { "tiff_deflate",   ".tiff", 2, { IMWRITE_TIFF_COMPRESSION, IMWRITE_TIFF_COMPRESSION_ADOBE_DEFLATE } },
+    { "tiff_none",      ".tiff", 2, { IMWRITE_TIFF_COMPRESSION, IMWRITE_TIFF_COMPRESSION_NONE } },
+    { "tiff_mt",        ".tiff", 2, { IMWRITE_TIFF_THREADS, 0 } },
+    { "webp_q75",       ".webp", 2, { IMWRITE_WEBP_QUALITY, 75 } },
+    { "webp_lossless",  ".webp", 2, { IMWRITE_WEBP_QUALITY, 101 } },
+    { "jp2",            ".jp2",  0, { 0 } },
+    { "jp2_x100",       ".jp2",  2, { IMWRITE_JPEG2000_COMPRESSION_X1000, 100 } },
+    { "avif",           ".avif", 0, { 0 } },
+};
+
+#define CODEC_ALL ::testing::Values("bmp", "pxm", "pam", "pfm", "sunras", "hdr", "exr", \
+                                    "jpeg_q95", "jpeg_q50", "jpeg_prog", "png_fast", "png_c9", "png_mt", \
+                                    "tiff_lzw", "tiff_deflate", "tiff_none", "tiff_mt", \
+                                    "webp_q75", "webp_lossless", "jp2", "jp2_x100", "avif")
+
+static const CodecConfig& findCodec(const std::string& name)
+{
+    for (size_t i = 0; i < sizeof(codecConfigs) / sizeof(codecConfigs[0]); i++)
+        if (name == codecConfigs[i].name)
+            return codecConfigs[i];
+    CV_Error(Error::StsBadArg, "Unknown codec configuration: " + name);
+}
+
+// Smooth content with some noise, so compression ratios are close to the ones of natural images
+static Mat makeTestImage(const Size& sz, int type)
+{
+    const int cn = CV_MAT_CN(type), depth = CV_MAT_DEPTH(type);
+    Mat img(sz, CV_32FC(cn));
+    for (int y = 0; y < sz.height; y++)
+    {
+        float* row = img.ptr<float>(y);
+        for (int x = 0; x < sz.width; x++)
+            for (int c = 0; c < cn; c++)
+                row[x * cn + c] = 0.5f + 0.25f * std::sin(x * 0.011f * (c + 1)) * std::cos(y * 0.007f + c);
+    }
+    Mat noise(sz, CV_32FC(cn));
+    randn(noise, Scalar::all(0), Scalar::all(0.02));
+    img += noise;
+
+    double scale = depth == CV_8U ? 255. : depth == CV_16U ? 65535. : 1.;
+    Mat dst;
+    img.convertTo(dst, type, scale);
+    return dst;
+}
+
+static std::vector<uchar> encodeOrSkip(const CodecConfig& codec, const Mat& img)
+{
+    if (!haveImageWriter(codec.ext))
+        throw SkipTestException(cv::format("%s encoder is not available", codec.ext));
+    std::vector<int> params(codec.params, codec.params + codec.nparams);
+    std::vector<uchar> buf;
+    bool ok = false;
+    try
+    {
+        ok = imencode(codec.ext, img, buf, params);
+    }
+    catch (const cv::Exception&)
+    {
+    }
+    // only measure combinations which the backend stores as is, without conversions
+    if (!ok || imdecode(buf, IMREAD_UNCHANGED).type() != img.type())
+        throw SkipTestException(cv::format("%s does not support %s", codec.name, typeToString(img.type()).c_str()));
+    return buf;
+}
+
+} // namespace
+
+typedef tuple<std::string, MatType, Size> Codec_t;
+typedef perf::TestBaseWithParam<Codec_t> Imgcodecs_Codec;
+
+#define CODEC_TYPES ::testing::Values(CV_8UC1, CV_8UC3, CV_8UC4, CV_16UC1, CV_16UC3, CV_32FC1, CV_32FC3)
+#define CODEC_SIZES ::testing::Values(::perf::szVGA, ::perf::sz1080p)
+
+// Peak memory of each test is reported by the test framework (memory_usage)
+
+PERF_TEST_P(Imgcodecs_Codec, encode, testing::Combine(CODEC_ALL, CODEC_TYPES, CODEC_SIZES))
+{
+    const CodecConfig& codec = findCodec(get<0>(GetParam()));
+    const int type = get<1>(GetParam());
+    const Size sz = get<2>(GetParam());
+
+    Mat img = makeTestImage(sz, type);
+    std::vector<uchar> buf = encodeOrSkip(codec, img);
+    std::vector<int> params(codec.params, codec.params + codec.nparams);
+
+    TEST_CYCLE() imencode(codec.ext, img, buf, params);
+
+    RecordProperty("encoded_size", cv::format("%llu", (unsigned long long)buf.size()));
+    RecordProperty("bytes_per_pixel", cv::format("%.4f", (double)buf.size() / sz.area()));
+    SANITY_CHECK_NOTHING();
+}
+
+PERF_TEST_P(Imgcodecs_Codec, decode, testing::Combine(CODEC_ALL, CODEC_TYPES, CODEC_SIZES))
+{
+    const CodecConfig& codec = findCodec(get<0>(GetParam()));
+    const int type = get<1>(GetParam());
+    const Size sz = get<2>(GetParam());
+
+    std::vector<uchar> buf = encodeOrSkip(codec, makeTestImage(sz, type));
+    Mat dst;
+
+    TEST_CYCLE() dst = imdecode(buf, IMREAD_UNCHANGED);
+
+    RecordProperty("encoded_size", cv::format("%llu", (unsigned long long)buf.size()));
+    RecordProperty("bytes_per_pixel", cv::format("%.4f", (double)buf.size() / sz.area()));
+    EXPECT_EQ(type, dst.type());
+    SANITY_CHECK_NOTHING();
+}
+
+// same as decode, but through the file system to compare imread() against imdecode() from memory
+PERF_TEST_P(Imgcodecs_Codec, read, testing::Combine(CODEC_ALL, CODEC_TYPES, CODEC_SIZES))
+{
+    const CodecConfig& codec = findCodec(get<0>(GetParam()));
+    const int type = get<1>(GetParam());
+    const Size sz = get<2>(GetParam());
+
+    std::vector<uchar> buf = encodeOrSkip(codec, makeTestImage(sz, type));
+    const string filename = cv::tempfile(codec.ext);
+    {
+        FILE* f = fopen(filename.c_str(), "wb");
+        ASSERT_TRUE(f != NULL);
+        ASSERT_EQ(buf.size(), fwrite(buf.data(), 1, buf.size(), f));
+        fclose(f);
+    }
+    Mat dst;
+
+    TEST_CYCLE() dst = imread(filename, IMREAD_UNCHANGED);
+
+    EXPECT_EQ(0, remove(filename.c_str()));
+    EXPECT_EQ(type, dst.type());
+    SANITY_CHECK_NOTHING();
+}
+
+} // namespace
@@ -0,0 +1,261 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html
+
+#include "precomp.hpp"
+#include <opencv2/core/detail/async_promise.hpp>
+
+#include <deque>
+
+#ifndef OPENCV_DISABLE_THREAD_SUPPORT
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#endif
+
+namespace cv {
+
+class AsyncImageWriter::Impl
+{
+public:
+    struct Task
+    {
+        String filename; // the file name or the extension for encode()
+        bool toMemory;
+        Mat img;
+        std::vector<int> params;
+        AsyncPromise promise;
+    };
+
+    Impl(int numThreads, int maxQueueSize, int policy)
+        : m_maxQueueSize(std::max(maxQueueSize, 1)), m_policy(policy), m_active(0), m_dropped(0), m_stop(false)
+    {
+        CV_Assert(policy == QUEUE_BLOCK || policy == QUEUE_DROP);
+#ifndef OPENCV_DISABLE_THREAD_SUPPORT
+        if (numThreads <= 0)
+            numThreads = getNumThreads();
+        for (int i = 0; i < std::max(numThreads, 1); i++)
+            m_workers.push_back(std::thread(&Impl::run, this));
+#else
+        CV_UNUSED(numThreads);
+#endif
+    }
+
+    ~Impl()
+    {
+#ifndef OPENCV_DISABLE_THREAD_SUPPORT
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_notEmpty.notify_all();
+        for (size_t i = 0; i < m_workers.size(); i++)
+            m_workers[i].join();
+#endif
+    }
+
+    AsyncArray push(const String& filename, bool toMemory, InputArray img, const std::vector<int>& params)
+    {
+        CV_Assert(!img.empty());
+
+        Task task;
+        task.filename = filename;
+        task.toMemory = toMemory;
+        task.params = params;
+        AsyncArray result = task.promise.getArrayResult();
+
+#ifndef OPENCV_DISABLE_THREAD_SUPPORT
+        // don't copy the image which is going to be dropped
+        if (m_policy == QUEUE_DROP && isFull())
+            return drop(task, result);
+
+        // the copy is made outside of the lock to not stall the workers
+        task.img = img.getMat().clone();
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if ((int)m_queue.size() >= m_maxQueueSize)
+        {
+            if (m_policy == QUEUE_DROP)
+            {
+                lock.unlock();
+                return drop(task, result);
+            }
+            m_notFull.wait(lock, [this] { return (int)m_queue.size() < m_maxQueueSize; });
+        }
+        m_queue.push_back(std::move(task));
+        lock.unlock();
+        m_notEmpty.notify_one();
+#else
+        // no threads, the image is encoded right away
+        task.img = img.getMat();
+        process(task);
+#endif
+        return result;
+    }
+
+    void waitAll()
+    {
+#ifndef OPENCV_DISABLE_THREAD_SUPPORT
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_idle.wait(lock, [this] { return m_queue.empty() && m_active == 0; });
+#endif
+    }
+
+    int pending() const
+    {
+#ifndef OPENCV_DISABLE_THREAD_SUPPORT
+        std::lock_guard<std::mutex> lock(m_mutex);
+#endif
+        return (int)m_queue.size() + m_active;
+    }
+
+    int64 dropped() const
+    {
+#ifndef OPENCV_DISABLE_THREAD_SUPPORT
+        std::lock_guard<std::mutex> lock(m_mutex);
+#endif
+        return m_dropped;
+    }
+
+protected:
+#ifndef OPENCV_DISABLE_THREAD_SUPPORT
+    bool isFull() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return (int)m_queue.size() >= m_maxQueueSize;
+    }
+
+    AsyncArray drop(Task& task, const AsyncArray& result)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_dropped++;
+        }
+        setException(task.promise, cv::Exception(Error::StsError,
+            "The image is dropped, the queue is full", CV_Func, __FILE__, __LINE__));
+        return result;
+    }
+#endif
+
+    static void process(Task& task)
+    {
+        try
+        {
+            if (task.toMemory)
+            {
+                std::vector<uchar> buf;
+                if (!imencode(task.filename, task.img, buf, task.params))
+                    CV_Error(Error::StsError, "Can't encode the image to " + task.filename);
+                task.promise.setValue(Mat(buf, false));
+            }
+            else
+            {
+                if (!imwrite(task.filename, task.img, task.params))
+                    CV_Error(Error::StsError, "Can't write the image to " + task.filename);
+                task.promise.setValue(Mat());
+            }
+        }
+        catch (const cv::Exception& e)
+        {
+            setException(task.promise, e);
+        }
+#if CV__EXCEPTION_PTR
+        catch (...)
+        {
+            setException(task.promise, std::current_exception());
+        }
+#endif
+    }
+
+    // the caller may have released the AsyncArray if it doesn't need the result, then the promise throws
+    template <typename T>
+    static void setException(AsyncPromise& promise, const T& e)
+    {
+        try
+        {
+            promise.setException(e);
+        }
+        catch (...)
+        {
+        }
+    }
+
+#ifndef OPENCV_DISABLE_THREAD_SUPPORT
+    void run()
+    {
+        for (;;)
+        {
+            Task task;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_notEmpty.wait(lock, [this] { return m_stop || !m_queue.empty(); });
+                if (m_queue.empty())
+                    return; // stopped, all queued images are written
+                task = std::move(m_queue.front());
+                m_queue.pop_front();
+                m_active++;
+            }
+            m_notFull.notify_one();
+
+            process(task);
+            task.img.release();
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_active--;
+                if (m_queue.empty() && m_active == 0)
+                    m_idle.notify_all();
+            }
+        }
+    }
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_notEmpty, m_notFull, m_idle;
+    std::vector<std::thread> m_workers;
+#endif
+    std::deque<Task> m_queue;
+    int m_maxQueueSize;
+    int m_policy;
+    int m_active;
+    int64 m_dropped;
+    bool m_stop;
+};
+
+AsyncImageWriter::AsyncImageWriter(int numThreads, int maxQueueSize, int policy)
+    : pImpl(makePtr<Impl>(numThreads, maxQueueSize, policy))
+{
+}
+
+AsyncImageWriter::~AsyncImageWriter()
+{
+}
+
+AsyncArray AsyncImageWriter::write(const String& filename, InputArray img, const std::vector<int>& params)
+{
+    CV_TRACE_FUNCTION();
+    return pImpl->push(filename, false, img, params);
+}
+
+AsyncArray AsyncImageWriter::encode(const String& ext, InputArray img, const std::vector<int>& params)
+{
+    CV_TRACE_FUNCTION();
+    return pImpl->push(ext, true, img, params);
+}
+
+void AsyncImageWriter::waitAll()
+{
+    CV_TRACE_FUNCTION();
+    pImpl->waitAll();
+}
+
+int AsyncImageWriter::pending() const
+{
+    return pImpl->pending();
+}
+
+int64 AsyncImageWriter::dropped() const
+{
+    return pImpl->dropped();
+}
+
+} // namespace
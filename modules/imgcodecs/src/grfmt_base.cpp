@@ -53,6 +53,7 @@ BaseImageDecoder::BaseImageDecoder()
     m_type = -1;
     m_buf_supported = false;
     m_scale_denom = 1;
+    m_next_row = 0;
 }
 
 
@@ -64,6 +65,7 @@ bool BaseImageDecoder::setSource( const String& filename )
 {
     m_filename = filename;
     m_buf.release();
+    m_exif = ExifReader();
     return true;
 }
 
@@ -73,9 +75,16 @@ bool BaseImageDecoder::setSource( const Mat& buf )
         return false;
     m_filename = String();
     m_buf = buf;
+    m_exif = ExifReader();
     return true;
 }
 
+void BaseImageDecoder::releaseSource()
+{
+    m_filename = String();
+    m_buf.release();
+}
+
 size_t BaseImageDecoder::signatureLength() const
 {
     return m_signature.size();
@@ -94,6 +103,31 @@ int BaseImageDecoder::setScale( const int& scale_denom )
     return temp;
 }
 
+bool BaseImageDecoder::setRegion( const Rect& )
+{
+    return false;
+}
+
+bool BaseImageDecoder::setTargetSize( const Size& )
+{
+    return false;
+}
+
+bool BaseImageDecoder::startReadRows( int )
+{
+    return false;
+}
+
+bool BaseImageDecoder::readDataYUV( Mat&, int )
+{
+    return false;
+}
+
+bool BaseImageDecoder::readRows( Mat& )
+{
+    return false;
+}
+
 ImageDecoder BaseImageDecoder::newDecoder() const
 {
     return ImageDecoder();
@@ -70,12 +70,48 @@ public:
     virtual bool setSource( const String& filename );
     virtual bool setSource( const Mat& buf );
     virtual int setScale( const int& scale_denom );
+
+    /// Called after readHeader to request decoding of the given sub-rectangle only.
+    /// Returns false if the decoder can't do it, then the whole image is decoded and cropped by the caller.
+    /// On success readData() expects a destination Mat of roi.size().
+    virtual bool setRegion( const Rect& roi );
+
+    /// Called after readHeader to let the decoder reduce the resolution while decoding.
+    /// The decoder picks the smallest scale it supports which gives at least the requested size and updates
+    /// width() and height(). Returns false if it can't decode at a reduced resolution.
+    virtual bool setTargetSize( const Size& size );
+
     virtual bool readHeader() = 0;
     virtual bool readData( Mat& img ) = 0;
 
+    /// Row by row decoding, called after readHeader instead of readData.
+    /// startReadRows() returns false if the decoder can't decode the image incrementally into the given type.
+    /// Then every readRows() call decodes the next img.rows rows, img has the full image width.
+    virtual bool startReadRows( int type );
+    virtual bool readRows( Mat& img );
+
+    /// Called after readHeader instead of readData to get the YCbCr 4:2:0 planes in the layout given by
+    /// IMREAD_YUV_I420 or IMREAD_YUV_NV12. Returns false if the codec can't produce them without color conversion,
+    /// then the caller converts the decoded BGR image.
+    virtual bool readDataYUV( Mat& img, int layout );
+
     /// Called after readData to advance to the next page, if any.
     virtual bool nextPage() { return false; }
 
+    /// Number of pages, or -1 if it is not known without decoding the pages one by one.
+    virtual int pageCount() { return -1; }
+
+    /// Jumps to the given page and reads its header. Returns false if the decoder can't seek,
+    /// then the caller reopens the source and advances with nextPage().
+    virtual bool setPage( int /*index*/ ) { return false; }
+
+    /// Returns true if the decoder can be given another memory buffer by setSource() after an image is decoded,
+    /// so a single instance can be reused for many images.
+    virtual bool isReusable() const { return false; }
+
+    /// Drops the references to the source, so a decoder kept for reuse doesn't hold the last buffer.
+    virtual void releaseSource();
+
     virtual size_t signatureLength() const;
     virtual bool checkSignature( const String& signature ) const;
     virtual ImageDecoder newDecoder() const;
@@ -85,6 +121,8 @@ protected:
     int  m_height; // height of the image ( filled by readHeader )
     int  m_type;
     int  m_scale_denom;
+    Rect m_roi;    // region to decode ( set by setRegion ), empty means the whole image
+    int  m_next_row; // the next row to be decoded by readRows
     String m_filename;
     String m_signature;
     Mat m_buf;
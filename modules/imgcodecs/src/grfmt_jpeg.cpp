@@ -88,6 +88,10 @@ extern "C" {
   #undef CV_MANUAL_JPEG_STD_HUFF_TABLES
 #endif
 
+#if defined(LIBJPEG_TURBO_VERSION_NUMBER) && LIBJPEG_TURBO_VERSION_NUMBER >= 1005000
+  #define CV_JPEG_HAVE_CROP_SCANLINE  // jpeg_crop_scanline() and jpeg_skip_scanlines() are available
+#endif
+
 namespace cv
 {
 
@@ -108,6 +112,13 @@ struct JpegState
     jpeg_decompress_struct cinfo; // IJG JPEG codec structure
     JpegErrorMgr jerr; // error processing manager state
     JpegSource source; // memory buffer source
+
+    // row by row decoding state ( filled by startReadRows )
+    JSAMPARRAY buffer; // intermediate scanline, 0 if rows are decoded directly into the image
+    int xofs;          // position of the region inside of the decoded scanline
+    int end_row;       // the row after the last one to decode, 0 if decoding is not started
+    bool color;
+    bool doDirectRead;
 };
 
 /////////////////////// Error processing /////////////////////
@@ -210,6 +221,49 @@ void  JpegDecoder::close()
 
     m_width = m_height = 0;
     m_type = -1;
+    m_roi = Rect();
+}
+
+bool JpegDecoder::setRegion( const Rect& roi )
+{
+    m_roi = roi;
+    return true;
+}
+
+bool JpegDecoder::setTargetSize( const Size& size )
+{
+    volatile bool result = false;
+    JpegState* state = (JpegState*)m_state;
+    if( !state || !m_width || !m_height )
+        return false;
+
+    jpeg_decompress_struct* cinfo = &state->cinfo;
+    if( setjmp( state->jerr.setjmp_buffer ) == 0 )
+    {
+        // the image is scaled by scale_num/scale_denom in the DCT domain, pick the smallest factor
+#if defined(LIBJPEG_TURBO_VERSION_NUMBER) || JPEG_LIB_VERSION >= 70
+        const int nums[] = { 1, 2, 3, 4, 5, 6, 7, 8 }, denom = 8; // any M/8 scale
+#else
+        const int nums[] = { 1, 2, 4, 8 }, denom = 8; // 1/8, 1/4, 1/2 and 1/1 only
+#endif
+        const int count = (int)(sizeof(nums)/sizeof(nums[0]));
+        int i = 0;
+        for( ; i < count - 1; i++ )
+        {
+            if( divUp((int)cinfo->image_width*nums[i], denom) >= size.width &&
+                divUp((int)cinfo->image_height*nums[i], denom) >= size.height )
+                break;
+        }
+
+        cinfo->scale_num = nums[i];
+        cinfo->scale_denom = denom;
+        jpeg_calc_output_dimensions( cinfo );
+        m_width = cinfo->output_width;
+        m_height = cinfo->output_height;
+        result = true;
+    }
+
+    return result;
 }
 
 ImageDecoder JpegDecoder::newDecoder() const
@@ -220,16 +274,34 @@ ImageDecoder JpegDecoder::newDecoder() const
 bool  JpegDecoder::readHeader()
 {
     volatile bool result = false;
-    close();
 
-    JpegState* state = new JpegState;
-    m_state = state;
-    state->cinfo.err = jpeg_std_error(&state->jerr.pub);
-    state->jerr.pub.error_exit = error_exit;
+    // the codec state is kept from one memory buffer to the next one, only the decoding is reset
+    const bool reuseState = m_state && !m_buf.empty() &&
+                            ((JpegState*)m_state)->cinfo.src == &((JpegState*)m_state)->source.pub;
+    if( reuseState )
+    {
+        jpeg_abort_decompress( &((JpegState*)m_state)->cinfo );
+        m_width = m_height = 0;
+        m_type = -1;
+        m_roi = Rect();
+    }
+    else
+    {
+        close();
+
+        JpegState* new_state = new JpegState;
+        new_state->cinfo.err = jpeg_std_error(&new_state->jerr.pub);
+        new_state->jerr.pub.error_exit = error_exit;
+        m_state = new_state;
+    }
+
+    JpegState* state = (JpegState*)m_state;
+    state->end_row = 0;
 
     if( setjmp( state->jerr.setjmp_buffer ) == 0 )
     {
-        jpeg_create_decompress( &state->cinfo );
+        if( !reuseState )
+            jpeg_create_decompress( &state->cinfo );
 
         if( !m_buf.empty() )
         {
@@ -249,6 +321,28 @@ bool  JpegDecoder::readHeader()
             jpeg_save_markers(&state->cinfo, APP1, 0xffff);
             jpeg_read_header( &state->cinfo, TRUE );
 
+            // Check for Exif marker APP1, the orientation is known before the decoding
+            jpeg_saved_marker_ptr exif_marker = NULL;
+            jpeg_saved_marker_ptr cmarker = state->cinfo.marker_list;
+            while( cmarker && exif_marker == NULL )
+            {
+                if (cmarker->marker == APP1)
+                    exif_marker = cmarker;
+
+                cmarker = cmarker->next;
+            }
+
+            // Parse Exif data
+            if( exif_marker )
+            {
+                const std::streamsize offsetToTiffHeader = 6; //bytes from Exif size field to the first TIFF header
+
+                if (exif_marker->data_length > offsetToTiffHeader)
+                {
+                    m_exif.parseExif(exif_marker->data + offsetToTiffHeader, exif_marker->data_length - offsetToTiffHeader);
+                }
+            }
+
             state->cinfo.scale_num=1;
             state->cinfo.scale_denom = m_scale_denom;
             m_scale_denom=1; // trick! to know which decoder used scale_denom see imread_
@@ -399,33 +493,46 @@ int my_jpeg_load_dht (struct jpeg_decompress_struct *info, unsigned char *dht,
  ***************************************************************************/
 #endif  // CV_MANUAL_JPEG_STD_HUFF_TABLES
 
+/* check if this is a mjpeg image format, which omits the huffman tables */
+static void loadMjpegHuffTables( jpeg_decompress_struct* cinfo )
+{
+#ifdef CV_MANUAL_JPEG_STD_HUFF_TABLES
+    if ( cinfo->ac_huff_tbl_ptrs[0] == NULL &&
+        cinfo->ac_huff_tbl_ptrs[1] == NULL &&
+        cinfo->dc_huff_tbl_ptrs[0] == NULL &&
+        cinfo->dc_huff_tbl_ptrs[1] == NULL )
+    {
+        /* yes, this is a mjpeg image format, so load the correct
+        huffman table */
+        my_jpeg_load_dht( cinfo,
+            my_jpeg_odml_dht,
+            cinfo->ac_huff_tbl_ptrs,
+            cinfo->dc_huff_tbl_ptrs );
+    }
+#else
+    CV_UNUSED(cinfo);
+#endif
+}
+
 bool  JpegDecoder::readData( Mat& img )
+{
+    return startReadRows( img.type() ) && readRows( img );
+}
+
+bool  JpegDecoder::startReadRows( int type )
 {
     volatile bool result = false;
-    const bool color = img.channels() > 1;
+    const bool color = CV_MAT_CN(type) > 1;
 
     if( m_state && m_width && m_height )
     {
-        jpeg_decompress_struct* cinfo = &((JpegState*)m_state)->cinfo;
-        JpegErrorMgr* jerr = &((JpegState*)m_state)->jerr;
+        JpegState* state = (JpegState*)m_state;
+        jpeg_decompress_struct* cinfo = &state->cinfo;
+        JpegErrorMgr* jerr = &state->jerr;
 
         if( setjmp( jerr->setjmp_buffer ) == 0 )
         {
-#ifdef CV_MANUAL_JPEG_STD_HUFF_TABLES
-            /* check if this is a mjpeg image format */
-            if ( cinfo->ac_huff_tbl_ptrs[0] == NULL &&
-                cinfo->ac_huff_tbl_ptrs[1] == NULL &&
-                cinfo->dc_huff_tbl_ptrs[0] == NULL &&
-                cinfo->dc_huff_tbl_ptrs[1] == NULL )
-            {
-                /* yes, this is a mjpeg image format, so load the correct
-                huffman table */
-                my_jpeg_load_dht( cinfo,
-                    my_jpeg_odml_dht,
-                    cinfo->ac_huff_tbl_ptrs,
-                    cinfo->dc_huff_tbl_ptrs );
-            }
-#endif
+            loadMjpegHuffTables( cinfo );
 
             // See https://github.com/opencv/opencv/issues/25274
             // Conversion CMYK->BGR is not supported in libjpeg-turbo.
@@ -469,68 +576,103 @@ bool  JpegDecoder::readData( Mat& img )
                 }
             }
 
-            // Check for Exif marker APP1
-            jpeg_saved_marker_ptr exif_marker = NULL;
-            jpeg_saved_marker_ptr cmarker = cinfo->marker_list;
-            while( cmarker && exif_marker == NULL )
-            {
-                if (cmarker->marker == APP1)
-                    exif_marker = cmarker;
+            jpeg_start_decompress( cinfo );
 
-                cmarker = cmarker->next;
+            // the region to decode, the whole image by default
+            const Rect roi = m_roi.empty() ? Rect(0, 0, m_width, m_height) : m_roi;
+            int xofs = roi.x; // position of the region inside of the decoded scanline
+#ifdef CV_JPEG_HAVE_CROP_SCANLINE
+            if( roi.width < m_width )
+            {
+                // libjpeg aligns the left edge to the iMCU boundary, so xofs may stay non-zero
+                JDIMENSION crop_x = (JDIMENSION)roi.x, crop_width = (JDIMENSION)roi.width;
+                jpeg_crop_scanline( cinfo, &crop_x, &crop_width );
+                xofs = roi.x - (int)crop_x;
             }
+            if( roi.y > 0 )
+                jpeg_skip_scanlines( cinfo, (JDIMENSION)roi.y );
+#endif
 
-            // Parse Exif data
-            if( exif_marker )
+            JSAMPARRAY buffer = 0;
+            if( !doDirectRead || xofs != 0 || (int)cinfo->output_width != roi.width ||
+                cinfo->output_scanline < (JDIMENSION)roi.y )
             {
-                const std::streamsize offsetToTiffHeader = 6; //bytes from Exif size field to the first TIFF header
-
-                if (exif_marker->data_length > offsetToTiffHeader)
-                {
-                    m_exif.parseExif(exif_marker->data + offsetToTiffHeader, exif_marker->data_length - offsetToTiffHeader);
-                }
+                buffer = (*cinfo->mem->alloc_sarray)((j_common_ptr)cinfo,
+                                                     JPOOL_IMAGE, cinfo->output_width*4, 1 );
             }
 
+            // the rows above of the region which can't be skipped by the codec
+            while( cinfo->output_scanline < (JDIMENSION)roi.y )
+                jpeg_read_scanlines( cinfo, buffer, 1 );
 
-            jpeg_start_decompress( cinfo );
+            state->buffer = buffer;
+            state->xofs = xofs;
+            state->end_row = roi.y + roi.height;
+            state->color = color;
+            state->doDirectRead = doDirectRead;
+            result = true;
+        }
+    }
 
-            if( doDirectRead)
+    return result;
+}
+
+bool  JpegDecoder::readRows( Mat& img )
+{
+    volatile bool result = false;
+    JpegState* state = (JpegState*)m_state;
+
+    if( state && state->end_row > 0 &&
+        (int)state->cinfo.output_scanline + img.rows <= state->end_row )
+    {
+        jpeg_decompress_struct* cinfo = &state->cinfo;
+        JpegErrorMgr* jerr = &state->jerr;
+
+        if( setjmp( jerr->setjmp_buffer ) == 0 )
+        {
+            JSAMPARRAY buffer = state->buffer;
+            const int xofs = state->xofs;
+            const bool color = state->color, doDirectRead = state->doDirectRead;
+
+            for( int iy = 0 ; iy < img.rows; iy ++ )
             {
-                for( int iy = 0 ; iy < m_height; iy ++ )
+                uchar* data = img.ptr<uchar>(iy);
+                if( !buffer )
                 {
-                    uchar* data = img.ptr<uchar>(iy);
                     jpeg_read_scanlines( cinfo, &data, 1 );
+                    continue;
                 }
-            }
-            else
-            {
-                JSAMPARRAY buffer = (*cinfo->mem->alloc_sarray)((j_common_ptr)cinfo,
-                                                                 JPOOL_IMAGE, m_width*4, 1 );
 
-                for( int iy = 0 ; iy < m_height; iy ++ )
-                {
-                    uchar* data = img.ptr<uchar>(iy);
-                    jpeg_read_scanlines( cinfo, buffer, 1 );
+                jpeg_read_scanlines( cinfo, buffer, 1 );
+                const uchar* src = buffer[0] + xofs*cinfo->out_color_components;
 
-                    if( color )
-                    {
-                        if( cinfo->out_color_components == 3 )
-                            icvCvt_RGB2BGR_8u_C3R( buffer[0], 0, data, 0, Size(m_width,1) );
-                        else
-                            icvCvt_CMYK2BGR_8u_C4C3R( buffer[0], 0, data, 0, Size(m_width,1) );
-                    }
+                if( doDirectRead )
+                    memcpy( data, src, img.cols*cinfo->out_color_components );
+                else if( color )
+                {
+                    if( cinfo->out_color_components == 3 )
+                        icvCvt_RGB2BGR_8u_C3R( src, 0, data, 0, Size(img.cols,1) );
                     else
-                    {
-                        if( cinfo->out_color_components == 1 )
-                            memcpy( data, buffer[0], m_width );
-                        else
-                            icvCvt_CMYK2Gray_8u_C4C1R( buffer[0], 0, data, 0, Size(m_width,1) );
-                    }
+                        icvCvt_CMYK2BGR_8u_C4C3R( src, 0, data, 0, Size(img.cols,1) );
+                }
+                else
+                {
+                    if( cinfo->out_color_components == 1 )
+                        memcpy( data, src, img.cols );
+                    else
+                        icvCvt_CMYK2Gray_8u_C4C1R( src, 0, data, 0, Size(img.cols,1) );
                 }
             }
 
             result = true;
-            jpeg_finish_decompress( cinfo );
+            if( (int)cinfo->output_scanline == state->end_row )
+            {
+                state->end_row = 0;
+                if( cinfo->output_scanline < cinfo->output_height )
+                    jpeg_abort_decompress( cinfo ); // the rest of the image is not needed
+                else
+                    jpeg_finish_decompress( cinfo );
+            }
         }
     }
 
@@ -538,6 +680,87 @@ bool  JpegDecoder::readData( Mat& img )
 }
 
 
+bool  JpegDecoder::readDataYUV( Mat& img, int layout )
+{
+    JpegState* state = (JpegState*)m_state;
+    if( !state || !m_width || !m_height || !m_roi.empty() )
+        return false;
+
+    jpeg_decompress_struct* cinfo = &state->cinfo;
+    const int ncomps = cinfo->num_components;
+    // the planes are read as stored, which is possible for YCbCr and grayscale images at full resolution
+    if( !((cinfo->jpeg_color_space == JCS_YCbCr && ncomps == 3) ||
+          (cinfo->jpeg_color_space == JCS_GRAYSCALE && ncomps == 1)) ||
+        m_width != (int)cinfo->image_width || m_height != (int)cinfo->image_height )
+        return false;
+
+    // every jpeg_read_raw_data() call decodes one iMCU row: v_samp_factor*DCTSIZE rows of each component,
+    // the buffers are padded to whole MCUs
+    const int hmax = cinfo->max_h_samp_factor, vmax = cinfo->max_v_samp_factor;
+    const int mcuCols = divUp(m_width, hmax*DCTSIZE), imcuRows = divUp(m_height, vmax*DCTSIZE);
+    Mat planes[3];
+    Size planeSize[3]; // the meaningful part of the planes, comp_info is released by jpeg_finish_decompress
+    int hsamp[3], vsamp[3];
+    AutoBuffer<JSAMPROW> rows(ncomps*vmax*DCTSIZE);
+    JSAMPARRAY compRows[3];
+    for( int c = 0; c < ncomps; c++ )
+    {
+        const jpeg_component_info* comp = cinfo->comp_info + c;
+        hsamp[c] = comp->h_samp_factor;
+        vsamp[c] = comp->v_samp_factor;
+        planeSize[c] = Size( (int)comp->downsampled_width, (int)comp->downsampled_height );
+        planes[c].create( imcuRows*vsamp[c]*DCTSIZE, mcuCols*hsamp[c]*DCTSIZE, CV_8UC1 );
+        compRows[c] = rows.data() + c*vmax*DCTSIZE;
+    }
+
+    volatile bool result = false;
+    if( setjmp( state->jerr.setjmp_buffer ) == 0 )
+    {
+        loadMjpegHuffTables( cinfo );
+        cinfo->raw_data_out = TRUE;
+        cinfo->out_color_space = cinfo->jpeg_color_space;
+        jpeg_start_decompress( cinfo );
+
+        int r = 0;
+        for( ; r < imcuRows; r++ )
+        {
+            for( int c = 0; c < ncomps; c++ )
+            {
+                const int n = vsamp[c]*DCTSIZE;
+                for( int i = 0; i < n; i++ )
+                    compRows[c][i] = planes[c].ptr(r*n + i);
+            }
+            if( jpeg_read_raw_data( cinfo, compRows, vmax*DCTSIZE ) == 0 )
+                break; // truncated data
+        }
+        if( r == imcuRows )
+        {
+            jpeg_finish_decompress( cinfo );
+            result = true;
+        }
+        else
+            jpeg_abort_decompress( cinfo );
+    }
+    if( !result )
+        return false;
+
+    // 4:2:0 planes are used as is, other subsamplings are resampled
+    const Size ysize( alignSize(m_width, 2), alignSize(m_height, 2) ), csize( ysize.width/2, ysize.height/2 );
+    Mat yuv[3];
+    for( int c = 0; c < ncomps; c++ )
+    {
+        const Size dstSize = c == 0 ? ysize : csize;
+        const int scale = c == 0 ? 1 : 2;
+        if( hsamp[c]*scale == hmax && vsamp[c]*scale == vmax )
+            yuv[c] = planes[c](Rect(Point(), dstSize));
+        else
+            resize( planes[c](Rect(Point(), planeSize[c])), yuv[c], dstSize, 0, 0, INTER_AREA );
+    }
+    packYUV420( yuv[0], yuv[1], yuv[2], img, layout );
+    return true;
+}
+
+
 /////////////////////// JpegEncoder ///////////////////
 
 struct JpegDestination
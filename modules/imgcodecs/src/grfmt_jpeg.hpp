@@ -81,6 +81,12 @@ public:
 
     bool  readData( Mat& img ) CV_OVERRIDE;
     bool  readHeader() CV_OVERRIDE;
+    bool  setRegion( const Rect& roi ) CV_OVERRIDE;
+    bool  setTargetSize( const Size& size ) CV_OVERRIDE;
+    bool  startReadRows( int type ) CV_OVERRIDE;
+    bool  readRows( Mat& img ) CV_OVERRIDE;
+    bool  readDataYUV( Mat& img, int layout ) CV_OVERRIDE;
+    bool  isReusable() const CV_OVERRIDE { return true; }
     void  close();
 
     ImageDecoder newDecoder() const CV_OVERRIDE;
@@ -583,6 +583,51 @@ bool Jpeg2KOpjDecoderBase::readHeader()
     return true;
 }
 
+bool Jpeg2KOpjDecoderBase::setTargetSize( const Size& size )
+{
+    if (!codec_ || !image_)
+        return false;
+
+    // the lower resolution levels of the wavelet decomposition are decoded without the higher ones
+    OPJ_UINT32 numresolutions = 0;
+    {
+        opj_codestream_info_v2_t* info = opj_get_cstr_info(codec_.get());
+        if (!info)
+            return false;
+        if (info->m_default_tile_info.tccp_info)
+        {
+            numresolutions = info->m_default_tile_info.tccp_info[0].numresolutions;
+            for (OPJ_UINT32 i = 1; i < info->nbcomps; i++)
+                numresolutions = std::min(numresolutions, info->m_default_tile_info.tccp_info[i].numresolutions);
+        }
+        opj_destroy_cstr_info(&info);
+    }
+
+    const auto reducedSize = [this](OPJ_UINT32 factor) {
+        const OPJ_UINT32 d = 1u << factor;
+        return Size((int)((image_->x1 + d - 1) / d - (image_->x0 + d - 1) / d),
+                    (int)((image_->y1 + d - 1) / d - (image_->y0 + d - 1) / d));
+    };
+    OPJ_UINT32 factor = 0;
+    while (factor + 1 < numresolutions)
+    {
+        const Size next = reducedSize(factor + 1);
+        if (next.width < size.width || next.height < size.height)
+            break;
+        factor++;
+    }
+    if (factor == 0)
+        return false;
+
+    if (!opj_set_decoded_resolution_factor(codec_.get(), factor))
+        return false;
+
+    const Size reduced = reducedSize(factor);
+    m_width = reduced.width;
+    m_height = reduced.height;
+    return true;
+}
+
 bool Jpeg2KOpjDecoderBase::readData( Mat& img )
 {
     using DecodeFunc = bool(*)(const opj_image_t&, cv::Mat&, uint8_t shift);
@@ -66,6 +66,7 @@ public:
 
     bool readData( Mat& img ) CV_OVERRIDE;
     bool readHeader() CV_OVERRIDE;
+    bool setTargetSize( const Size& size ) CV_OVERRIDE;
 
 private:
     detail::StreamPtr stream_{nullptr};
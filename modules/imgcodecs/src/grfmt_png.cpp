@@ -117,6 +117,17 @@ void  PngDecoder::close()
         png_destroy_read_struct( &png_ptr, &info_ptr, &end_info );
         m_png_ptr = m_info_ptr = m_end_info = 0;
     }
+    m_roi = Rect();
+}
+
+bool  PngDecoder::setRegion( const Rect& roi )
+{
+    // interlaced images have to be decoded completely anyway
+    if( !m_png_ptr || !m_info_ptr ||
+        png_get_interlace_type( (png_structp)m_png_ptr, (png_infop)m_info_ptr ) != PNG_INTERLACE_NONE )
+        return false;
+    m_roi = roi;
+    return true;
 }
 
 
@@ -214,12 +225,56 @@ bool  PngDecoder::readHeader()
 }
 
 
+// sets up libpng conversions of the decoded rows into the given type,
+// must be called within the setjmp block of the caller
+void  PngDecoder::setTransformations( int type )
+{
+    png_structp png_ptr = (png_structp)m_png_ptr;
+    bool color = CV_MAT_CN(type) > 1;
+
+    if( CV_MAT_DEPTH(type) == CV_8U && m_bit_depth == 16 )
+        png_set_strip_16( png_ptr );
+    else if( !isBigEndian() )
+        png_set_swap( png_ptr );
+
+    if( CV_MAT_CN(type) < 4 )
+    {
+        /* observation: png_read_image() writes 400 bytes beyond
+         * end of data when reading a 400x118 color png
+         * "mpplus_sand.png".  OpenCV crashes even with demo
+         * programs.  Looking at the loaded image I'd say we get 4
+         * bytes per pixel instead of 3 bytes per pixel.  Test
+         * indicate that it is a good idea to always ask for
+         * stripping alpha..  18.11.2004 Axel Walthelm
+         */
+         png_set_strip_alpha( png_ptr );
+    } else
+        png_set_tRNS_to_alpha( png_ptr );
+
+    if( m_color_type == PNG_COLOR_TYPE_PALETTE )
+        png_set_palette_to_rgb( png_ptr );
+
+    if( (m_color_type & PNG_COLOR_MASK_COLOR) == 0 && m_bit_depth < 8 )
+#if (PNG_LIBPNG_VER_MAJOR*10000 + PNG_LIBPNG_VER_MINOR*100 + PNG_LIBPNG_VER_RELEASE >= 10209) || \
+    (PNG_LIBPNG_VER_MAJOR == 1 && PNG_LIBPNG_VER_MINOR == 0 && PNG_LIBPNG_VER_RELEASE >= 18)
+        png_set_expand_gray_1_2_4_to_8( png_ptr );
+#else
+        png_set_gray_1_2_4_to_8( png_ptr );
+#endif
+
+    if( (m_color_type & PNG_COLOR_MASK_COLOR) && color )
+        png_set_bgr( png_ptr ); // convert RGB to BGR
+    else if( color )
+        png_set_gray_to_rgb( png_ptr ); // Gray->RGB
+    else
+        png_set_rgb_to_gray( png_ptr, 1, 0.299, 0.587 ); // RGB->Gray
+}
+
 bool  PngDecoder::readData( Mat& img )
 {
     volatile bool result = false;
     AutoBuffer<uchar*> _buffer(m_height);
     uchar** buffer = _buffer.data();
-    bool color = img.channels() > 1;
 
     png_structp png_ptr = (png_structp)m_png_ptr;
     png_infop info_ptr = (png_infop)m_info_ptr;
@@ -231,51 +286,33 @@ bool  PngDecoder::readData( Mat& img )
         {
             int y;
 
-            if( img.depth() == CV_8U && m_bit_depth == 16 )
-                png_set_strip_16( png_ptr );
-            else if( !isBigEndian() )
-                png_set_swap( png_ptr );
+            setTransformations( img.type() );
+            png_set_interlace_handling( png_ptr );
+            png_read_update_info( png_ptr, info_ptr );
 
-            if(img.channels() < 4)
+            if( m_roi.empty() )
             {
-                /* observation: png_read_image() writes 400 bytes beyond
-                 * end of data when reading a 400x118 color png
-                 * "mpplus_sand.png".  OpenCV crashes even with demo
-                 * programs.  Looking at the loaded image I'd say we get 4
-                 * bytes per pixel instead of 3 bytes per pixel.  Test
-                 * indicate that it is a good idea to always ask for
-                 * stripping alpha..  18.11.2004 Axel Walthelm
-                 */
-                 png_set_strip_alpha( png_ptr );
-            } else
-                png_set_tRNS_to_alpha( png_ptr );
-
-            if( m_color_type == PNG_COLOR_TYPE_PALETTE )
-                png_set_palette_to_rgb( png_ptr );
-
-            if( (m_color_type & PNG_COLOR_MASK_COLOR) == 0 && m_bit_depth < 8 )
-#if (PNG_LIBPNG_VER_MAJOR*10000 + PNG_LIBPNG_VER_MINOR*100 + PNG_LIBPNG_VER_RELEASE >= 10209) || \
-    (PNG_LIBPNG_VER_MAJOR == 1 && PNG_LIBPNG_VER_MINOR == 0 && PNG_LIBPNG_VER_RELEASE >= 18)
-                png_set_expand_gray_1_2_4_to_8( png_ptr );
-#else
-                png_set_gray_1_2_4_to_8( png_ptr );
-#endif
+                for( y = 0; y < m_height; y++ )
+                    buffer[y] = img.data + y*img.step;
 
-            if( (m_color_type & PNG_COLOR_MASK_COLOR) && color )
-                png_set_bgr( png_ptr ); // convert RGB to BGR
-            else if( color )
-                png_set_gray_to_rgb( png_ptr ); // Gray->RGB
+                png_read_image( png_ptr, buffer );
+                png_read_end( png_ptr, end_info );
+            }
             else
-                png_set_rgb_to_gray( png_ptr, 1, 0.299, 0.587 ); // RGB->Gray
-
-            png_set_interlace_handling( png_ptr );
-            png_read_update_info( png_ptr, info_ptr );
-
-            for( y = 0; y < m_height; y++ )
-                buffer[y] = img.data + y*img.step;
+            {
+                // rows are decompressed one by one up to the bottom of the region,
+                // the rest of the image is not touched
+                AutoBuffer<uchar> _row(png_get_rowbytes( png_ptr, info_ptr ));
+                uchar* row = _row.data();
+                const size_t xofs = m_roi.x*img.elemSize(), roi_step = m_roi.width*img.elemSize();
 
-            png_read_image( png_ptr, buffer );
-            png_read_end( png_ptr, end_info );
+                for( y = 0; y < m_roi.y + m_roi.height; y++ )
+                {
+                    png_read_row( png_ptr, row, NULL );
+                    if( y >= m_roi.y )
+                        memcpy( img.ptr(y - m_roi.y), row + xofs, roi_step );
+                }
+            }
 
 #ifdef PNG_eXIf_SUPPORTED
             png_uint_32 num_exif = 0;
@@ -284,7 +321,7 @@ bool  PngDecoder::readData( Mat& img )
             // Exif info could be in info_ptr (intro_info) or end_info per specification
             if( png_get_valid(png_ptr, info_ptr, PNG_INFO_eXIf) )
                 png_get_eXIf_1(png_ptr, info_ptr, &num_exif, &exif);
-            else if( png_get_valid(png_ptr, end_info, PNG_INFO_eXIf) )
+            else if( m_roi.empty() && png_get_valid(png_ptr, end_info, PNG_INFO_eXIf) )
                 png_get_eXIf_1(png_ptr, end_info, &num_exif, &exif);
 
             if( exif && num_exif > 0 )
@@ -301,6 +338,48 @@ bool  PngDecoder::readData( Mat& img )
 }
 
 
+bool  PngDecoder::startReadRows( int type )
+{
+    volatile bool result = false;
+    png_structp png_ptr = (png_structp)m_png_ptr;
+    png_infop info_ptr = (png_infop)m_info_ptr;
+
+    // interlaced images can't be decoded row by row
+    if( m_png_ptr && m_info_ptr && m_end_info && m_width && m_height &&
+        png_get_interlace_type( png_ptr, info_ptr ) == PNG_INTERLACE_NONE )
+    {
+        if( setjmp( png_jmpbuf ( png_ptr ) ) == 0 )
+        {
+            setTransformations( type );
+            png_read_update_info( png_ptr, info_ptr );
+            m_next_row = 0;
+            result = true;
+        }
+    }
+
+    return result;
+}
+
+bool  PngDecoder::readRows( Mat& img )
+{
+    volatile bool result = false;
+    png_structp png_ptr = (png_structp)m_png_ptr;
+
+    if( m_png_ptr && m_next_row + img.rows <= m_height )
+    {
+        if( setjmp( png_jmpbuf ( png_ptr ) ) == 0 )
+        {
+            for( int y = 0; y < img.rows; y++ )
+                png_read_row( png_ptr, img.ptr(y), NULL );
+            m_next_row += img.rows;
+            result = true;
+        }
+    }
+
+    return result;
+}
+
+
 /////////////////////// PngEncoder ///////////////////
 
 
@@ -344,6 +423,244 @@ void PngEncoder::flushBuf(void*)
 {
 }
 
+/////////////////////// Parallel IDAT encoding ///////////////////
+
+namespace
+{
+
+// Converts a BGR(A) row to the PNG sample layout: RGB(A) order, big-endian 16-bit samples
+static void packPngRow( const uchar* src, uchar* dst, int width, int cn, bool is16 )
+{
+    static const int bgr2rgb[] = { 2, 1, 0, 3 };
+    if( !is16 )
+    {
+        if( cn < 3 )
+        {
+            memcpy( dst, src, (size_t)width*cn );
+            return;
+        }
+        for( int x = 0; x < width; x++, src += cn, dst += cn )
+            for( int c = 0; c < cn; c++ )
+                dst[c] = src[bgr2rgb[c]];
+    }
+    else
+    {
+        const ushort* s = (const ushort*)src;
+        for( int x = 0; x < width; x++, s += cn, dst += cn*2 )
+            for( int c = 0; c < cn; c++ )
+            {
+                ushort v = s[cn < 3 ? c : bgr2rgb[c]];
+                dst[c*2] = (uchar)(v >> 8);
+                dst[c*2 + 1] = (uchar)v;
+            }
+    }
+}
+
+static inline int paethPredictor( int a, int b, int c )
+{
+    int p = a + b - c;
+    int pa = std::abs(p - a), pb = std::abs(p - b), pc = std::abs(p - c);
+    return pa <= pb && pa <= pc ? a : pb <= pc ? b : c;
+}
+
+static size_t filterPngRow( int filter, const uchar* row, const uchar* prev, uchar* dst, size_t rowbytes, int bpp )
+{
+    size_t i, sum = 0;
+    dst[0] = (uchar)filter;
+    dst++;
+    for( i = 0; i < rowbytes; i++ )
+    {
+        int a = i >= (size_t)bpp ? row[i - bpp] : 0;
+        int b = prev[i];
+        int c = i >= (size_t)bpp ? prev[i - bpp] : 0;
+        int v = row[i];
+        switch( filter )
+        {
+        case PNG_FILTER_VALUE_SUB: v -= a; break;
+        case PNG_FILTER_VALUE_UP: v -= b; break;
+        case PNG_FILTER_VALUE_AVG: v -= (a + b) >> 1; break;
+        case PNG_FILTER_VALUE_PAETH: v -= paethPredictor(a, b, c); break;
+        default: break;
+        }
+        dst[i] = (uchar)v;
+        sum += std::abs((int)(schar)dst[i]);
+    }
+    return sum;
+}
+
+/* Packs and filters rows [y0, y1) of img into dst (rowbytes + 1 bytes per row).
+   With adaptive filtering the filter giving the minimum sum of absolute differences is
+   chosen for each row, which is the heuristic used by libpng itself. */
+static void filterPngRows( const Mat& img, int y0, int y1, bool adaptive, uchar* dst )
+{
+    int cn = img.channels();
+    bool is16 = img.depth() == CV_16U;
+    int bpp = cn*(is16 ? 2 : 1);
+    size_t rowbytes = (size_t)img.cols*bpp;
+
+    AutoBuffer<uchar> _rows(rowbytes*2 + (adaptive ? (rowbytes + 1)*2 : 0));
+    uchar* prev = _rows.data();
+    uchar* row = prev + rowbytes;
+    uchar* best = row + rowbytes;
+    uchar* trial = best + rowbytes + 1;
+
+    if( y0 > 0 )
+        packPngRow( img.ptr(y0 - 1), prev, img.cols, cn, is16 );
+    else
+        memset( prev, 0, rowbytes );
+
+    for( int y = y0; y < y1; y++, dst += rowbytes + 1 )
+    {
+        packPngRow( img.ptr(y), row, img.cols, cn, is16 );
+        if( !adaptive )
+            filterPngRow( PNG_FILTER_VALUE_SUB, row, prev, dst, rowbytes, bpp );
+        else
+        {
+            size_t minSum = filterPngRow( PNG_FILTER_VALUE_NONE, row, prev, best, rowbytes, bpp );
+            for( int f = PNG_FILTER_VALUE_SUB; f <= PNG_FILTER_VALUE_PAETH; f++ )
+            {
+                size_t sum = filterPngRow( f, row, prev, trial, rowbytes, bpp );
+                if( sum < minSum )
+                {
+                    minSum = sum;
+                    std::swap( best, trial );
+                }
+            }
+            memcpy( dst, best, rowbytes + 1 );
+        }
+        std::swap( prev, row );
+    }
+}
+
+/* The image is split into horizontal chunks which are filtered and deflated independently
+   as raw deflate streams. Every chunk except the last one ends with a sync flush, so the
+   compressed chunks can be concatenated into a single valid zlib stream. Each chunk is primed
+   with the last 32K of the preceding filtered data to keep the compression ratio close to
+   the single-threaded one. */
+class PngChunkCompressor : public ParallelLoopBody
+{
+public:
+    PngChunkCompressor( const Mat& img, int nchunks, int level, int strategy, bool adaptive,
+                        std::vector<std::vector<uchar> >& chunks, std::vector<uLong>& adlers )
+        : m_img(img), m_nchunks(nchunks), m_level(level), m_strategy(strategy),
+          m_adaptive(adaptive), m_chunks(chunks), m_adlers(adlers), m_ok(true)
+    {}
+
+    void operator()( const Range& range ) const CV_OVERRIDE
+    {
+        for( int i = range.start; i < range.end; i++ )
+            if( !compress(i) )
+                m_ok = false;
+    }
+
+    bool ok() const { return m_ok; }
+
+protected:
+    bool compress( int i ) const
+    {
+        const int height = m_img.rows;
+        const size_t rowlen = (size_t)m_img.cols*m_img.elemSize() + 1;
+        const size_t windowSize = 1 << MAX_WBITS;
+        int y0 = (int)((int64)height*i/m_nchunks), y1 = (int)((int64)height*(i + 1)/m_nchunks);
+        int ydict = std::max(y0 - (int)((windowSize + rowlen - 1)/rowlen), 0);
+        bool last = i == m_nchunks - 1;
+
+        std::vector<uchar> filtered(rowlen*(y1 - ydict));
+        filterPngRows( m_img, ydict, y1, m_adaptive, filtered.data() );
+        const uchar* data = filtered.data() + rowlen*(y0 - ydict);
+        size_t dictLen = std::min((size_t)(data - filtered.data()), windowSize);
+        size_t len = rowlen*(y1 - y0);
+
+        m_adlers[i] = adler32( adler32(0L, Z_NULL, 0), data, (uInt)len );
+
+        z_stream strm;
+        memset( &strm, 0, sizeof(strm) );
+        if( deflateInit2( &strm, m_level, Z_DEFLATED, -MAX_WBITS, 8, m_strategy ) != Z_OK )
+            return false;
+        bool ok = dictLen == 0 || deflateSetDictionary( &strm, data - dictLen, (uInt)dictLen ) == Z_OK;
+
+        // the first chunk reserves room for the zlib header, the last one for the adler32 trailer
+        size_t prefix = i == 0 ? 2 : 0;
+        std::vector<uchar>& out = m_chunks[i];
+        out.resize( prefix + deflateBound(&strm, (uLong)len) + 16 );
+        strm.next_in = (Bytef*)data;
+        strm.avail_in = (uInt)len;
+        strm.next_out = out.data() + prefix;
+        strm.avail_out = (uInt)(out.size() - prefix);
+
+        while( ok )
+        {
+            int r = deflate( &strm, last ? Z_FINISH : Z_SYNC_FLUSH );
+            if( r == Z_STREAM_ERROR )
+                ok = false;
+            else if( last ? r == Z_STREAM_END : strm.avail_out != 0 )
+                break;
+            else if( strm.avail_out == 0 )
+            {
+                size_t used = out.size();
+                out.resize( used*2 );
+                strm.next_out = out.data() + used;
+                strm.avail_out = (uInt)(out.size() - used);
+            }
+        }
+        out.resize( prefix + strm.total_out + (last ? 4 : 0) );
+        deflateEnd( &strm );
+        return ok;
+    }
+
+    const Mat& m_img;
+    int m_nchunks;
+    int m_level, m_strategy;
+    bool m_adaptive;
+    std::vector<std::vector<uchar> >& m_chunks;
+    std::vector<uLong>& m_adlers;
+    mutable volatile bool m_ok;
+};
+
+// Writes the IDAT chunks of img using nthreads threads; the IHDR must be already written
+static bool writePngDataParallel( png_structp png_ptr, const Mat& img, int nthreads,
+                                  int level, int strategy, bool adaptive )
+{
+    const int minRowsPerChunk = 16;
+    int nchunks = std::max(std::min(nthreads, img.rows / minRowsPerChunk), 1);
+
+    std::vector<std::vector<uchar> > chunks(nchunks);
+    std::vector<uLong> adlers(nchunks);
+    PngChunkCompressor body( img, nchunks, level, strategy, adaptive, chunks, adlers );
+    parallel_for_( Range(0, nchunks), body, nchunks );
+    if( !body.ok() )
+        return false;
+
+    // zlib header (RFC 1950): deflate with a 32K window and the matching FLEVEL hint
+    int flevel = level < 2 || strategy >= Z_HUFFMAN_ONLY ? 0 : level < 6 ? 1 : level == 6 ? 2 : 3;
+    int cmf = 0x78, flg = flevel << 6;
+    flg += 31 - (cmf*256 + flg) % 31;
+    chunks[0][0] = (uchar)cmf;
+    chunks[0][1] = (uchar)flg;
+
+    const size_t rowlen = (size_t)img.cols*img.elemSize() + 1;
+    uLong adler = adlers[0];
+    for( int i = 1; i < nchunks; i++ )
+    {
+        int y0 = (int)((int64)img.rows*i/nchunks), y1 = (int)((int64)img.rows*(i + 1)/nchunks);
+        adler = adler32_combine( adler, adlers[i], (z_off_t)(rowlen*(y1 - y0)) );
+    }
+    uchar* trailer = &chunks.back().back() - 3;
+    for( int k = 0; k < 4; k++ )
+        trailer[k] = (uchar)(adler >> (24 - k*8));
+
+    const size_t maxChunkSize = (size_t)1 << 30;
+    for( int i = 0; i < nchunks; i++ )
+    {
+        for( size_t ofs = 0; ofs < chunks[i].size(); ofs += maxChunkSize )
+            png_write_chunk( png_ptr, (png_const_bytep)"IDAT", chunks[i].data() + ofs,
+                             std::min(chunks[i].size() - ofs, maxChunkSize) );
+    }
+    return true;
+}
+
+}
+
 bool  PngEncoder::write( const Mat& img, const std::vector<int>& params )
 {
     png_structp png_ptr = png_create_write_struct( PNG_LIBPNG_VER_STRING, 0, 0, 0 );
@@ -380,6 +697,7 @@ bool  PngEncoder::write( const Mat& img, const std::vector<int>& params )
                 int compression_level = -1; // Invalid value to allow setting 0-9 as valid
                 int compression_strategy = IMWRITE_PNG_STRATEGY_RLE; // Default strategy
                 bool isBilevel = false;
+                int nthreads = 1;
 
                 for( size_t i = 0; i < params.size(); i += 2 )
                 {
@@ -398,6 +716,10 @@ bool  PngEncoder::write( const Mat& img, const std::vector<int>& params )
                     {
                         isBilevel = params[i+1] != 0;
                     }
+                    if( params[i] == IMWRITE_PNG_THREADS )
+                    {
+                        nthreads = params[i+1] > 0 ? params[i+1] : getNumThreads();
+                    }
                 }
 
                 if( m_buf || f )
@@ -423,21 +745,34 @@ bool  PngEncoder::write( const Mat& img, const std::vector<int>& params )
 
                     png_write_info( png_ptr, info_ptr );
 
-                    if (isBilevel)
-                        png_set_packing(png_ptr);
+                    if( nthreads > 1 && !isBilevel )
+                    {
+                        // IDAT is produced here, so the image trailer is written directly
+                        // instead of png_write_end(), which expects libpng to write the rows
+                        result = writePngDataParallel( png_ptr, img, nthreads,
+                                                       compression_level >= 0 ? compression_level : Z_BEST_SPEED,
+                                                       compression_strategy, compression_level >= 0 );
+                        if( result )
+                            png_write_chunk( png_ptr, (png_const_bytep)"IEND", NULL, 0 );
+                    }
+                    else
+                    {
+                        if (isBilevel)
+                            png_set_packing(png_ptr);
 
-                    png_set_bgr( png_ptr );
-                    if( !isBigEndian() )
-                        png_set_swap( png_ptr );
+                        png_set_bgr( png_ptr );
+                        if( !isBigEndian() )
+                            png_set_swap( png_ptr );
 
-                    buffer.allocate(height);
-                    for( y = 0; y < height; y++ )
-                        buffer[y] = img.data + y*img.step;
+                        buffer.allocate(height);
+                        for( y = 0; y < height; y++ )
+                            buffer[y] = img.data + y*img.step;
 
-                    png_write_image( png_ptr, buffer.data() );
-                    png_write_end( png_ptr, info_ptr );
+                        png_write_image( png_ptr, buffer.data() );
+                        png_write_end( png_ptr, info_ptr );
 
-                    result = true;
+                        result = true;
+                    }
                 }
             }
         }
@@ -60,6 +60,10 @@ public:
 
     bool  readData( Mat& img ) CV_OVERRIDE;
     bool  readHeader() CV_OVERRIDE;
+    bool  setRegion( const Rect& roi ) CV_OVERRIDE;
+    bool  startReadRows( int type ) CV_OVERRIDE;
+    bool  readRows( Mat& img ) CV_OVERRIDE;
+    bool  isReusable() const CV_OVERRIDE { return true; }
     void  close();
 
     ImageDecoder newDecoder() const CV_OVERRIDE;
@@ -67,6 +71,7 @@ public:
 protected:
 
     static void readDataFromBuf(void* png_ptr, uchar* dst, size_t size);
+    void  setTransformations( int type );
 
     int   m_bit_depth;
     void* m_png_ptr;  // pointer to decompression structure
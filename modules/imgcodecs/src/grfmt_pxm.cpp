@@ -206,6 +206,23 @@ bool PxMDecoder::readHeader()
 
 
 bool PxMDecoder::readData( Mat& img )
+{
+    return startReadRows( img.type() ) && readRows( img );
+}
+
+
+bool PxMDecoder::startReadRows( int )
+{
+    if( m_offset < 0 || !m_strm.isOpened())
+        return false;
+
+    m_strm.setPos( m_offset );
+    m_next_row = 0;
+    return true;
+}
+
+
+bool PxMDecoder::readRows( Mat& img )
 {
     bool color = img.channels() > 1;
     uchar* data = img.ptr();
@@ -216,7 +233,7 @@ bool PxMDecoder::readData( Mat& img )
     int  nch = CV_MAT_CN(m_type);
     int  width3 = m_width*nch;
 
-    if( m_offset < 0 || !m_strm.isOpened())
+    if( m_offset < 0 || !m_strm.isOpened() || m_next_row + img.rows > m_height )
         return false;
 
     uchar gray_palette[256] = {0};
@@ -234,8 +251,6 @@ bool PxMDecoder::readData( Mat& img )
 
     try
     {
-        m_strm.setPos( m_offset );
-
         switch( m_bpp )
         {
         ////////////////////////// 1 BPP /////////////////////////
@@ -246,7 +261,7 @@ bool PxMDecoder::readData( Mat& img )
                 AutoBuffer<uchar> _src(m_width);
                 uchar* src = _src.data();
 
-                for (int y = 0; y < m_height; y++, data += img.step)
+                for (int y = 0; y < img.rows; y++, data += img.step)
                 {
                     for (int x = 0; x < m_width; x++)
                         src[x] = ReadNumber(m_strm, 1) != 0;
@@ -262,7 +277,7 @@ bool PxMDecoder::readData( Mat& img )
                 AutoBuffer<uchar> _src(src_pitch);
                 uchar* src = _src.data();
 
-                for (int y = 0; y < m_height; y++, data += img.step)
+                for (int y = 0; y < img.rows; y++, data += img.step)
                 {
                     m_strm.getBytes( src, src_pitch );
 
@@ -282,7 +297,7 @@ bool PxMDecoder::readData( Mat& img )
             AutoBuffer<uchar> _src(std::max<size_t>(width3*2, src_pitch));
             uchar* src = _src.data();
 
-            for (int y = 0; y < m_height; y++, data += img.step)
+            for (int y = 0; y < img.rows; y++, data += img.step)
             {
                 if( !m_binary )
                 {
@@ -368,6 +383,8 @@ bool PxMDecoder::readData( Mat& img )
         throw;
     }
 
+    if( result )
+        m_next_row += img.rows;
     return result;
 }
 
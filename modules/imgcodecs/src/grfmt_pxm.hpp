@@ -68,6 +68,8 @@ public:
 
     bool  readData( Mat& img ) CV_OVERRIDE;
     bool  readHeader() CV_OVERRIDE;
+    bool  startReadRows( int type ) CV_OVERRIDE;
+    bool  readRows( Mat& img ) CV_OVERRIDE;
     void  close();
 
     size_t signatureLength() const CV_OVERRIDE;
@@ -114,12 +114,18 @@ TiffDecoder::TiffDecoder()
     m_hdr = false;
     m_buf_supported = true;
     m_buf_pos = 0;
+    m_page = 0;
+    m_keep_band = false;
 }
 
 
 void TiffDecoder::close()
 {
     m_tif.release();
+    m_roi = Rect();
+    m_page = 0;
+    m_page_ifd.clear();
+    m_band.release();
 }
 
 TiffDecoder::~TiffDecoder()
@@ -256,6 +262,8 @@ bool TiffDecoder::readHeader()
             m_tif.reset(tif, cv_tiffCloseHandle);
         else
             m_tif.release();
+        m_page = 0;
+        m_page_ifd.clear();
     }
 
     if (tif)
@@ -369,9 +377,112 @@ bool TiffDecoder::readHeader()
 bool TiffDecoder::nextPage()
 {
     // Prepare the next page, if any.
-    return !m_tif.empty() &&
-           TIFFReadDirectory(static_cast<TIFF*>(m_tif.get())) &&
-           readHeader();
+    if (m_tif.empty() || !TIFFReadDirectory(static_cast<TIFF*>(m_tif.get())))
+        return false;
+    m_page++;
+    return readHeader();
+}
+
+// Walks the IFD chain once and remembers the offset of every directory, so any page can be selected
+// later by TIFFSetSubDirectory() without reading the preceding directories again.
+bool TiffDecoder::buildPageIndex()
+{
+    TIFF* tif = static_cast<TIFF*>(m_tif.get());
+    if (!tif)
+        return false;
+    if (!m_page_ifd.empty())
+        return true;
+
+    std::vector<uint64_t> offsets;
+    if (!TIFFSetDirectory(tif, 0))
+        return false;
+    do
+    {
+        offsets.push_back((uint64_t)TIFFCurrentDirOffset(tif));
+    }
+    while (TIFFReadDirectory(tif));
+
+    if (m_page >= (int)offsets.size() || !TIFFSetSubDirectory(tif, (toff_t)offsets[m_page]))
+    {
+        CV_LOG_WARNING(NULL, "TIFF: can't select directory " << m_page << " by offset, random page access is disabled");
+        TIFFSetDirectory(tif, (tdir_t)m_page);
+        return false;
+    }
+    m_page_ifd.swap(offsets);
+    return true;
+}
+
+int TiffDecoder::pageCount()
+{
+    return buildPageIndex() ? (int)m_page_ifd.size() : -1;
+}
+
+bool TiffDecoder::setPage(int index)
+{
+    if (!buildPageIndex() || index < 0 || index >= (int)m_page_ifd.size())
+        return false;
+    if (index != m_page)
+    {
+        if (!TIFFSetSubDirectory(static_cast<TIFF*>(m_tif.get()), (toff_t)m_page_ifd[index]))
+            return false;
+        m_page = index;
+    }
+    m_roi = Rect();
+    return readHeader();
+}
+
+bool TiffDecoder::setRegion( const Rect& roi )
+{
+    TIFF* tif = static_cast<TIFF*>(m_tif.get());
+    if (!tif || m_hdr)
+        return false;
+
+    // tiles (strips) are picked in the stored order, so the orientation fix-up must be a no-op
+    uint16_t img_orientation = ORIENTATION_TOPLEFT;
+    CV_TIFF_CHECK_CALL_DEBUG(TIFFGetField(tif, TIFFTAG_ORIENTATION, &img_orientation));
+    if (img_orientation != ORIENTATION_TOPLEFT)
+        return false;
+
+    m_roi = roi;
+    m_keep_band = false;
+    return true;
+}
+
+bool TiffDecoder::startReadRows( int )
+{
+    // strips (tile rows) are decoded one at a time and kept until all their rows are read
+    m_next_row = 0;
+    m_band.release();
+    return setRegion(Rect(0, 0, m_width, m_height));
+}
+
+bool TiffDecoder::readRows( Mat& img )
+{
+    if (m_roi.empty() || m_next_row + img.rows > m_height)
+        return false;
+
+    for (int y = 0; y < img.rows; )
+    {
+        const int row = m_next_row + y;
+        if (m_band.empty() || row < m_band_rect.y || row >= m_band_rect.y + m_band_rect.height)
+        {
+            // decoding a single row region leaves the whole strip containing it in m_band
+            Mat first_row(1, m_width, img.type());
+            m_roi = Rect(0, row, m_width, 1);
+            m_keep_band = true;
+            const bool ok = readData(first_row);
+            m_keep_band = false;
+            if (!ok || m_band.empty())
+                return false;
+        }
+        const int n = std::min(img.rows - y, m_band_rect.y + m_band_rect.height - row);
+        m_band.rowRange(row - m_band_rect.y, row - m_band_rect.y + n).copyTo(img.rowRange(y, y + n));
+        y += n;
+    }
+    m_next_row += img.rows;
+    if (m_next_row >= m_band_rect.y + m_band_rect.height)
+        m_band.release();
+    return true;
 }
 
 static void fixOrientationPartial(Mat &img, uint16_t orientation)
@@ -784,21 +895,34 @@ bool  TiffDecoder::readData( Mat& img )
                            "src_buffer_size is smaller than TIFFScanlineSize().");
             }
 
-            int tileidx = 0;
+            // only the tiles (strips) intersecting the region are decoded, into a tile-aligned buffer
+            Rect tiles_rect(0, 0, m_width, m_height);
+            Mat tiles_img = img;
+            if (!m_roi.empty())
+            {
+                const int x0 = m_roi.x - m_roi.x % (int)tile_width0;
+                const int y0 = m_roi.y - m_roi.y % (int)tile_height0;
+                const int x1 = std::min(m_width, (int)divUp(m_roi.x + m_roi.width, tile_width0) * (int)tile_width0);
+                const int y1 = std::min(m_height, (int)divUp(m_roi.y + m_roi.height, tile_height0) * (int)tile_height0);
+                tiles_rect = Rect(x0, y0, x1 - x0, y1 - y0);
+                tiles_img.create(tiles_rect.size(), img.type());
+            }
 
             #define MAKE_FLAG(a,b) ( (a << 8) | b )
             const int  convert_flag = MAKE_FLAG( ncn, wanted_channels );
             const bool isNeedConvert16to8 = ( doReadScanline ) && ( bpp == 16 ) && ( dst_bpp == 8);
 
-            for (int y = 0; y < m_height; y += (int)tile_height0)
+            for (int y = tiles_rect.y; y < tiles_rect.y + tiles_rect.height; y += (int)tile_height0)
             {
                 int tile_height = std::min((int)tile_height0, m_height - y);
 
-                const int img_y = vert_flip ? m_height - y - tile_height : y;
+                const int img_y = (vert_flip ? m_height - y - tile_height : y) - tiles_rect.y;
 
-                for(int x = 0; x < m_width; x += (int)tile_width0, tileidx++)
+                for(int x = tiles_rect.x; x < tiles_rect.x + tiles_rect.width; x += (int)tile_width0)
                 {
                     int tile_width = std::min((int)tile_width0, m_width - x);
+                    const int img_x = x - tiles_rect.x;
+                    const int tileidx = (int)(is_tiled ? TIFFComputeTile(tif, x, y, 0, 0) : TIFFComputeStrip(tif, y, 0));
 
                     switch (dst_bpp)
                     {
@@ -838,7 +962,7 @@ bool  TiffDecoder::readData( Mat& img )
                                 bstart += (tile_height0 - tile_height) * tile_width0 * 4;
                             }
 
-                            uchar* img_line_buffer = (uchar*) img.ptr(y, 0);
+                            uchar* img_line_buffer = (uchar*) tiles_img.ptr(y - tiles_rect.y, 0);
 
                             for (int i = 0; i < tile_height; i++)
                             {
@@ -901,14 +1025,14 @@ bool  TiffDecoder::readData( Mat& img )
                                     if (wanted_channels == 4)
                                     {
                                         icvCvt_BGRA2RGBA_8u_C4R(bstart + i*tile_width0*4, 0,
-                                                img.ptr(img_y + tile_height - i - 1, x), 0,
+                                                tiles_img.ptr(img_y + tile_height - i - 1, img_x), 0,
                                                 Size(tile_width, 1) );
                                     }
                                     else
                                     {
                                         CV_CheckEQ(wanted_channels, 3, "TIFF-8bpp: BGR/BGRA images are supported only");
                                         icvCvt_BGRA2BGR_8u_C4C3R(bstart + i*tile_width0*4, 0,
-                                                img.ptr(img_y + tile_height - i - 1, x), 0,
+                                                tiles_img.ptr(img_y + tile_height - i - 1, img_x), 0,
                                                 Size(tile_width, 1), 2);
                                     }
                                 }
@@ -916,7 +1040,7 @@ bool  TiffDecoder::readData( Mat& img )
                                 {
                                     CV_CheckEQ(wanted_channels, 1, "");
                                     icvCvt_BGRA2Gray_8u_C4C1R( bstart + i*tile_width0*4, 0,
-                                            img.ptr(img_y + tile_height - i - 1, x), 0,
+                                            tiles_img.ptr(img_y + tile_height - i - 1, img_x), 0,
                                             Size(tile_width, 1), 2);
                                 }
                             }
@@ -966,14 +1090,14 @@ bool  TiffDecoder::readData( Mat& img )
                                     {
                                         CV_CheckEQ(wanted_channels, 3, "");
                                         icvCvt_Gray2BGR_16u_C1C3R(buffer16, 0,
-                                                img.ptr<ushort>(img_y + i, x), 0,
+                                                tiles_img.ptr<ushort>(img_y + i, img_x), 0,
                                                 Size(tile_width, 1));
                                     }
                                     else if (ncn == 3)
                                     {
                                         CV_CheckEQ(wanted_channels, 3, "");
                                         icvCvt_RGB2BGR_16u_C3R(buffer16, 0,
-                                                img.ptr<ushort>(img_y + i, x), 0,
+                                                tiles_img.ptr<ushort>(img_y + i, img_x), 0,
                                                 Size(tile_width, 1));
                                     }
                                     else if (ncn == 4)
@@ -981,14 +1105,14 @@ bool  TiffDecoder::readData( Mat& img )
                                         if (wanted_channels == 4)
                                         {
                                             icvCvt_BGRA2RGBA_16u_C4R(buffer16, 0,
-                                                img.ptr<ushort>(img_y + i, x), 0,
+                                                tiles_img.ptr<ushort>(img_y + i, img_x), 0,
                                                 Size(tile_width, 1));
                                         }
                                         else
                                         {
                                             CV_CheckEQ(wanted_channels, 3, "TIFF-16bpp: BGR/BGRA images are supported only");
                                             icvCvt_BGRA2BGR_16u_C4C3R(buffer16, 0,
-                                                img.ptr<ushort>(img_y + i, x), 0,
+                                                tiles_img.ptr<ushort>(img_y + i, img_x), 0,
                                                 Size(tile_width, 1), 2);
                                         }
                                     }
@@ -1002,14 +1126,14 @@ bool  TiffDecoder::readData( Mat& img )
                                     CV_CheckEQ(wanted_channels, 1, "");
                                     if( ncn == 1 )
                                     {
-                                        memcpy(img.ptr<ushort>(img_y + i, x),
+                                        memcpy(tiles_img.ptr<ushort>(img_y + i, img_x),
                                                buffer16,
                                                tile_width*sizeof(ushort));
                                     }
                                     else
                                     {
                                         icvCvt_BGRA2Gray_16u_CnC1R(buffer16, 0,
-                                                img.ptr<ushort>(img_y + i, x), 0,
+                                                tiles_img.ptr<ushort>(img_y + i, img_x), 0,
                                                 Size(tile_width, 1), ncn, 2);
                                     }
                                 }
@@ -1031,13 +1155,13 @@ bool  TiffDecoder::readData( Mat& img )
 
                             Mat m_tile(Size(tile_width0, tile_height0), CV_MAKETYPE((dst_bpp == 32) ? (depth == CV_32S ? CV_32S : CV_32F) : CV_64F, ncn), src_buffer);
                             Rect roi_tile(0, 0, tile_width, tile_height);
-                            Rect roi_img(x, img_y, tile_width, tile_height);
+                            Rect roi_img(img_x, img_y, tile_width, tile_height);
                             if (!m_hdr && ncn == 3)
-                                extend_cvtColor(m_tile(roi_tile), img(roi_img), COLOR_RGB2BGR);
+                                extend_cvtColor(m_tile(roi_tile), tiles_img(roi_img), COLOR_RGB2BGR);
                             else if (!m_hdr && ncn == 4)
-                                extend_cvtColor(m_tile(roi_tile), img(roi_img), COLOR_RGBA2BGRA);
+                                extend_cvtColor(m_tile(roi_tile), tiles_img(roi_img), COLOR_RGBA2BGRA);
                             else
-                                m_tile(roi_tile).copyTo(img(roi_img));
+                                m_tile(roi_tile).copyTo(tiles_img(roi_img));
                             break;
                         }
                         default:
@@ -1047,9 +1171,20 @@ bool  TiffDecoder::readData( Mat& img )
                     }  // switch (dst_bpp)
                 }  // for x
             }  // for y
+
+            if (bpp < dst_bpp)
+                tiles_img *= (1<<(dst_bpp-bpp));
+
+            if (!m_roi.empty())
+            {
+                tiles_img(Rect(m_roi.tl() - tiles_rect.tl(), m_roi.size())).copyTo(img);
+                if (m_keep_band)
+                {
+                    m_band = tiles_img;
+                    m_band_rect = tiles_rect;
+                }
+            }
         }
-        if (bpp < dst_bpp)
-          img *= (1<<(dst_bpp-bpp));
 
         // If TIFFReadRGBA* function is used -> fixOrientationPartial().
         // Otherwise                         -> fixOrientationFull().
@@ -1188,6 +1323,179 @@ static bool readParam(const std::vector<int>& params, int key, int& value)
     return false;
 }
 
+// converts row y of img to the TIFF sample layout (RGB(A) channel order)
+static void packTiffRow(const Mat& img, int y, uchar* buffer, size_t scanlineSize)
+{
+    Mat m_buffer(Size(img.cols, 1), img.type(), buffer, scanlineSize);
+    switch (img.channels())
+    {
+        case 1:
+        {
+            memcpy(buffer, img.ptr(y), scanlineSize);
+            break;
+        }
+
+        case 3:
+        {
+            extend_cvtColor(img(Rect(0, y, img.cols, 1)), (const Mat&)m_buffer, COLOR_BGR2RGB);
+            break;
+        }
+
+        case 4:
+        {
+            extend_cvtColor(img(Rect(0, y, img.cols, 1)), (const Mat&)m_buffer, COLOR_BGRA2RGBA);
+            break;
+        }
+
+        default:
+        {
+            CV_Assert(0);
+        }
+    }
+}
+
+struct TiffStripFormat
+{
+    uint16_t bitsPerSample, compression, photometric, samplesPerPixel, sampleFormat, predictor;
+    int rowsPerStrip;
+};
+
+/*
+  Compresses groups of consecutive strips independently. Each group is encoded into a scratch
+  in-memory TIFF with the same layout, and the encoded strips are read back as raw data,
+  so the destination file receives exactly what libtiff would produce for these strips.
+*/
+class TiffStripCompressor : public ParallelLoopBody
+{
+public:
+    TiffStripCompressor(const Mat& img, const TiffStripFormat& fmt, int ngroups,
+                        std::vector<std::vector<uchar> >& strips)
+        : m_img(img), m_fmt(fmt), m_ngroups(ngroups), m_strips(strips), m_ok(true)
+    {}
+
+    void operator()(const Range& range) const CV_OVERRIDE
+    {
+        for (int g = range.start; g < range.end; g++)
+        {
+            bool ok = false;
+            try
+            {
+                ok = compress(g);
+            }
+            catch (const cv::Exception&)
+            {
+            }
+            if (!ok)
+                m_ok = false;
+        }
+    }
+
+    bool ok() const { return m_ok; }
+
+protected:
+    bool compress(int g) const
+    {
+        const int nstrips = (int)m_strips.size();
+        const int s0 = nstrips * g / m_ngroups, s1 = nstrips * (g + 1) / m_ngroups;
+        const int y0 = s0 * m_fmt.rowsPerStrip, y1 = std::min(s1 * m_fmt.rowsPerStrip, m_img.rows);
+
+        std::vector<uchar> mem;
+        {
+            TiffEncoderBufHelper buf_helper(&mem);
+            TIFF* tif = buf_helper.open();
+            if (!tif)
+                return false;
+            cv::Ptr<void> tif_cleanup(tif, cv_tiffCloseHandle);
+
+            if (!TIFFSetField(tif, TIFFTAG_IMAGEWIDTH, m_img.cols) ||
+                !TIFFSetField(tif, TIFFTAG_IMAGELENGTH, y1 - y0) ||
+                !TIFFSetField(tif, TIFFTAG_BITSPERSAMPLE, m_fmt.bitsPerSample) ||
+                !TIFFSetField(tif, TIFFTAG_COMPRESSION, m_fmt.compression) ||
+                !TIFFSetField(tif, TIFFTAG_PHOTOMETRIC, m_fmt.photometric) ||
+                !TIFFSetField(tif, TIFFTAG_SAMPLESPERPIXEL, m_fmt.samplesPerPixel) ||
+                !TIFFSetField(tif, TIFFTAG_PLANARCONFIG, PLANARCONFIG_CONTIG) ||
+                !TIFFSetField(tif, TIFFTAG_ROWSPERSTRIP, m_fmt.rowsPerStrip) ||
+                !TIFFSetField(tif, TIFFTAG_SAMPLEFORMAT, m_fmt.sampleFormat) ||
+                (m_fmt.compression != COMPRESSION_PACKBITS && !TIFFSetField(tif, TIFFTAG_PREDICTOR, m_fmt.predictor)))
+                return false;
+
+            size_t scanlineSize = TIFFScanlineSize(tif);
+            AutoBuffer<uchar> _buffer(scanlineSize * m_fmt.rowsPerStrip + 32);
+            uchar* buffer = _buffer.data();
+            for (int s = s0; s < s1; s++)
+            {
+                int ys = s * m_fmt.rowsPerStrip, ye = std::min(ys + m_fmt.rowsPerStrip, y1);
+                for (int y = ys; y < ye; y++)
+                    packTiffRow(m_img, y, buffer + (y - ys) * scanlineSize, scanlineSize);
+                if (TIFFWriteEncodedStrip(tif, s - s0, buffer, (tmsize_t)(scanlineSize * (ye - ys))) == (tmsize_t)-1)
+                    return false;
+            }
+        }
+
+        Mat src(1, (int)mem.size(), CV_8U, mem.data());
+        size_t src_pos = 0;
+        TiffDecoderBufHelper* buf_helper = new TiffDecoderBufHelper(src, src_pos);
+        TIFF* tif = TIFFClientOpen("", "r", reinterpret_cast<thandle_t>(buf_helper), &TiffDecoderBufHelper::read,
+                                   &TiffDecoderBufHelper::write, &TiffDecoderBufHelper::seek,
+                                   &TiffDecoderBufHelper::close, &TiffDecoderBufHelper::size,
+                                   &TiffDecoderBufHelper::map, /*unmap=*/0);
+        if (!tif)
+        {
+            delete buf_helper;
+            return false;
+        }
+        cv::Ptr<void> tif_cleanup(tif, cv_tiffCloseHandle);
+
+        for (int s = s0; s < s1; s++)
+        {
+            tmsize_t size = TIFFRawStripSize(tif, s - s0);
+            if (size <= 0)
+                return false;
+            m_strips[s].resize((size_t)size);
+            if (TIFFReadRawStrip(tif, s - s0, m_strips[s].data(), size) != size)
+                return false;
+        }
+        return true;
+    }
+
+    const Mat& m_img;
+    TiffStripFormat m_fmt;
+    int m_ngroups;
+    std::vector<std::vector<uchar> >& m_strips;
+    mutable volatile bool m_ok;
+};
+
+// writes the strips of the current directory, compressing them with nthreads threads
+static bool writeStripsParallel(TIFF* tif, const Mat& img, int rowsPerStrip, int nthreads)
+{
+    TiffStripFormat fmt;
+    fmt.rowsPerStrip = rowsPerStrip;
+    CV_TIFF_CHECK_CALL(TIFFGetFieldDefaulted(tif, TIFFTAG_BITSPERSAMPLE, &fmt.bitsPerSample));
+    CV_TIFF_CHECK_CALL(TIFFGetFieldDefaulted(tif, TIFFTAG_COMPRESSION, &fmt.compression));
+    CV_TIFF_CHECK_CALL(TIFFGetFieldDefaulted(tif, TIFFTAG_PHOTOMETRIC, &fmt.photometric));
+    CV_TIFF_CHECK_CALL(TIFFGetFieldDefaulted(tif, TIFFTAG_SAMPLESPERPIXEL, &fmt.samplesPerPixel));
+    CV_TIFF_CHECK_CALL(TIFFGetFieldDefaulted(tif, TIFFTAG_SAMPLEFORMAT, &fmt.sampleFormat));
+    fmt.predictor = PREDICTOR_NONE;
+    if (fmt.compression != COMPRESSION_PACKBITS)
+    {
+        CV_TIFF_CHECK_CALL(TIFFGetFieldDefaulted(tif, TIFFTAG_PREDICTOR, &fmt.predictor));
+    }
+
+    int nstrips = (img.rows + rowsPerStrip - 1) / rowsPerStrip;
+    int ngroups = std::min(nthreads, nstrips);
+    std::vector<std::vector<uchar> > strips(nstrips);
+    TiffStripCompressor body(img, fmt, ngroups, strips);
+    parallel_for_(Range(0, ngroups), body, ngroups);
+    if (!body.ok())
+        return false;
+
+    for (int s = 0; s < nstrips; s++)
+    {
+        CV_TIFF_CHECK_CALL(TIFFWriteRawStrip(tif, s, strips[s].data(), (tmsize_t)strips[s].size()) != (tmsize_t)-1);
+    }
+    return true;
+}
+
 bool TiffEncoder::writeLibTiff( const std::vector<Mat>& img_vec, const std::vector<int>& params)
 {
     // do NOT put "wb" as the mode, because the b means "big endian" mode, not "binary" mode.
@@ -1213,12 +1521,16 @@ bool TiffEncoder::writeLibTiff( const std::vector<Mat>& img_vec, const std::vect
     int compression = COMPRESSION_LZW;
     int predictor = PREDICTOR_HORIZONTAL;
     int resUnit = -1, dpiX = -1, dpiY = -1;
+    int nthreads = 1;
 
     readParam(params, IMWRITE_TIFF_COMPRESSION, compression);
     readParam(params, IMWRITE_TIFF_PREDICTOR, predictor);
     readParam(params, IMWRITE_TIFF_RESUNIT, resUnit);
     readParam(params, IMWRITE_TIFF_XDPI, dpiX);
     readParam(params, IMWRITE_TIFF_YDPI, dpiY);
+    readParam(params, IMWRITE_TIFF_THREADS, nthreads);
+    if (nthreads <= 0)
+        nthreads = getNumThreads();
 
     //Iterate through each image in the vector and write them out as Tiff directories
     for (size_t page = 0; page < img_vec.size(); page++)
@@ -1336,40 +1648,24 @@ bool TiffEncoder::writeLibTiff( const std::vector<Mat>& img_vec, const std::vect
             CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_YRESOLUTION, (float)dpiY));
         }
 
+        if (nthreads > 1 && height > rowsPerStrip &&
+            (page_compression == COMPRESSION_LZW || page_compression == COMPRESSION_ADOBE_DEFLATE ||
+             page_compression == COMPRESSION_DEFLATE || page_compression == COMPRESSION_PACKBITS))
+        {
+            if (!writeStripsParallel(tif, img, rowsPerStrip, nthreads))
+                return false;
+            CV_TIFF_CHECK_CALL(TIFFWriteDirectory(tif));
+            continue;
+        }
+
         // row buffer, because TIFFWriteScanline modifies the original data!
         size_t scanlineSize = TIFFScanlineSize(tif);
         AutoBuffer<uchar> _buffer(scanlineSize + 32);
         uchar* buffer = _buffer.data(); CV_DbgAssert(buffer);
-        Mat m_buffer(Size(width, 1), CV_MAKETYPE(depth, channels), buffer, (size_t)scanlineSize);
 
         for (int y = 0; y < height; ++y)
         {
-            switch (channels)
-            {
-                case 1:
-                {
-                    memcpy(buffer, img.ptr(y), scanlineSize);
-                    break;
-                }
-
-                case 3:
-                {
-                    extend_cvtColor(img(Rect(0, y, width, 1)), (const Mat&)m_buffer, COLOR_BGR2RGB);
-                    break;
-                }
-
-                case 4:
-                {
-                    extend_cvtColor(img(Rect(0, y, width, 1)), (const Mat&)m_buffer, COLOR_BGRA2RGBA);
-                    break;
-                }
-
-                default:
-                {
-                    CV_Assert(0);
-                }
-            }
-
+            packTiffRow(img, y, buffer, scanlineSize);
             CV_TIFF_CHECK_CALL(TIFFWriteScanline(tif, buffer, y, 0) == 1);
         }
 
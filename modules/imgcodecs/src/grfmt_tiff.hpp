@@ -98,8 +98,13 @@ public:
 
     bool  readHeader() CV_OVERRIDE;
     bool  readData( Mat& img ) CV_OVERRIDE;
+    bool  setRegion( const Rect& roi ) CV_OVERRIDE;
+    bool  startReadRows( int type ) CV_OVERRIDE;
+    bool  readRows( Mat& img ) CV_OVERRIDE;
     void  close();
     bool  nextPage() CV_OVERRIDE;
+    int   pageCount() CV_OVERRIDE;
+    bool  setPage( int index ) CV_OVERRIDE;
 
     size_t signatureLength() const CV_OVERRIDE;
     bool checkSignature( const String& signature ) const CV_OVERRIDE;
@@ -108,8 +113,14 @@ public:
 protected:
     cv::Ptr<void> m_tif;
     int normalizeChannelsNumber(int channels) const;
+    bool buildPageIndex();
     bool m_hdr;
     size_t m_buf_pos;
+    int m_page;                      // index of the current directory
+    std::vector<uint64_t> m_page_ifd;  // offsets of all directories, filled on the first random access
+    Mat m_band;                      // decoded strip (tile row) kept between readRows() calls
+    Rect m_band_rect;                // position of m_band in the image
+    bool m_keep_band;                // readData() saves the decoded strips into m_band
 
 private:
     TiffDecoder(const TiffDecoder &); // copy disabled
@@ -69,6 +69,7 @@ WebPDecoder::WebPDecoder()
     m_buf_supported = true;
     channels = 0;
     fs_size = 0;
+    use_scaling = false;
 }
 
 WebPDecoder::~WebPDecoder() {}
@@ -103,6 +104,7 @@ ImageDecoder WebPDecoder::newDecoder() const
 bool WebPDecoder::readHeader()
 {
     uint8_t header[WEBP_HEADER_SIZE] = { 0 };
+    use_scaling = false;
     if (m_buf.empty())
     {
         fs.open(m_filename.c_str(), std::ios::binary);
@@ -148,6 +150,25 @@ bool WebPDecoder::readHeader()
     return false;
 }
 
+void WebPDecoder::releaseSource()
+{
+    BaseImageDecoder::releaseSource();
+    data.release();
+}
+
+bool WebPDecoder::setTargetSize(const Size& size)
+{
+    // libwebp rescales to any size while decoding, the aspect ratio is kept
+    const double scale = std::max((double)size.width / m_width, (double)size.height / m_height);
+    if (size.width <= 0 || size.height <= 0 || scale >= 1.)
+        return false;
+
+    m_width = std::max(cvCeil(m_width * scale), 1);
+    m_height = std::max(cvCeil(m_height * scale), 1);
+    use_scaling = true;
+    return true;
+}
+
 bool WebPDecoder::readData(Mat &img)
 {
     CV_CheckGE(m_width, 0, ""); CV_CheckGE(m_height, 0, "");
@@ -181,7 +202,23 @@ bool WebPDecoder::readData(Mat &img)
         size_t out_data_size = read_img.dataend - out_data;
 
         uchar *res_ptr = NULL;
-        if (channels == 3)
+        if (use_scaling)
+        {
+            WebPDecoderConfig config;
+            CV_Assert(WebPInitDecoderConfig(&config));
+            config.options.use_scaling = 1;
+            config.options.scaled_width = m_width;
+            config.options.scaled_height = m_height;
+            config.output.colorspace = channels == 3 ? MODE_BGR : MODE_BGRA;
+            config.output.is_external_memory = 1;
+            config.output.u.RGBA.rgba = out_data;
+            config.output.u.RGBA.stride = (int)read_img.step;
+            config.output.u.RGBA.size = out_data_size;
+            if (WebPDecode(data.ptr(), data.total(), &config) == VP8_STATUS_OK)
+                res_ptr = out_data;
+            WebPFreeDecBuffer(&config.output);
+        }
+        else if (channels == 3)
         {
             CV_CheckTypeEQ(read_img.type(), CV_8UC3, "");
             res_ptr = WebPDecodeBGRInto(data.ptr(), data.total(), out_data,
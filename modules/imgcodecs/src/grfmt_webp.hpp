@@ -61,6 +61,9 @@ public:
 
     bool readData( Mat& img ) CV_OVERRIDE;
     bool readHeader() CV_OVERRIDE;
+    bool isReusable() const CV_OVERRIDE { return true; }
+    void releaseSource() CV_OVERRIDE;
+    bool setTargetSize( const Size& size ) CV_OVERRIDE;
 
     size_t signatureLength() const CV_OVERRIDE;
     bool checkSignature( const String& signature) const CV_OVERRIDE;
@@ -72,6 +75,7 @@ protected:
     size_t fs_size;
     Mat data;
     int channels;
+    bool use_scaling; // decode directly at m_width x m_height ( set by setTargetSize )
 };
 
 class WebPEncoder CV_FINAL : public BaseImageEncoder
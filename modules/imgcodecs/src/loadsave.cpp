@@ -52,10 +52,20 @@
 #include <iostream>
 #include <fstream>
 #include <cerrno>
+#include <list>
+#include <atomic>
 #include <opencv2/core/utils/logger.hpp>
 #include <opencv2/core/utils/configuration.private.hpp>
+#include <opencv2/core/utils/tls.hpp>
 #include <opencv2/imgcodecs.hpp>
 
+#if defined __unix__ || defined __APPLE__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 
 
 /****************************************************************************************\
@@ -68,6 +78,17 @@ static const size_t CV_IO_MAX_IMAGE_PARAMS = cv::utils::getConfigurationParamete
 static const size_t CV_IO_MAX_IMAGE_WIDTH = utils::getConfigurationParameterSizeT("OPENCV_IO_MAX_IMAGE_WIDTH", 1 << 20);
 static const size_t CV_IO_MAX_IMAGE_HEIGHT = utils::getConfigurationParameterSizeT("OPENCV_IO_MAX_IMAGE_HEIGHT", 1 << 20);
 static const size_t CV_IO_MAX_IMAGE_PIXELS = utils::getConfigurationParameterSizeT("OPENCV_IO_MAX_IMAGE_PIXELS", 1 << 30);
+// files of at least this size are mapped into the memory, 0 (default) disables the mapping:
+// a file truncated by another process while it is decoded would crash the process with SIGBUS
+static const size_t CV_IO_MMAP_MIN_FILE_SIZE = utils::getConfigurationParameterSizeT("OPENCV_IO_MMAP_MIN_FILE_SIZE", 0);
+static std::atomic<size_t> g_mmapMinFileSize(CV_IO_MMAP_MIN_FILE_SIZE);
+
+namespace details {
+size_t setMmapMinFileSize(size_t size)
+{
+    return g_mmapMinFileSize.exchange(size);
+}
+}
 
 static Size validateInputImageSize(const Size& size)
 {
@@ -80,6 +101,13 @@ static Size validateInputImageSize(const Size& size)
     return size;
 }
 
+static bool validateRegion(const Rect& roi, const Size& size)
+{
+    CV_Assert(!roi.empty());
+    CV_Assert((roi & Rect(Point(), size)) == roi);
+    return true;
+}
+
 
 namespace {
 
@@ -118,6 +146,94 @@ protected:
     }
 };
 
+// Read-only mapping of a whole file, so the decoders read the data from the page cache without copying.
+// The file must not be truncated while it is mapped.
+class MappedFile
+{
+public:
+    MappedFile() : data_(0), size_(0) {}
+    ~MappedFile() { close(); }
+
+    bool open(const String& filename)
+    {
+        close();
+#if defined _WIN32 && !defined WINRT
+        HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+        LARGE_INTEGER size;
+        if (GetFileSizeEx(file, &size) && isMappable((uint64)size.QuadPart))
+        {
+            HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+            if (mapping)
+            {
+                data_ = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                if (data_)
+                    size_ = (size_t)size.QuadPart;
+                CloseHandle(mapping); // the view keeps the mapping alive
+            }
+        }
+        CloseHandle(file);
+#elif defined __unix__ || defined __APPLE__
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0)
+            return false;
+        struct stat st;
+        if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && isMappable((uint64)st.st_size))
+        {
+            void* ptr = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (ptr != MAP_FAILED)
+            {
+                data_ = ptr;
+                size_ = (size_t)st.st_size;
+            }
+        }
+        ::close(fd); // the mapping stays valid
+#else
+        CV_UNUSED(filename);
+#endif
+        return data_ != 0;
+    }
+
+    void close()
+    {
+        if (!data_)
+            return;
+#if defined _WIN32 && !defined WINRT
+        UnmapViewOfFile(data_);
+#elif defined __unix__ || defined __APPLE__
+        munmap(data_, size_);
+#endif
+        data_ = 0;
+        size_ = 0;
+    }
+
+    Mat data() const { return Mat(1, (int)size_, CV_8UC1, data_); }
+
+private:
+    static bool isMappable(uint64 size)
+    {
+        const size_t minSize = g_mmapMinFileSize;
+        return minSize > 0 && size >= minSize && size <= (uint64)INT_MAX;
+    }
+
+    void* data_;
+    size_t size_;
+
+    MappedFile(const MappedFile&); // copy disabled
+    MappedFile& operator=(const MappedFile&); // assign disabled
+};
+
+}
+
+// Gives the file to the decoder as a memory mapped buffer if possible, the mapping must outlive the decoding.
+static void setFileSource(const ImageDecoder& decoder, const String& filename, MappedFile& file)
+{
+    if (file.open(filename) && decoder->setSource(file.data()))
+        return;
+    file.close();
+    decoder->setSource(filename);
 }
 
 /**
@@ -259,12 +375,13 @@ static ImageDecoder findDecoder( const String& filename ) {
     return ImageDecoder();
 }
 
-static ImageDecoder findDecoder( const Mat& buf )
+// returns index of the decoder prototype in ImageCodecInitializer::decoders, -1 if the format is unknown
+static int findDecoderIndex( const Mat& buf )
 {
     size_t i, maxlen = 0;
 
     if( buf.rows*buf.cols < 1 || !buf.isContinuous() )
-        return ImageDecoder();
+        return -1;
 
     ImageCodecInitializer& codecs = getCodecs();
     for( i = 0; i < codecs.decoders.size(); i++ )
@@ -281,10 +398,16 @@ static ImageDecoder findDecoder( const Mat& buf )
     for( i = 0; i < codecs.decoders.size(); i++ )
     {
         if( codecs.decoders[i]->checkSignature(signature) )
-            return codecs.decoders[i]->newDecoder();
+            return (int)i;
     }
 
-    return ImageDecoder();
+    return -1;
+}
+
+static ImageDecoder findDecoder( const Mat& buf )
+{
+    int idx = findDecoderIndex(buf);
+    return idx >= 0 ? getCodecs().decoders[idx]->newDecoder() : ImageDecoder();
 }
 
 static ImageEncoder findEncoder( const String& _ext )
@@ -376,6 +499,56 @@ static void ApplyExifOrientation(ExifEntry_t orientationTag, Mat& img)
     }
 }
 
+// Returns true if the EXIF orientation swaps the image sides ( IMAGE_ORIENTATION_LT..IMAGE_ORIENTATION_LB )
+static bool isExifTransposed(const ExifEntry_t& orientationTag)
+{
+    return orientationTag.tag != INVALID_TAG &&
+           orientationTag.field_u16 >= IMAGE_ORIENTATION_LT && orientationTag.field_u16 <= IMAGE_ORIENTATION_LB;
+}
+
+// Returns the YUV layout requested by the flags ( IMREAD_YUV_I420 or IMREAD_YUV_NV12 ), 0 for other modes
+static int getYUVLayout( int flags )
+{
+    if( flags == IMREAD_UNCHANGED )
+        return 0;
+    return (flags & IMREAD_YUV_NV12) ? IMREAD_YUV_NV12 : (flags & IMREAD_YUV_I420) ? IMREAD_YUV_I420 : 0;
+}
+
+/**
+ * Decode the image as YCbCr 4:2:0 planes, directly if the codec can do it,
+ * otherwise the image is decoded to BGR and converted
+ *
+ * @param[in] size Image size reported by the decoder
+ * @param[in] layout IMREAD_YUV_I420 or IMREAD_YUV_NV12
+*/
+static bool readDataYUV_( const ImageDecoder& decoder, const Size& size, int layout, int scale_denom, Mat& mat )
+{
+    Mat planes;
+    if( !decoder->readDataYUV( planes, layout ) )
+    {
+        Mat img( size, CV_8UC3 );
+        if( !decoder->readData( img ) )
+            return false;
+        if( decoder->setScale( scale_denom ) > 1 )
+            resize( img, img, Size( size.width / scale_denom, size.height / scale_denom ), 0, 0, INTER_LINEAR_EXACT );
+
+        // 4:2:0 needs even sizes, the last row / column is replicated
+        copyMakeBorder( img, img, 0, img.rows % 2, 0, img.cols % 2, BORDER_REPLICATE );
+        Mat ycrcb, channels[3], cb, cr;
+        cvtColor( img, ycrcb, COLOR_BGR2YCrCb );
+        split( ycrcb, channels );
+        resize( channels[2], cb, Size( img.cols / 2, img.rows / 2 ), 0, 0, INTER_AREA );
+        resize( channels[1], cr, Size( img.cols / 2, img.rows / 2 ), 0, 0, INTER_AREA );
+        packYUV420( channels[0], cb, cr, planes, layout );
+    }
+
+    if( mat.size() == planes.size() && mat.type() == planes.type() )
+        planes.copyTo( mat );
+    else
+        mat = planes;
+    return true;
+}
+
 /**
  * Read an image into memory and return the information
  *
@@ -385,8 +558,13 @@ static void ApplyExifOrientation(ExifEntry_t orientationTag, Mat& img)
  *
 */
 static bool
-imread_( const String& filename, int flags, Mat& mat )
+imread_( const String& filename, int flags, Mat& mat, const Rect& roi = Rect(), const Size& dsize = Size() )
 {
+    MappedFile file; // destroyed after the decoder which reads from it
+
+    const int yuv = getYUVLayout( flags );
+    CV_Assert( !yuv || (roi.empty() && dsize.empty()) );
+
     /// Search for the relevant decoder to handle the imagery
     ImageDecoder decoder;
 
@@ -420,7 +598,7 @@ imread_( const String& filename, int flags, Mat& mat )
     decoder->setScale( scale_denom );
 
     /// set the filename in the driver
-    decoder->setSource( filename );
+    setFileSource( decoder, filename, file );
 
     try
     {
@@ -457,7 +635,27 @@ imread_( const String& filename, int flags, Mat& mat )
             type = CV_MAKETYPE(CV_MAT_DEPTH(type), 1);
     }
 
-    if (mat.empty())
+    // the codec reduces the image while decoding if it can, the exact size is produced by resize() at the end
+    if (!dsize.empty() && scale_denom == 1)
+    {
+        // EXIF orientations 5..8 transpose the image later, so the codec reduces it to the swapped size
+        const bool transposed = (flags & IMREAD_IGNORE_ORIENTATION) == 0 && flags != IMREAD_UNCHANGED &&
+                                isExifTransposed(decoder->getExifTag(ORIENTATION));
+        if (decoder->setTargetSize(transposed ? Size(dsize.height, dsize.width) : dsize))
+            size = validateInputImageSize(Size(decoder->width(), decoder->height()));
+    }
+
+    // the region refers to the reduced image, so with IMREAD_REDUCED_* the whole image is decoded
+    const bool decodeRegion = !roi.empty() && scale_denom == 1 &&
+                              validateRegion(roi, size) && decoder->setRegion(roi);
+    if (decodeRegion)
+        size = roi.size();
+
+    if (yuv)
+    {
+        // the planes are allocated by readDataYUV_()
+    }
+    else if (mat.empty())
     {
         mat.create( size.height, size.width, type );
     }
@@ -472,7 +670,7 @@ imread_( const String& filename, int flags, Mat& mat )
     bool success = false;
     try
     {
-        if (decoder->readData(mat))
+        if (yuv ? readDataYUV_(decoder, size, yuv, scale_denom, mat) : decoder->readData(mat))
             success = true;
     }
     catch (const cv::Exception& e)
@@ -489,17 +687,30 @@ imread_( const String& filename, int flags, Mat& mat )
         return false;
     }
 
+    if (yuv)
+        return true;
+
     if( decoder->setScale( scale_denom ) > 1 ) // if decoder is JpegDecoder then decoder->setScale always returns 1
     {
         resize( mat, mat, Size( size.width / scale_denom, size.height / scale_denom ), 0, 0, INTER_LINEAR_EXACT);
     }
 
+    if (!roi.empty() && !decodeRegion && validateRegion(roi, mat.size()))
+    {
+        mat = Mat(mat, roi).clone();
+    }
+
     /// optionally rotate the data if EXIF orientation flag says so
     if (!mat.empty() && (flags & IMREAD_IGNORE_ORIENTATION) == 0 && flags != IMREAD_UNCHANGED )
     {
         ApplyExifOrientation(decoder->getExifTag(ORIENTATION), mat);
     }
 
+    if (!dsize.empty() && !mat.empty() && mat.size() != dsize)
+    {
+        resize(mat, mat, dsize, 0, 0, dsize.area() < mat.size().area() ? INTER_AREA : INTER_CUBIC);
+    }
+
     return true;
 }
 
@@ -507,6 +718,8 @@ imread_( const String& filename, int flags, Mat& mat )
 static bool
 imreadmulti_(const String& filename, int flags, std::vector<Mat>& mats, int start, int count)
 {
+    MappedFile file; // destroyed after the decoder which reads from it
+
     /// Search for the relevant decoder to handle the imagery
     ImageDecoder decoder;
 
@@ -533,7 +746,7 @@ imreadmulti_(const String& filename, int flags, std::vector<Mat>& mats, int star
     }
 
     /// set the filename in the driver
-    decoder->setSource(filename);
+    setFileSource(decoder, filename, file);
 
     // read the header to make sure it succeeds
     try
@@ -555,6 +768,10 @@ imreadmulti_(const String& filename, int flags, std::vector<Mat>& mats, int star
 
     int current = start;
 
+    // jump to the first requested page if the codec can seek, otherwise walk through the preceding pages
+    if (current > 0 && decoder->setPage(current))
+        current = 0;
+
     while (current > 0)
     {
         if (!decoder->nextPage())
@@ -651,6 +868,25 @@ void imread( const String& filename, OutputArray dst, int flags )
     imread_(filename, flags, img);
 }
 
+Mat imreadROI( const String& filename, const Rect& roi, int flags )
+{
+    CV_TRACE_FUNCTION();
+
+    Mat img;
+    imread_( filename, flags, img, roi );
+    return img;
+}
+
+Mat imreadScaled( const String& filename, const Size& dsize, int flags )
+{
+    CV_TRACE_FUNCTION();
+    CV_Assert(!dsize.empty());
+
+    Mat img;
+    imread_( filename, flags, img, Rect(), dsize );
+    return img;
+}
+
 /**
 * Read a multi-page image
 *
@@ -808,16 +1044,21 @@ bool imwrite( const String& filename, InputArray _img,
 }
 
 static bool
-imdecode_( const Mat& buf, int flags, Mat& mat )
+imdecode_( const Mat& buf, int flags, Mat& mat, const Rect& roi = Rect(), const Size& dsize = Size(),
+           ImageDecoder decoder = ImageDecoder() )
 {
     CV_Assert(!buf.empty());
     CV_Assert(buf.isContinuous());
     CV_Assert(buf.checkVector(1, CV_8U) > 0);
     Mat buf_row = buf.reshape(1, 1);  // decoders expects single row, avoid issues with vector columns
 
+    const int yuv = getYUVLayout( flags );
+    CV_Assert( !yuv || (roi.empty() && dsize.empty()) );
+
     String filename;
 
-    ImageDecoder decoder = findDecoder(buf_row);
+    if( !decoder )
+        decoder = findDecoder(buf_row);
     if( !decoder )
         return false;
 
@@ -897,12 +1138,29 @@ imdecode_( const Mat& buf, int flags, Mat& mat )
             type = CV_MAKETYPE(CV_MAT_DEPTH(type), 1);
     }
 
-    mat.create( size.height, size.width, type );
+    // the codec reduces the image while decoding if it can, the exact size is produced by resize() at the end
+    if (!dsize.empty() && scale_denom == 1)
+    {
+        // EXIF orientations 5..8 transpose the image later, so the codec reduces it to the swapped size
+        const bool transposed = (flags & IMREAD_IGNORE_ORIENTATION) == 0 && flags != IMREAD_UNCHANGED &&
+                                isExifTransposed(decoder->getExifTag(ORIENTATION));
+        if (decoder->setTargetSize(transposed ? Size(dsize.height, dsize.width) : dsize))
+            size = validateInputImageSize(Size(decoder->width(), decoder->height()));
+    }
+
+    // the region refers to the reduced image, so with IMREAD_REDUCED_* the whole image is decoded
+    const bool decodeRegion = !roi.empty() && scale_denom == 1 &&
+                              validateRegion(roi, size) && decoder->setRegion(roi);
+    if (decodeRegion)
+        size = roi.size();
+
+    if (!yuv)
+        mat.create( size.height, size.width, type );
 
     success = false;
     try
     {
-        if (decoder->readData(mat))
+        if (yuv ? readDataYUV_(decoder, size, yuv, scale_denom, mat) : decoder->readData(mat))
             success = true;
     }
     catch (const cv::Exception& e)
@@ -927,17 +1185,30 @@ imdecode_( const Mat& buf, int flags, Mat& mat )
         return false;
     }
 
+    if (yuv)
+        return true;
+
     if( decoder->setScale( scale_denom ) > 1 ) // if decoder is JpegDecoder then decoder->setScale always returns 1
     {
         resize(mat, mat, Size( size.width / scale_denom, size.height / scale_denom ), 0, 0, INTER_LINEAR_EXACT);
     }
 
+    if (!roi.empty() && !decodeRegion && validateRegion(roi, mat.size()))
+    {
+        mat = Mat(mat, roi).clone();
+    }
+
     /// optionally rotate the data if EXIF' orientation flag says so
     if (!mat.empty() && (flags & IMREAD_IGNORE_ORIENTATION) == 0 && flags != IMREAD_UNCHANGED)
     {
         ApplyExifOrientation(decoder->getExifTag(ORIENTATION), mat);
     }
 
+    if (!dsize.empty() && !mat.empty() && mat.size() != dsize)
+    {
+        resize(mat, mat, dsize, 0, 0, dsize.area() < mat.size().area() ? INTER_AREA : INTER_CUBIC);
+    }
+
     return true;
 }
 
@@ -965,6 +1236,144 @@ Mat imdecode( InputArray _buf, int flags, Mat* dst )
         return cv::Mat();
 }
 
+Mat imdecode( const uchar* data, size_t size, int flags )
+{
+    CV_TRACE_FUNCTION();
+    CV_Assert(data && size > 0 && size <= (size_t)INT_MAX);
+
+    Mat buf(1, (int)size, CV_8UC1, (void*)data), img;
+    if (!imdecode_(buf, flags, img))
+        img.release();
+
+    return img;
+}
+
+Mat imdecodeROI( InputArray _buf, const Rect& roi, int flags )
+{
+    CV_TRACE_FUNCTION();
+
+    Mat buf = _buf.getMat(), img;
+    if (!imdecode_(buf, flags, img, roi))
+        img.release();
+
+    return img;
+}
+
+Mat imdecodeScaled( InputArray _buf, const Size& dsize, int flags )
+{
+    CV_TRACE_FUNCTION();
+    CV_Assert(!dsize.empty());
+
+    Mat buf = _buf.getMat(), img;
+    if (!imdecode_(buf, flags, img, Rect(), dsize))
+        img.release();
+
+    return img;
+}
+
+// decoders kept by the threads of imdecodeBatch() for the next images, indexed as ImageCodecInitializer::decoders
+struct DecoderCache
+{
+    std::vector<ImageDecoder> decoders;
+};
+
+static TLSData<DecoderCache>& getDecoderCache()
+{
+    static TLSData<DecoderCache> g_cache;
+    return g_cache;
+}
+
+// takes the decoder out of the cache of the calling thread, releaseCachedDecoder() puts it back
+static ImageDecoder getCachedDecoder( const Mat& buf_row, int& idx )
+{
+    idx = findDecoderIndex(buf_row);
+    if( idx < 0 )
+        return ImageDecoder();
+
+    const ImageDecoder& proto = getCodecs().decoders[idx];
+    if( !proto->isReusable() )
+        return proto->newDecoder();
+
+    std::vector<ImageDecoder>& decoders = getDecoderCache().getRef().decoders;
+    if( decoders.size() <= (size_t)idx )
+        decoders.resize(idx + 1);
+    ImageDecoder decoder = decoders[idx];
+    decoders[idx].release();
+    return decoder ? decoder : proto->newDecoder();
+}
+
+static void releaseCachedDecoder( int idx, const ImageDecoder& decoder )
+{
+    // the cached decoder must not keep the caller's buffer alive
+    decoder->releaseSource();
+    if( decoder->isReusable() )
+        getDecoderCache().getRef().decoders[idx] = decoder;
+}
+
+class ImdecodeBatchInvoker : public ParallelLoopBody
+{
+public:
+    ImdecodeBatchInvoker( const std::vector<Mat>& bufs, int flags, std::vector<Mat>& dst, std::vector<uchar>& status )
+        : bufs_(bufs), flags_(flags), dst_(dst), status_(status) {}
+
+    void operator()( const Range& range ) const CV_OVERRIDE
+    {
+        for( int i = range.start; i < range.end; i++ )
+        {
+            const Mat& buf = bufs_[i];
+            Mat& mat = dst_[i];
+            bool success = false;
+            ImageDecoder decoder;
+            int idx = -1;
+            try
+            {
+                if( !buf.empty() && buf.isContinuous() && buf.checkVector(1, CV_8U) > 0 )
+                {
+                    decoder = getCachedDecoder(buf.reshape(1, 1), idx);
+                    success = decoder && imdecode_(buf, flags_, mat, Rect(), Size(), decoder);
+                }
+            }
+            catch (const cv::Exception& e)
+            {
+                CV_LOG_ERROR(NULL, "imdecodeBatch(): can't decode image " << i << ": " << e.what());
+            }
+            catch (const std::exception& e)
+            {
+                CV_LOG_ERROR(NULL, "imdecodeBatch(): can't decode image " << i << ": " << e.what());
+            }
+            // a decoder which has failed may be left in a bad state, it is not reused
+            if( success )
+                releaseCachedDecoder(idx, decoder);
+            else
+                mat.release();
+            status_[i] = success;
+        }
+    }
+
+private:
+    const std::vector<Mat>& bufs_;
+    int flags_;
+    std::vector<Mat>& dst_;
+    std::vector<uchar>& status_;
+};
+
+bool imdecodeBatch( InputArrayOfArrays _bufs, int flags, std::vector<Mat>& dst )
+{
+    CV_TRACE_FUNCTION();
+
+    std::vector<Mat> bufs;
+    _bufs.getMatVector(bufs);
+    const int count = (int)bufs.size();
+    dst.resize(count);
+    if( count == 0 )
+        return true;
+
+    std::vector<uchar> status(count, 0);
+    parallel_for_(Range(0, count), ImdecodeBatchInvoker(bufs, flags, dst, status));
+
+    return std::find(status.begin(), status.end(), 0) == status.end();
+}
+
 static bool
 imdecodemulti_(const Mat& buf, int flags, std::vector<Mat>& mats, int start, int count)
 {
@@ -1020,6 +1429,8 @@ imdecodemulti_(const Mat& buf, int flags, std::vector<Mat>& mats, int start, int
     }
 
     int current = start;
+    if (success && current > 0 && decoder->setPage(current))
+        current = 0;
     while (success && current > 0)
     {
         if (!decoder->nextPage())
@@ -1221,6 +1632,7 @@ public:
     Mat& at(int index);
     Mat& operator[](int index);
     void releaseCache(int index);
+    void setCacheSize(size_t maxPages);
     ImageCollection::iterator begin(ImageCollection* ptr);
     ImageCollection::iterator end(ImageCollection* ptr);
     Mat read();
@@ -1233,6 +1645,9 @@ public:
     void reset();
 
 private:
+    void touch(int index);
+    void shrinkCache();
+
     String m_filename;
     int m_flags{};
     std::size_t m_size{};
@@ -1240,6 +1655,9 @@ private:
     int m_height{};
     int m_current{};
     std::vector<cv::Mat> m_pages;
+    std::size_t m_cacheSize{};  // 0 means all decoded pages are kept
+    std::list<int> m_lru;       // cached pages, the most recently used first
+    std::vector<std::list<int>::iterator> m_lruPos;
     ImageDecoder m_decoder;
 };
 
@@ -1266,27 +1684,39 @@ void ImageCollection::Impl::init(String const& filename, int flags) {
     CV_Assert(m_decoder);
     m_decoder->setSource(filename);
     CV_Assert(m_decoder->readHeader());
+    m_current = 0;
 
-    // count the pages of the image collection
-    size_t count = 1;
-    while(m_decoder->nextPage()) count++;
-
-    m_size = count;
-    m_pages.resize(m_size);
-    // Reinitialize the decoder because we advanced to the last page while counting the pages of the image
-#ifdef HAVE_GDAL
-    if (m_flags != IMREAD_UNCHANGED && (m_flags & IMREAD_LOAD_GDAL) == IMREAD_LOAD_GDAL) {
-        m_decoder = GdalDecoder().newDecoder();
+    // Codecs with a page index know the page count and stay on the first page
+    int pageCount = m_decoder->pageCount();
+    if (pageCount > 0) {
+        m_size = pageCount;
     }
     else {
+        // count the pages of the image collection
+        size_t count = 1;
+        while(m_decoder->nextPage()) count++;
+        m_size = count;
+
+        // Reinitialize the decoder because we advanced to the last page while counting the pages of the image
+#ifdef HAVE_GDAL
+        if (m_flags != IMREAD_UNCHANGED && (m_flags & IMREAD_LOAD_GDAL) == IMREAD_LOAD_GDAL) {
+            m_decoder = GdalDecoder().newDecoder();
+        }
+        else {
 #endif
-    m_decoder = findDecoder(m_filename);
+        m_decoder = findDecoder(m_filename);
 #ifdef HAVE_GDAL
-    }
+        }
 #endif
 
-    m_decoder->setSource(m_filename);
-    m_decoder->readHeader();
+        m_decoder->setSource(m_filename);
+        m_decoder->readHeader();
+    }
+
+    m_pages.clear();
+    m_pages.resize(m_size);
+    m_lru.clear();
+    m_lruPos.assign(m_size, m_lru.end());
 }
 
 size_t ImageCollection::Impl::size() const { return m_size; }
@@ -1385,20 +1815,54 @@ Mat& ImageCollection::Impl::at(int index) {
 
 Mat& ImageCollection::Impl::operator[](int index) {
     if(m_pages.at(index).empty()) {
-        // We can't go backward in multi images. If the page is not in vector yet,
-        // go back to first page and advance until the desired page and read it into memory
         if(m_current != index) {
-            reset();
-            for(int i = 0; i != index && advance(); ++i) {}
+            // Codecs with a page index jump to the page directly. Others can't go backward in multi images:
+            // go back to first page and advance until the desired page
+            if(m_decoder->setPage(index)) {
+                m_current = index;
+            }
+            else {
+                reset();
+                for(int i = 0; i != index && advance(); ++i) {}
+            }
         }
         m_pages[index] = read();
     }
+    if(!m_pages[index].empty())
+        touch(index);
     return m_pages[index];
 }
 
+// Moves the page to the front of the LRU list and evicts the least recently used pages over the limit
+void ImageCollection::Impl::touch(int index) {
+    if(m_lruPos[index] != m_lru.end())
+        m_lru.splice(m_lru.begin(), m_lru, m_lruPos[index]);
+    else
+        m_lruPos[index] = m_lru.insert(m_lru.begin(), index);
+    shrinkCache();
+}
+
+void ImageCollection::Impl::shrinkCache() {
+    while(m_cacheSize > 0 && m_lru.size() > m_cacheSize) {
+        int evicted = m_lru.back();
+        m_lru.pop_back();
+        m_lruPos[evicted] = m_lru.end();
+        m_pages[evicted].release();
+    }
+}
+
 void ImageCollection::Impl::releaseCache(int index) {
     CV_Assert(index >= 0 && size_t(index) < m_size);
     m_pages[index].release();
+    if(m_lruPos[index] != m_lru.end()) {
+        m_lru.erase(m_lruPos[index]);
+        m_lruPos[index] = m_lru.end();
+    }
+}
+
+void ImageCollection::Impl::setCacheSize(size_t maxPages) {
+    m_cacheSize = maxPages;
+    shrinkCache();
 }
 
 /* ImageCollection API*/
@@ -1417,6 +1881,8 @@ const Mat& ImageCollection::operator[](int index) { return pImpl->operator[](ind
 
 void ImageCollection::releaseCache(int index) { pImpl->releaseCache(index); }
 
+void ImageCollection::setCacheSize(size_t maxPages) { pImpl->setCacheSize(maxPages); }
+
 Ptr<ImageCollection::Impl> ImageCollection::getImpl() { return pImpl; }
 
 /* Iterator API */
@@ -1453,6 +1919,140 @@ ImageCollection::iterator ImageCollection::iterator::operator++(int) {
     return tmp;
 }
 
+class ImageStripDecoder::Impl {
+public:
+    bool open(const String& filename, const Mat& buf, int flags);
+    int read(OutputArray strip, int maxRows);
+    void release();
+
+    MappedFile m_file; // the file opened by open(), must outlive the decoder
+    ImageDecoder m_decoder;
+    Mat m_buf;      // encoded image passed to openBuffer
+    Mat m_image;    // the whole image, if the decoder can't decode it by rows
+    Size m_size;
+    int m_type{-1};
+    int m_row{};
+};
+
+void ImageStripDecoder::Impl::release() {
+    m_decoder.release();
+    m_file.close();
+    m_buf.release();
+    m_image.release();
+    m_size = Size();
+    m_type = -1;
+    m_row = 0;
+}
+
+bool ImageStripDecoder::Impl::open(const String& filename, const Mat& buf, int flags) {
+    release();
+    CV_Assert(flags == IMREAD_UNCHANGED ||
+              (flags & (IMREAD_LOAD_GDAL | IMREAD_REDUCED_GRAYSCALE_2 |
+                        IMREAD_REDUCED_GRAYSCALE_4 | IMREAD_REDUCED_GRAYSCALE_8)) == 0);
+
+    ImageDecoder decoder = buf.empty() ? findDecoder(filename) : findDecoder(buf);
+    if (!decoder)
+        return false;
+    if (buf.empty())
+        setFileSource(decoder, filename, m_file);
+    else if (!decoder->setSource(buf))
+        return false;
+
+    try {
+        if (!decoder->readHeader())
+            return false;
+
+        Size size = validateInputImageSize(Size(decoder->width(), decoder->height()));
+
+        int type = decoder->type();
+        if (flags != IMREAD_UNCHANGED) {
+            if ((flags & IMREAD_ANYDEPTH) == 0)
+                type = CV_MAKETYPE(CV_8U, CV_MAT_CN(type));
+
+            if ((flags & IMREAD_COLOR) != 0 ||
+                ((flags & IMREAD_ANYCOLOR) != 0 && CV_MAT_CN(type) > 1))
+                type = CV_MAKETYPE(CV_MAT_DEPTH(type), 3);
+            else
+                type = CV_MAKETYPE(CV_MAT_DEPTH(type), 1);
+        }
+
+        if (!decoder->startReadRows(type)) {
+            // the decoder can't go row by row, so the whole image is decoded at once
+            m_image.create(size, type);
+            if (!decoder->readData(m_image))
+                return false;
+        }
+        m_size = size;
+        m_type = type;
+    }
+    catch (const cv::Exception& e) {
+        CV_LOG_ERROR(NULL, "ImageStripDecoder: can't open image: " << e.what());
+        m_image.release();
+        return false;
+    }
+    catch (...) {
+        CV_LOG_ERROR(NULL, "ImageStripDecoder: can't open image: unknown exception");
+        m_image.release();
+        return false;
+    }
+
+    m_decoder = decoder;
+    m_buf = buf;
+    return true;
+}
+
+int ImageStripDecoder::Impl::read(OutputArray strip, int maxRows) {
+    CV_Assert(m_decoder);
+    CV_CheckGT(maxRows, 0, "");
+
+    const int rows = std::min(maxRows, m_size.height - m_row);
+    if (rows <= 0) {
+        strip.release();
+        return 0;
+    }
+
+    if (!m_image.empty()) {
+        m_image.rowRange(m_row, m_row + rows).copyTo(strip);
+    }
+    else {
+        strip.create(rows, m_size.width, m_type);
+        Mat dst = strip.getMat();
+        if (!m_decoder->readRows(dst))
+            CV_Error(Error::StsError, "ImageStripDecoder: can't decode image rows");
+    }
+
+    m_row += rows;
+    if (m_row == m_size.height)
+        m_image.release();
+    return rows;
+}
+
+/* ImageStripDecoder API*/
+
+ImageStripDecoder::ImageStripDecoder() : pImpl(new Impl()) {}
+
+ImageStripDecoder::ImageStripDecoder(const String& filename, int flags) : pImpl(new Impl()) { pImpl->open(filename, Mat(), flags); }
+
+bool ImageStripDecoder::open(const String& filename, int flags) { return pImpl->open(filename, Mat(), flags); }
+
+bool ImageStripDecoder::openBuffer(InputArray buf, int flags) {
+    Mat bufMat = buf.getMat();
+    CV_Assert(!bufMat.empty());
+    return pImpl->open(String(), bufMat, flags);
+}
+
+bool ImageStripDecoder::isOpened() const { return !pImpl->m_decoder.empty(); }
+
+Size ImageStripDecoder::size() const { return pImpl->m_size; }
+
+int ImageStripDecoder::type() const { return pImpl->m_type; }
+
+int ImageStripDecoder::currentRow() const { return pImpl->m_row; }
+
+int ImageStripDecoder::read(OutputArray strip, int maxRows) { return pImpl->read(strip, maxRows); }
+
+void ImageStripDecoder::release() { pImpl->release(); }
+
 }
 
 /* End of file. */
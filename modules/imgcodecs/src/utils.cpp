@@ -606,4 +606,42 @@ uchar* FillGrayRow1( uchar* data, uchar* indices, int len, uchar* palette )
     return data;
 }
 
+void packYUV420( const Mat& y, const Mat& cb, const Mat& cr, Mat& dst, int layout )
+{
+    CV_Assert( y.type() == CV_8UC1 && y.cols % 2 == 0 && y.rows % 2 == 0 );
+    const Size csize( y.cols/2, y.rows/2 );
+    CV_Assert( (cb.empty() && cr.empty()) || (cb.size() == csize && cr.size() == csize) );
+
+    dst.create( y.rows*3/2, y.cols, CV_8UC1 );
+    y.copyTo( dst.rowRange(0, y.rows) );
+    uchar* chroma = dst.ptr(y.rows);
+
+    if( layout == IMREAD_YUV_NV12 )
+    {
+        Mat cbcr( csize, CV_8UC2, chroma );
+        if( cb.empty() )
+            cbcr.setTo( Scalar::all(128) );
+        else
+        {
+            const Mat src[] = { cb, cr };
+            const int fromTo[] = { 0, 0, 1, 1 };
+            mixChannels( src, 2, &cbcr, 1, fromTo, 2 );
+        }
+    }
+    else
+    {
+        Mat cbPlane( csize, CV_8UC1, chroma ), crPlane( csize, CV_8UC1, chroma + csize.area() );
+        if( cb.empty() )
+        {
+            cbPlane.setTo( Scalar::all(128) );
+            crPlane.setTo( Scalar::all(128) );
+        }
+        else
+        {
+            cb.copyTo( cbPlane );
+            cr.copyTo( crPlane );
+        }
+    }
+}
+
 }  // namespace
@@ -46,6 +46,11 @@ namespace cv {
 
 int validateToInt(size_t step);
 
+namespace details {
+//! sets the minimal size of memory-mapped files (OPENCV_IO_MMAP_MIN_FILE_SIZE), returns the previous value, for tests
+CV_EXPORTS size_t setMmapMinFileSize(size_t size);
+}
+
 template <typename _Tp> static inline
 size_t safeCastToSizeT(const _Tp v_origin, const char* msg)
 {
@@ -118,6 +123,10 @@ void icvCvt_CMYK2BGR_8u_C4C3R( const uchar* cmyk, int cmyk_step,
 void icvCvt_CMYK2Gray_8u_C4C1R( const uchar* ycck, int ycck_step,
                                 uchar* gray, int gray_step, Size size );
 
+/* Stores YCbCr planes as a single (h*3/2) x w Mat in IMREAD_YUV_I420 or IMREAD_YUV_NV12 layout.
+   y is w x h with even sizes, cb and cr are (w/2) x (h/2) or both empty for grayscale images. */
+void packYUV420( const Mat& y, const Mat& cb, const Mat& cr, Mat& dst, int layout );
+
 void  FillGrayPalette( PaletteEntry* palette, int bpp, bool negative = false );
 bool  IsColorPalette( PaletteEntry* palette, int bpp );
 void  CvtPaletteToGray( const PaletteEntry* palette, uchar* grayPalette, int entries );
@@ -370,6 +370,74 @@ INSTANTIATE_TEST_CASE_P( /* nothing */,
                             testing::Values(70, 95, 100),    // IMWRITE_JPEG_LUMA_QUALITY
                             testing::Values(70, 95, 100) )); // IMWRITE_JPEG_CHROMA_QUALITY
 
+TEST(Imgcodecs_Jpeg, decode_yuv)
+{
+    const int sampling_factor_list[] = {
+        IMWRITE_JPEG_SAMPLING_FACTOR_420,
+        IMWRITE_JPEG_SAMPLING_FACTOR_422,
+        IMWRITE_JPEG_SAMPLING_FACTOR_444,
+        IMWRITE_JPEG_SAMPLING_FACTOR_411,
+    };
+    const Size sizes[] = { Size(128, 96), Size(101, 75) };
+    for (size_t k = 0; k < sizeof(sizes) / sizeof(sizes[0]); k++)
+    {
+        const Size sz = sizes[k], ysize(alignSize(sz.width, 2), alignSize(sz.height, 2)), csize(ysize.width / 2, ysize.height / 2);
+        Mat src(sz, CV_8UC3);
+        for (int y = 0; y < sz.height; y++)
+            for (int x = 0; x < sz.width; x++)
+                src.at<Vec3b>(y, x) = Vec3b((uchar)(x * 2), (uchar)(y * 2), (uchar)(x + y));
+
+        for (size_t i = 0; i < sizeof(sampling_factor_list) / sizeof(sampling_factor_list[0]); i++)
+        {
+            SCOPED_TRACE(cv::format("size=%dx%d sampling=%x", sz.width, sz.height, sampling_factor_list[i]));
+            std::vector<int> params;
+            params.push_back(IMWRITE_JPEG_QUALITY);
+            params.push_back(95);
+            params.push_back(IMWRITE_JPEG_SAMPLING_FACTOR);
+            params.push_back(sampling_factor_list[i]);
+            std::vector<uchar> buf;
+            ASSERT_TRUE(imencode(".jpg", src, buf, params));
+
+            Mat i420 = imdecode(buf, IMREAD_YUV_I420), nv12 = imdecode(buf, IMREAD_YUV_NV12);
+            ASSERT_EQ(CV_8UC1, i420.type());
+            ASSERT_EQ(Size(ysize.width, ysize.height * 3 / 2), i420.size());
+            ASSERT_EQ(i420.size(), nv12.size());
+
+            // both layouts hold the same planes
+            EXPECT_EQ(0, cvtest::norm(i420.rowRange(0, ysize.height), nv12.rowRange(0, ysize.height), NORM_INF));
+            Mat cb(csize, CV_8UC1, i420.ptr(ysize.height)), cr(csize, CV_8UC1, i420.ptr(ysize.height) + csize.area());
+            Mat cbcr[2];
+            split(Mat(csize, CV_8UC2, nv12.ptr(ysize.height)), cbcr);
+            EXPECT_EQ(0, cvtest::norm(cb, cbcr[0], NORM_INF));
+            EXPECT_EQ(0, cvtest::norm(cr, cbcr[1], NORM_INF));
+
+            // the planes match the color converted BGR image up to rounding and chroma resampling
+            Mat ycrcb, ref[3], cbRef, crRef;
+            cvtColor(imdecode(buf, IMREAD_COLOR), ycrcb, COLOR_BGR2YCrCb);
+            split(ycrcb, ref);
+            EXPECT_LE(cvtest::norm(i420(Rect(Point(), sz)), ref[0], NORM_INF), 3);
+            resize(ref[2], cbRef, csize, 0, 0, INTER_AREA);
+            resize(ref[1], crRef, csize, 0, 0, INTER_AREA);
+            EXPECT_LE(cvtest::norm(cb, cbRef, NORM_L1) / cb.total(), 1.5);
+            EXPECT_LE(cvtest::norm(cr, crRef, NORM_L1) / cr.total(), 1.5);
+        }
+    }
+}
+
+TEST(Imgcodecs_Jpeg, decode_yuv_grayscale)
+{
+    Mat src(64, 80, CV_8UC1);
+    randu(src, 0, 256);
+    GaussianBlur(src, src, Size(5, 5), 0);
+    std::vector<uchar> buf;
+    ASSERT_TRUE(imencode(".jpg", src, buf));
+
+    Mat i420 = imdecode(buf, IMREAD_YUV_I420);
+    ASSERT_EQ(Size(80, 96), i420.size());
+    EXPECT_EQ(0, cvtest::norm(i420.rowRange(0, 64), imdecode(buf, IMREAD_GRAYSCALE), NORM_INF));
+    EXPECT_EQ(0, cvtest::norm(i420.rowRange(64, 96), Mat(32, 80, CV_8UC1, Scalar::all(128)), NORM_INF));
+}
+
 #endif // HAVE_JPEG
 
 }} // namespace
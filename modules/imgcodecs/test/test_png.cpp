@@ -48,6 +48,55 @@ TEST(Imgcodecs_Png, encode)
     EXPECT_PRED_FORMAT2(cvtest::MatComparator(0, 0), img, img_gt);
 }
 
+TEST(Imgcodecs_Png, encode_multithreaded)
+{
+    const int types[] = { CV_8UC1, CV_8UC3, CV_8UC4, CV_16UC1, CV_16UC3, CV_16UC4 };
+    const int levels[] = { -1, 0, 6 };
+    for (size_t i = 0; i < sizeof(types)/sizeof(types[0]); i++)
+    {
+        Mat img(347, 211, types[i]);
+        randu(img, 0, CV_MAT_DEPTH(types[i]) == CV_8U ? 256 : 65536);
+        img.rowRange(100, 250).setTo(Scalar::all(77)); // some well compressible data
+        for (size_t j = 0; j < sizeof(levels)/sizeof(levels[0]); j++)
+        {
+            SCOPED_TRACE(cv::format("type=%d level=%d", types[i], levels[j]));
+            std::vector<int> params;
+            if (levels[j] >= 0)
+            {
+                params.push_back(IMWRITE_PNG_COMPRESSION);
+                params.push_back(levels[j]);
+            }
+            std::vector<uchar> serial, parallel;
+            ASSERT_TRUE(imencode(".png", img, serial, params));
+            params.push_back(IMWRITE_PNG_THREADS);
+            params.push_back(4);
+            ASSERT_TRUE(imencode(".png", img, parallel, params));
+
+            Mat dst = imdecode(parallel, IMREAD_UNCHANGED);
+            ASSERT_FALSE(dst.empty());
+            EXPECT_EQ(0, cvtest::norm(img, dst, NORM_INF));
+            EXPECT_LT(parallel.size(), serial.size() * 11 / 10 + 64);
+        }
+    }
+}
+
+TEST(Imgcodecs_Png, decode_yuv)
+{
+    Mat src(75, 101, CV_8UC3);
+    randu(src, 0, 256);
+    std::vector<uchar> buf;
+    ASSERT_TRUE(imencode(".png", src, buf));
+
+    // PNG has no YCbCr planes, the decoded image is converted
+    Mat nv12 = imdecode(buf, IMREAD_YUV_NV12);
+    ASSERT_EQ(CV_8UC1, nv12.type());
+    ASSERT_EQ(Size(102, 76 * 3 / 2), nv12.size());
+    Mat ycrcb, ref[3];
+    cvtColor(src, ycrcb, COLOR_BGR2YCrCb);
+    split(ycrcb, ref);
+    EXPECT_EQ(0, cvtest::norm(nv12(Rect(0, 0, 101, 75)), ref[0], NORM_INF));
+}
+
 TEST(Imgcodecs_Png, regression_ImreadVSCvtColor)
 {
     const string root = cvtest::TS::ptr()->get_data_path();
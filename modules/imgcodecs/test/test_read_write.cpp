@@ -4,6 +4,10 @@
 #include "test_precomp.hpp"
 #include "test_common.hpp"
 
+namespace cv { namespace details {
+CV_EXPORTS size_t setMmapMinFileSize(size_t size); // imgcodecs/src/utils.hpp
+}}
+
 namespace opencv_test { namespace {
 
 /* < <file_name, image_size>, <imread mode, scale> > */
@@ -273,6 +277,469 @@ TEST_P(Imgcodecs_Image, read_write_GRAYSCALE)
 
 INSTANTIATE_TEST_CASE_P(imgcodecs, Imgcodecs_Image, testing::ValuesIn(exts));
 
+//==================================================================================================
+
+typedef testing::TestWithParam< tuple<Ext, ImreadModes> > Imgcodecs_ROI;
+
+TEST_P(Imgcodecs_ROI, decode_region)
+{
+    const string ext = get<0>(GetParam());
+    const int flags = get<1>(GetParam());
+
+    Mat image(Size(333, 257), CV_8UC3);
+    randu(image, Scalar::all(0), Scalar::all(255));
+    blur(image, image, Size(5, 5));
+
+    std::vector<int> params;
+    if (ext == "tiff")
+    {
+        params.push_back(IMWRITE_TIFF_ROWSPERSTRIP);
+        params.push_back(16);
+    }
+    std::vector<uchar> buf;
+    ASSERT_TRUE(imencode("." + ext, image, buf, params));
+    const string fname = cv::tempfile(ext.c_str());
+    ASSERT_TRUE(imwrite(fname, image, params));
+
+    const Mat full = imdecode(buf, flags);
+    ASSERT_FALSE(full.empty());
+
+    // libjpeg upsamples chroma at the borders of the cropped region by replication
+    const double maxDiff = ext == "jpg" && full.channels() > 1 ? 8 : 0;
+    const Rect rois[] = {
+        Rect(0, 0, image.cols, image.rows),
+        Rect(37, 45, 101, 66),
+        Rect(200, 200, 133, 57),
+        Rect(0, 16, image.cols, 16),
+        Rect(5, 1, 1, 1),
+    };
+    for (size_t i = 0; i < sizeof(rois) / sizeof(rois[0]); i++)
+    {
+        const Rect& roi = rois[i];
+        SCOPED_TRACE(cv::format("roi=[%d x %d from (%d, %d)]", roi.width, roi.height, roi.x, roi.y));
+
+        Mat part = imdecodeROI(buf, roi, flags);
+        ASSERT_EQ(roi.size(), part.size());
+        ASSERT_EQ(full.type(), part.type());
+        EXPECT_LE(cvtest::norm(part, full(roi), NORM_INF), maxDiff);
+
+        Mat loaded = imreadROI(fname, roi, flags);
+        EXPECT_EQ(0, cvtest::norm(loaded, part, NORM_INF)) << "imreadROI() and imdecodeROI() calls must provide the same result (bit-exact)";
+    }
+
+    EXPECT_ANY_THROW(imdecodeROI(buf, Rect(300, 0, 34, 10), flags));
+    EXPECT_ANY_THROW(imdecodeROI(buf, Rect(0, 250, 10, 8), flags));
+    EXPECT_EQ(0, remove(fname.c_str()));
+}
+
+const string roi_exts[] = {
+#if defined(HAVE_PNG) || defined(HAVE_SPNG)
+    "png",
+#endif
+#ifdef HAVE_TIFF
+    "tiff",
+#endif
+#ifdef HAVE_JPEG
+    "jpg",
+#endif
+    "bmp",
+};
+
+INSTANTIATE_TEST_CASE_P(/**/, Imgcodecs_ROI, testing::Combine(
+    testing::ValuesIn(roi_exts),
+    testing::Values(IMREAD_COLOR, IMREAD_GRAYSCALE)
+));
+
+TEST(Imgcodecs_ROI_Reduced, decode_region)
+{
+    Mat image(Size(320, 240), CV_8UC3);
+    randu(image, Scalar::all(0), Scalar::all(255));
+    std::vector<uchar> buf;
+    ASSERT_TRUE(imencode(".png", image, buf));
+
+    const Mat reduced = imdecode(buf, IMREAD_REDUCED_COLOR_2);
+    ASSERT_EQ(Size(160, 120), reduced.size());
+    const Rect roi(10, 20, 100, 50);
+    Mat part = imdecodeROI(buf, roi, IMREAD_REDUCED_COLOR_2);
+    EXPECT_EQ(0, cvtest::norm(part, reduced(roi), NORM_INF));
+    EXPECT_ANY_THROW(imdecodeROI(buf, Rect(100, 100, 100, 100), IMREAD_REDUCED_COLOR_2));
+}
+
+//==================================================================================================
+
+typedef testing::TestWithParam<Ext> Imgcodecs_Scaled;
+
+TEST_P(Imgcodecs_Scaled, decode_to_size)
+{
+    const string ext = GetParam();
+
+    Mat image(Size(640, 480), CV_8UC3);
+    randu(image, Scalar::all(0), Scalar::all(255));
+    GaussianBlur(image, image, Size(0, 0), 8);
+
+    std::vector<uchar> buf;
+    ASSERT_TRUE(imencode("." + ext, image, buf));
+    const string fname = cv::tempfile(ext.c_str());
+    ASSERT_TRUE(imwrite(fname, image));
+    const Mat full = imdecode(buf, IMREAD_COLOR);
+    ASSERT_FALSE(full.empty());
+
+    const Size sizes[] = { Size(160, 120), Size(100, 100), Size(333, 250), Size(37, 21), Size(800, 600) };
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+    {
+        const Size& dsize = sizes[i];
+        SCOPED_TRACE(cv::format("dsize=%dx%d", dsize.width, dsize.height));
+
+        Mat expected;
+        resize(full, expected, dsize, 0, 0, dsize.area() < full.size().area() ? INTER_AREA : INTER_CUBIC);
+
+        Mat scaled = imdecodeScaled(buf, dsize, IMREAD_COLOR);
+        ASSERT_EQ(dsize, scaled.size());
+        ASSERT_EQ(CV_8UC3, scaled.type());
+        EXPECT_GT(cvtest::PSNR(scaled, expected), 35.0);
+
+        Mat loaded = imreadScaled(fname, dsize, IMREAD_COLOR);
+        EXPECT_EQ(0, cvtest::norm(loaded, scaled, NORM_INF)) << "imreadScaled() and imdecodeScaled() calls must provide the same result (bit-exact)";
+
+        Mat gray = imdecodeScaled(buf, dsize, IMREAD_GRAYSCALE);
+        ASSERT_EQ(dsize, gray.size());
+        ASSERT_EQ(CV_8UC1, gray.type());
+    }
+    EXPECT_EQ(0, remove(fname.c_str()));
+}
+
+const string scaled_exts[] = {
+#ifdef HAVE_JPEG
+    "jpg",
+#endif
+#ifdef HAVE_WEBP
+    "webp",
+#endif
+#ifdef HAVE_OPENJPEG
+    "jp2",
+#endif
+#if defined(HAVE_PNG) || defined(HAVE_SPNG)
+    "png",
+#endif
+};
+
+INSTANTIATE_TEST_CASE_P(/**/, Imgcodecs_Scaled, testing::ValuesIn(scaled_exts));
+
+#ifdef HAVE_JPEG
+TEST(Imgcodecs_Scaled_Exif, orientation)
+{
+    Mat image(Size(640, 480), CV_8UC3);
+    randu(image, Scalar::all(0), Scalar::all(255));
+    GaussianBlur(image, image, Size(0, 0), 8);
+    std::vector<uchar> buf;
+    ASSERT_TRUE(imencode(".jpg", image, buf));
+
+    // APP1 segment with a single IFD entry: Orientation = 6 (rotate 90 CW)
+    const uchar app1[] = {
+        0xFF, 0xE1, 0x00, 0x22, 'E', 'x', 'i', 'f', 0, 0,
+        'I', 'I', 0x2A, 0x00, 0x08, 0x00, 0x00, 0x00,
+        0x01, 0x00,
+        0x12, 0x01, 0x03, 0x00, 0x01, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00
+    };
+    buf.insert(buf.begin() + 2, app1, app1 + sizeof(app1));
+
+    // the codec reduces the image by 4 to the transposed target size, so no resize is needed
+    const Mat reduced = imdecode(buf, IMREAD_REDUCED_COLOR_4);
+    ASSERT_EQ(Size(120, 160), reduced.size());
+    const Mat scaled = imdecodeScaled(buf, Size(120, 160), IMREAD_COLOR);
+    ASSERT_EQ(Size(120, 160), scaled.size());
+    EXPECT_EQ(0, cvtest::norm(scaled, reduced, NORM_INF));
+
+    // without the orientation handling the target size is used as is
+    const Mat ignored = imdecodeScaled(buf, Size(160, 120), IMREAD_COLOR | IMREAD_IGNORE_ORIENTATION);
+    ASSERT_EQ(Size(160, 120), ignored.size());
+    Mat rotated;
+    rotate(ignored, rotated, ROTATE_90_CLOCKWISE);
+    EXPECT_EQ(0, cvtest::norm(rotated, reduced, NORM_INF));
+}
+#endif
+
+//==================================================================================================
+
+typedef testing::TestWithParam< tuple<Ext, ImreadModes> > Imgcodecs_StripDecoder;
+
+TEST_P(Imgcodecs_StripDecoder, read_strips)
+{
+    const string ext = get<0>(GetParam());
+    const int flags = get<1>(GetParam());
+
+    Mat image(Size(317, 229), CV_8UC3);
+    randu(image, Scalar::all(0), Scalar::all(255));
+    blur(image, image, Size(5, 5));
+
+    std::vector<int> params;
+    if (ext == "tiff")
+    {
+        params.push_back(IMWRITE_TIFF_ROWSPERSTRIP);
+        params.push_back(20);
+    }
+    std::vector<uchar> buf;
+    ASSERT_TRUE(imencode("." + ext, image, buf, params));
+    const string fname = cv::tempfile(ext.c_str());
+    ASSERT_TRUE(imwrite(fname, image, params));
+
+    const Mat full = imdecode(buf, flags);
+    ASSERT_FALSE(full.empty());
+
+    for (int fromFile = 0; fromFile < 2; fromFile++)
+    {
+        SCOPED_TRACE(fromFile ? "file" : "buffer");
+
+        ImageStripDecoder decoder;
+        ASSERT_TRUE(fromFile ? decoder.open(fname, flags) : decoder.openBuffer(buf, flags));
+        ASSERT_TRUE(decoder.isOpened());
+        EXPECT_EQ(full.size(), decoder.size());
+        EXPECT_EQ(full.type(), decoder.type());
+
+        const int maxRows = 23;
+        Mat strip;
+        int y = 0;
+        for (;;)
+        {
+            const uchar* data = strip.data;
+            const int rows = decoder.read(strip, maxRows);
+            if (rows == 0)
+                break;
+            ASSERT_EQ(std::min(maxRows, full.rows - y), rows);
+            ASSERT_EQ(Size(full.cols, rows), strip.size());
+            if (rows == maxRows && data)
+            {
+                EXPECT_EQ(data, strip.data) << "strip buffer must be reused";
+            }
+            EXPECT_EQ(0, cvtest::norm(strip, full.rowRange(y, y + rows), NORM_INF)) << "y=" << y;
+            y += rows;
+            EXPECT_EQ(y, decoder.currentRow());
+        }
+        EXPECT_EQ(full.rows, y);
+        EXPECT_EQ(0, decoder.read(strip, maxRows));
+    }
+    EXPECT_EQ(0, remove(fname.c_str()));
+}
+
+const string strip_exts[] = {
+#if defined(HAVE_PNG) || defined(HAVE_SPNG)
+    "png",
+#endif
+#ifdef HAVE_TIFF
+    "tiff",
+#endif
+#ifdef HAVE_JPEG
+    "jpg",
+#endif
+#ifdef HAVE_IMGCODEC_PXM
+    "ppm",
+#endif
+    "bmp",
+};
+
+INSTANTIATE_TEST_CASE_P(/**/, Imgcodecs_StripDecoder, testing::Combine(
+    testing::ValuesIn(strip_exts),
+    testing::Values(IMREAD_COLOR, IMREAD_GRAYSCALE, IMREAD_UNCHANGED)
+));
+
+TEST(Imgcodecs_StripDecoder_16U, read_strips)
+{
+    Mat image(Size(64, 50), CV_16UC1);
+    randu(image, Scalar::all(0), Scalar::all(65535));
+    std::vector<uchar> buf;
+    ASSERT_TRUE(imencode(".png", image, buf));
+
+    ImageStripDecoder decoder;
+    ASSERT_TRUE(decoder.openBuffer(buf, IMREAD_UNCHANGED));
+    EXPECT_EQ(CV_16UC1, decoder.type());
+    Mat top, bottom;
+    EXPECT_EQ(30, decoder.read(top, 30));
+    EXPECT_EQ(20, decoder.read(bottom, 30));
+    EXPECT_EQ(0, cvtest::norm(top, image.rowRange(0, 30), NORM_INF));
+    EXPECT_EQ(0, cvtest::norm(bottom, image.rowRange(30, 50), NORM_INF));
+}
+
+#ifdef HAVE_TIFF
+TEST(Imgcodecs_StripDecoder_TIFF, single_strip)
+{
+    Mat image(Size(96, 75), CV_16UC3);
+    randu(image, Scalar::all(0), Scalar::all(65535));
+    const std::vector<int> params = {IMWRITE_TIFF_ROWSPERSTRIP, image.rows};
+    std::vector<uchar> buf;
+    ASSERT_TRUE(imencode(".tiff", image, buf, params));
+
+    // the only strip is decoded once and served to all the bands
+    ImageStripDecoder decoder;
+    ASSERT_TRUE(decoder.openBuffer(buf, IMREAD_UNCHANGED));
+    Mat strip;
+    for (int y = 0; y < image.rows; y += 16)
+    {
+        const int rows = std::min(16, image.rows - y);
+        ASSERT_EQ(rows, decoder.read(strip, 16));
+        EXPECT_EQ(0, cvtest::norm(strip, image.rowRange(y, y + rows), NORM_INF)) << "y=" << y;
+    }
+    EXPECT_EQ(0, decoder.read(strip, 16));
+}
+#endif
+
+//==================================================================================================
+
+#ifdef __linux__
+static bool isFileMapped(const string& fname)
+{
+    std::ifstream maps("/proc/self/maps");
+    std::string line;
+    while (std::getline(maps, line))
+    {
+        if (line.size() >= fname.size() && line.compare(line.size() - fname.size(), fname.size(), fname) == 0)
+            return true;
+    }
+    return false;
+}
+#endif
+
+TEST(Imgcodecs_MappedFile, imread_and_imdecode_span)
+{
+    const string mapped_exts[] = {
+#if defined(HAVE_PNG) || defined(HAVE_SPNG)
+        "png",
+#endif
+#ifdef HAVE_TIFF
+        "tiff",
+#endif
+#ifdef HAVE_JPEG
+        "jpg",
+#endif
+        "bmp",
+    };
+
+    // the files are larger than the threshold, so they are memory-mapped
+    const size_t minFileSize = 1 << 16;
+    const size_t prevMinFileSize = cv::details::setMmapMinFileSize(minFileSize);
+    Mat image(Size(512, 384), CV_8UC3);
+    randu(image, Scalar::all(0), Scalar::all(255));
+
+    for (size_t i = 0; i < sizeof(mapped_exts) / sizeof(mapped_exts[0]); i++)
+    {
+        const string& ext = mapped_exts[i];
+        SCOPED_TRACE(ext);
+
+        std::vector<uchar> buf;
+        ASSERT_TRUE(imencode("." + ext, image, buf));
+        ASSERT_GE(buf.size(), minFileSize);
+        const string fname = cv::tempfile(ext.c_str());
+        {
+            FILE* f = fopen(fname.c_str(), "wb");
+            ASSERT_TRUE(f != NULL);
+            ASSERT_EQ(buf.size(), fwrite(&buf[0], 1, buf.size(), f));
+            fclose(f);
+        }
+
+        const Mat expected = imdecode(buf, IMREAD_COLOR);
+        ASSERT_FALSE(expected.empty());
+        const Mat span = imdecode(&buf[0], buf.size(), IMREAD_COLOR);
+        EXPECT_EQ(0, cvtest::norm(span, expected, NORM_INF));
+        const Mat loaded = imread(fname, IMREAD_COLOR);
+        EXPECT_EQ(0, cvtest::norm(loaded, expected, NORM_INF));
+
+        std::vector<Mat> pages;
+        ASSERT_TRUE(imreadmulti(fname, pages, IMREAD_COLOR));
+        ASSERT_EQ(1u, pages.size());
+        EXPECT_EQ(0, cvtest::norm(pages[0], expected, NORM_INF));
+
+        // the decoder reads from the mapping after open(), the mapping is released with the decoder
+        {
+            ImageStripDecoder decoder;
+            ASSERT_TRUE(decoder.open(fname, IMREAD_COLOR));
+#ifdef __linux__
+            EXPECT_TRUE(isFileMapped(fname));
+#endif
+            Mat strip, result;
+            while (decoder.read(strip, 50) > 0)
+                result.push_back(strip);
+            EXPECT_EQ(0, cvtest::norm(result, expected, NORM_INF));
+        }
+#ifdef __linux__
+        EXPECT_FALSE(isFileMapped(fname));
+
+        // smaller files are read as usual
+        cv::details::setMmapMinFileSize(buf.size() + 1);
+        {
+            ImageStripDecoder decoder;
+            ASSERT_TRUE(decoder.open(fname, IMREAD_COLOR));
+            if (ext != "tiff") // libtiff maps the files it opens by itself
+            {
+                EXPECT_FALSE(isFileMapped(fname));
+            }
+        }
+        cv::details::setMmapMinFileSize(minFileSize);
+#endif
+        EXPECT_EQ(0, remove(fname.c_str()));
+    }
+    cv::details::setMmapMinFileSize(prevMinFileSize);
+}
+
+//==================================================================================================
+
+TEST(Imgcodecs_DecodeBatch, regression)
+{
+    const string batch_exts[] = {
+#if defined(HAVE_PNG) || defined(HAVE_SPNG)
+        ".png",
+#endif
+#ifdef HAVE_JPEG
+        ".jpg",
+#endif
+#ifdef HAVE_WEBP
+        ".webp",
+#endif
+        ".bmp",
+    };
+    const int n_exts = (int)(sizeof(batch_exts) / sizeof(batch_exts[0]));
+
+    std::vector<std::vector<uchar> > bufs;
+    for (int i = 0; i < 40; i++)
+    {
+        Mat image(Size(48 + i % 5, 32 + i % 3), CV_8UC3);
+        randu(image, Scalar::all(0), Scalar::all(255));
+        std::vector<uchar> buf;
+        ASSERT_TRUE(imencode(batch_exts[i % n_exts], image, buf));
+        bufs.push_back(buf);
+    }
+
+    for (int flags = IMREAD_GRAYSCALE; flags <= IMREAD_COLOR; flags++)
+    {
+        std::vector<Mat> dst;
+        ASSERT_TRUE(imdecodeBatch(bufs, flags, dst));
+        ASSERT_EQ(bufs.size(), dst.size());
+
+        std::vector<const uchar*> data;
+        for (size_t i = 0; i < bufs.size(); i++)
+        {
+            const Mat expected = imdecode(bufs[i], flags);
+            EXPECT_EQ(0, cvtest::norm(dst[i], expected, NORM_INF)) << "image " << i;
+            data.push_back(dst[i].data);
+        }
+
+        // the second pass decodes into the same Mats
+        ASSERT_TRUE(imdecodeBatch(bufs, flags, dst));
+        for (size_t i = 0; i < bufs.size(); i++)
+            EXPECT_EQ(data[i], dst[i].data) << "image " << i;
+    }
+
+    // broken buffers don't stop the batch
+    bufs[3].resize(10);
+    bufs[5] = std::vector<uchar>(100, 0);
+    std::vector<Mat> dst;
+    EXPECT_FALSE(imdecodeBatch(bufs, IMREAD_COLOR, dst));
+    ASSERT_EQ(bufs.size(), dst.size());
+    EXPECT_TRUE(dst[3].empty());
+    EXPECT_TRUE(dst[5].empty());
+    EXPECT_FALSE(dst[4].empty());
+    EXPECT_EQ(0, cvtest::norm(dst[6], imdecode(bufs[6], IMREAD_COLOR), NORM_INF));
+}
+
 TEST(Imgcodecs_Image, regression_9376)
 {
     String path = findDataFile("readwrite/regression_9376.bmp");
@@ -502,4 +969,87 @@ TEST(Imgcodecs_Params, imencode_regression_22752)
     EXPECT_ANY_THROW(cv::imencode("test.jpg", img, buf, params));  // parameters size or missing JPEG codec
 }
 
+TEST(Imgcodecs_AsyncImageWriter, write_and_encode)
+{
+    Mat img(48, 64, CV_8UC3);
+    cv::randu(img, Scalar::all(0), Scalar::all(200));
+
+    const int count = 10;
+    vector<string> files;
+    vector<AsyncArray> results;
+    {
+        AsyncImageWriter writer(2, 4);
+        for (int i = 0; i < count; i++)
+        {
+            Mat frame = img + Scalar::all(i);
+            files.push_back(cv::tempfile(".png"));
+            results.push_back(writer.write(files.back(), frame));
+            frame.setTo(Scalar::all(0));  // the writer keeps its own copy
+        }
+
+        AsyncArray encoded = writer.encode(".png", img);
+        Mat buf;
+        ASSERT_NO_THROW(encoded.get(buf));
+        vector<uchar> ref;
+        ASSERT_TRUE(imencode(".png", img, ref));
+        ASSERT_EQ(ref.size(), buf.total());
+        EXPECT_EQ(0, memcmp(ref.data(), buf.ptr(), ref.size()));
+
+        writer.waitAll();
+        EXPECT_EQ(0, writer.pending());
+        EXPECT_EQ(0, writer.dropped());
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        Mat dummy;
+        EXPECT_NO_THROW(results[i].get(dummy));
+        Mat loaded = imread(files[i]);
+        ASSERT_FALSE(loaded.empty()) << files[i];
+        EXPECT_EQ(0, cvtest::norm(img + Scalar::all(i), loaded, NORM_INF));
+        EXPECT_EQ(0, remove(files[i].c_str()));
+    }
+}
+
+TEST(Imgcodecs_AsyncImageWriter, errors_and_drop)
+{
+    AsyncImageWriter writer(1, 1, AsyncImageWriter::QUEUE_DROP);
+
+    Mat small(16, 16, CV_8UC1, Scalar(1)), dst;
+    AsyncArray bad = writer.encode(".unknown_extension", small);
+    EXPECT_ANY_THROW(bad.get(dst));
+
+    // the result is not required to be kept
+    const string filename = cv::tempfile(".png");
+    writer.write(filename, small);
+    writer.waitAll();
+    EXPECT_FALSE(imread(filename).empty());
+    EXPECT_EQ(0, remove(filename.c_str()));
+
+    // one worker and one slot can't keep up, so the rest is dropped
+    Mat big(1024, 1024, CV_8UC3);
+    cv::randu(big, Scalar::all(0), Scalar::all(255));
+    const vector<int> params = { IMWRITE_PNG_COMPRESSION, 9 };
+    vector<AsyncArray> results;
+    for (int i = 0; i < 20; i++)
+        results.push_back(writer.encode(".png", big, params));
+    writer.waitAll();
+
+    int failed = 0;
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        try
+        {
+            results[i].get(dst);
+            EXPECT_FALSE(dst.empty());
+        }
+        catch (const cv::Exception&)
+        {
+            failed++;
+        }
+    }
+    EXPECT_GT(failed, 0);
+    EXPECT_EQ((int64)failed, writer.dropped());
+}
+
 }} // namespace
@@ -1258,6 +1258,113 @@ TEST(Imgcodecs_Tiff, read_multipage_indexed)
     }
 }
 
+TEST(Imgcodecs_Tiff, read_multipage_random_access)
+{
+    const int page_count = 40;
+    vector<Mat> pages;
+    for (int i = 0; i < page_count; i++)
+    {
+        Mat page(24, 32, CV_8UC3);
+        cv::randu(page, Scalar::all(0), Scalar::all(255));
+        pages.push_back(page);
+    }
+    const string filename = cv::tempfile(".tiff");
+    ASSERT_TRUE(imwrite(filename, pages));
+    ASSERT_EQ((size_t)page_count, imcount(filename));
+
+    {
+        SCOPED_TRACE("imreadmulti from the middle");
+        vector<Mat> multi_pages;
+        ASSERT_TRUE(imreadmulti(filename, multi_pages, 37, 2, IMREAD_UNCHANGED));
+        ASSERT_EQ((size_t)2, multi_pages.size());
+        EXPECT_PRED_FORMAT2(cvtest::MatComparator(0, 0), pages[37], multi_pages[0]);
+        EXPECT_PRED_FORMAT2(cvtest::MatComparator(0, 0), pages[38], multi_pages[1]);
+        multi_pages.clear();
+        EXPECT_FALSE(imreadmulti(filename, multi_pages, page_count, 1, IMREAD_UNCHANGED));
+    }
+
+    {
+        SCOPED_TRACE("imdecodemulti from the middle");
+        FILE* fp = fopen(filename.c_str(), "rb");
+        ASSERT_TRUE(fp != NULL);
+        fseek(fp, 0, SEEK_END);
+        vector<uchar> buf(ftell(fp));
+        fseek(fp, 0, SEEK_SET);
+        ASSERT_EQ(buf.size(), fread(&buf[0], 1, buf.size(), fp));
+        fclose(fp);
+        vector<Mat> multi_pages;
+        ASSERT_TRUE(imdecodemulti(buf, IMREAD_UNCHANGED, multi_pages, Range(20, 23)));
+        ASSERT_EQ((size_t)3, multi_pages.size());
+        for (int i = 0; i < 3; i++)
+            EXPECT_PRED_FORMAT2(cvtest::MatComparator(0, 0), pages[20 + i], multi_pages[i]);
+    }
+
+    {
+        SCOPED_TRACE("ImageCollection random access");
+        ImageCollection collection(filename, IMREAD_UNCHANGED);
+        ASSERT_EQ((size_t)page_count, collection.size());
+        const int order[] = { 39, 5, 20, 0, 21, 38, 39, 1 };
+        for (size_t i = 0; i < sizeof(order) / sizeof(order[0]); i++)
+            EXPECT_PRED_FORMAT2(cvtest::MatComparator(0, 0), pages[order[i]], collection[order[i]]) << order[i];
+
+        int index = 0;
+        for (auto it = collection.begin(); it != collection.end(); ++it, ++index)
+            EXPECT_PRED_FORMAT2(cvtest::MatComparator(0, 0), pages[index], *it) << index;
+        EXPECT_EQ(page_count, index);
+    }
+
+    {
+        SCOPED_TRACE("ImageCollection LRU cache");
+        ImageCollection collection(filename, IMREAD_UNCHANGED);
+        collection.setCacheSize(3);
+        const Mat& p0 = collection[0];
+        const Mat& p1 = collection[1];
+        collection[2];
+        collection[0];  // page 1 becomes the least recently used one
+        collection[3];
+        EXPECT_FALSE(p0.empty());
+        EXPECT_TRUE(p1.empty());
+        EXPECT_PRED_FORMAT2(cvtest::MatComparator(0, 0), pages[1], collection[1]);
+        collection.setCacheSize(1);
+        EXPECT_TRUE(p0.empty());
+        EXPECT_FALSE(collection[1].empty());
+    }
+
+    EXPECT_EQ(0, remove(filename.c_str()));
+}
+
+TEST(Imgcodecs_Tiff, encode_multithreaded)
+{
+    const int types[] = { CV_8UC1, CV_8UC3, CV_16UC1, CV_16UC4 };
+    const int compressions[] = { IMWRITE_TIFF_COMPRESSION_LZW, IMWRITE_TIFF_COMPRESSION_ADOBE_DEFLATE, IMWRITE_TIFF_COMPRESSION_PACKBITS };
+    for (size_t i = 0; i < sizeof(types)/sizeof(types[0]); i++)
+    {
+        Mat img(301, 157, types[i]);
+        randu(img, 0, CV_MAT_DEPTH(types[i]) == CV_8U ? 256 : 65536);
+        img.rowRange(50, 200).setTo(Scalar::all(123));
+        for (size_t j = 0; j < sizeof(compressions)/sizeof(compressions[0]); j++)
+        {
+            SCOPED_TRACE(cv::format("type=%d compression=%d", types[i], compressions[j]));
+            std::vector<int> params;
+            params.push_back(IMWRITE_TIFF_COMPRESSION);
+            params.push_back(compressions[j]);
+            params.push_back(IMWRITE_TIFF_ROWSPERSTRIP);
+            params.push_back(16);
+            std::vector<uchar> serial, parallel;
+            ASSERT_TRUE(imencode(".tiff", img, serial, params));
+            params.push_back(IMWRITE_TIFF_THREADS);
+            params.push_back(4);
+            ASSERT_TRUE(imencode(".tiff", img, parallel, params));
+
+            // the strips are encoded by the same codec, so only their placement may differ
+            EXPECT_EQ(serial.size(), parallel.size());
+            Mat dst = imdecode(parallel, IMREAD_UNCHANGED);
+            ASSERT_FALSE(dst.empty());
+            EXPECT_EQ(0, cvtest::norm(img, dst, NORM_INF));
+        }
+    }
+}
+
 TEST(Imgcodecs_Tiff, read_bigtiff_images)
 {
     const string root = cvtest::TS::ptr()->get_data_path();
@@ -1511,8 +1511,8 @@ In-place operation is supported.
 
 @note The median filter uses #BORDER_REPLICATE internally to cope with border pixels, see #BorderTypes
 
-@param src input 1-, 3-, or 4-channel image; when ksize is 3 or 5, the image depth should be
-CV_8U, CV_16U, or CV_32F, for larger aperture sizes, it can only be CV_8U.
+@param src input 1-, 3-, or 4-channel image of depth CV_8U, CV_16U, CV_16S or CV_32F; for
+aperture sizes larger than 5, CV_8U images must have 1, 3 or 4 channels.
 @param dst destination array of the same size and type as src.
 @param ksize aperture linear size; it must be odd and greater than 1, for example: 3, 5, 7 ...
 @sa  bilateralFilter, blur, boxFilter, GaussianBlur
@@ -3906,6 +3906,42 @@ is \f$W \times H\f$ and templ is \f$w \times h\f$ , then result is \f$(W-w+1) \t
 CV_EXPORTS_W void matchTemplate( InputArray image, InputArray templ,
                                  OutputArray result, int method, InputArray mask = noArray() );
 
+/** @brief Matches a fixed set of templates against a sequence of images.
+
+The spectra of the templates are computed once and reused by every call (they are only recomputed
+when the image size leads to a different DFT size), and the spectrum of each image tile is shared
+by all the templates. The results are those of #matchTemplate called for every template, up to
+floating-point rounding.
+
+@sa createTemplateMatcher, matchTemplate
+ */
+class CV_EXPORTS_W TemplateMatcher : public Algorithm
+{
+public:
+    /** @brief Compares every template against overlapped regions of the image.
+
+    @param image Image where the search is running. It must have the type of the templates and be
+    not smaller than any of them.
+    @param results Maps of comparison results, one per template in the order the templates were
+    given, each computed as #matchTemplate does it.
+     */
+    CV_WRAP virtual void match(InputArray image, OutputArrayOfArrays results) = 0;
+
+    //! Returns the number of templates.
+    CV_WRAP virtual int getTemplatesCount() const = 0;
+
+    //! Returns the comparison method, see #TemplateMatchModes.
+    CV_WRAP virtual int getMethod() const = 0;
+};
+
+/** @brief Creates a cv::TemplateMatcher for the given templates.
+
+@param templates Searched templates. They must have the same type, 8-bit or 32-bit floating-point
+with any number of channels, and may differ in size. The matcher keeps its own copy of them.
+@param method Parameter specifying the comparison method, see #TemplateMatchModes
+ */
+CV_EXPORTS_W Ptr<TemplateMatcher> createTemplateMatcher(InputArrayOfArrays templates, int method);
+
 //! @}
 
 //! @addtogroup imgproc_shape
@@ -3997,6 +4033,9 @@ The function retrieves contours from the binary image using the algorithm @cite
 are a useful tool for shape analysis and object detection and recognition. See squares.cpp in the
 OpenCV sample directory.
 @note Since opencv 3.2 source image is not modified by this function.
+@note Large 8-bit images with many connected components are processed in parallel (one component
+per task) in the #RETR_LIST, #RETR_CCOMP and #RETR_TREE modes; the result is the same as the one
+of the sequential scan.
 
 @param image Source, an 8-bit single-channel image. Non-zero pixels are treated as 1's. Zero
 pixels remain 0's, so the image is treated as binary . You can use #compare, #inRange, #threshold ,
@@ -33,6 +33,32 @@ PERF_TEST_P(Size_MatType_kSize, medianBlur,
     SANITY_CHECK(dst);
 }
 
+PERF_TEST_P(Size_MatType_kSize, medianBlur_large,
+            testing::Combine(
+                testing::Values(szVGA, sz720p),
+                testing::Values(CV_8UC1, CV_16UC1, CV_32FC1),
+                testing::Values(7, 15, 31)
+                )
+            )
+{
+    Size size = get<0>(GetParam());
+    int type = get<1>(GetParam());
+    int ksize = get<2>(GetParam());
+
+    // depth-map-like data: 12-bit range, quantized for floats
+    Mat src(size, type);
+    Mat dst(size, type);
+    randu(src, 0, CV_MAT_DEPTH(type) == CV_8U ? 256 : 4096);
+    if (CV_MAT_DEPTH(type) == CV_32F)
+        src.convertTo(src, CV_16U), src.convertTo(src, type, 0.001);
+
+    declare.in(src).out(dst);
+
+    TEST_CYCLE() medianBlur(src, dst, ksize);
+
+    SANITY_CHECK_NOTHING();
+}
+
 CV_ENUM(BorderType3x3, BORDER_REPLICATE, BORDER_CONSTANT)
 CV_ENUM(BorderType, BORDER_REPLICATE, BORDER_CONSTANT, BORDER_REFLECT, BORDER_REFLECT101)
 
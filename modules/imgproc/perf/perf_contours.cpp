@@ -47,6 +47,40 @@ PERF_TEST_P(TestFindContours, findContours,
     SANITY_CHECK_NOTHING();
 }
 
+typedef TestBaseWithParam< tuple<Size, RetrMode, int> > TestFindContoursBusy;
+
+// many small components, scanned in parallel when threads are available
+PERF_TEST_P(TestFindContoursBusy, findContours,
+    Combine(
+        Values(sz1080p, sz2160p), // image size
+        RetrMode::all(), // retrieval mode
+        Values(20000, 50000) // blob count
+    )
+)
+{
+    Size img_size = get<0>(GetParam());
+    int retr_mode = get<1>(GetParam());
+    int blob_count = get<2>(GetParam());
+
+    RNG rng;
+    Mat img = Mat::zeros(img_size, CV_8UC1);
+    for (int i = 0; i < blob_count; i++)
+    {
+        Point center;
+        center.x = (unsigned)rng % img.cols;
+        center.y = (unsigned)rng % img.rows;
+        int radius = (unsigned)rng % 8 + 1;
+        // rings give nested contours
+        circle(img, center, radius, Scalar(255), (unsigned)rng % 2 ? -1 : 1);
+    }
+    vector< vector<Point> > contours;
+    vector< Vec4i > hierarchy;
+
+    TEST_CYCLE() findContours(img, contours, hierarchy, retr_mode, CHAIN_APPROX_SIMPLE);
+
+    SANITY_CHECK_NOTHING();
+}
+
 typedef TestBaseWithParam< tuple<Size, ApproxMode, int> > TestFindContoursFF;
 
 PERF_TEST_P(TestFindContoursFF, findContours,
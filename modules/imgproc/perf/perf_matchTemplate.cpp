@@ -81,4 +81,40 @@ PERF_TEST_P(ImgSize_TmplSize_Method, matchTemplateBig,
     SANITY_CHECK(result, eps);
 }
 
+typedef tuple<Size, int, MethodType> ImgSize_TmplCount_Method_t;
+typedef perf::TestBaseWithParam<ImgSize_TmplCount_Method_t> ImgSize_TmplCount_Method;
+
+PERF_TEST_P(ImgSize_TmplCount_Method, templateMatcher,
+            testing::Combine(
+                testing::Values(szVGA, sz1080p),
+                testing::Values(1, 8, 32),
+                testing::Values(TM_CCORR, TM_CCOEFF_NORMED)
+                )
+    )
+{
+    Size imgSz = get<0>(GetParam());
+    int count = get<1>(GetParam());
+    int method = get<2>(GetParam());
+
+    Mat img(imgSz, CV_8UC1);
+    randu(img, 0, 256);
+    std::vector<Mat> templs;
+    for (int i = 0; i < count; i++)
+    {
+        Mat tmpl(Size(32 + i % 5 * 8, 32 + i % 3 * 8), CV_8UC1);
+        randu(tmpl, 0, 256);
+        templs.push_back(tmpl);
+    }
+
+    Ptr<TemplateMatcher> matcher = createTemplateMatcher(templs, method);
+    std::vector<Mat> results;
+    matcher->match(img, results);
+
+    declare.in(img);
+
+    TEST_CYCLE() matcher->match(img, results);
+
+    SANITY_CHECK_NOTHING();
+}
+
 } // namespace
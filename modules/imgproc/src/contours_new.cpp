@@ -309,6 +309,7 @@ public:
     int findFirstBoundingContour(const Point& last_pos, const int y, const int lval, int par);
     int findNextX(int x, int y, int& prev, int& p);
     bool findNext();
+    bool findAllParallel();
 
     static shared_ptr<ContourScanner_> create(Mat img, int mode, int method, Point offset);
 };  // class ContourScanner_
@@ -623,6 +624,161 @@ bool ContourScanner_::findNext()
     return false;
 }
 
+// Parallel variant of the whole scan for binary images.
+//
+// Border following never leaves the 8-connected component it has started on, so the
+// components are labeled first (the labeling runs in parallel stripes merged along their
+// borders) and each one is traced on its own bounding box concurrently. The contours are then
+// linked into the tree in the order the raster scan would meet them, which reproduces the
+// sequential result exactly. For RETR_TREE parents are taken from the 4-connected background
+// components: the hole a component lies in and the component each hole belongs to.
+// RETR_EXTERNAL keeps the sequential scan, it is dominated by the raster scan itself.
+// Returns false and leaves the tree untouched when the image is not worth splitting.
+bool ContourScanner_::findAllParallel()
+{
+    const int nthreads = getNumThreads();
+    if (isInt() || this->mode == RETR_EXTERNAL || nthreads <= 1 ||
+        this->image.total() < (size_t)(1 << 20))
+        return false;
+
+    // labeling costs a few raster scans and pays off only with many components: estimate their
+    // number from the runs of every 16th row which have nothing above them
+    size_t tops = 0;
+    for (int y = 1; y < this->image.rows - 1; y += 16)
+    {
+        const uchar* above = this->image.ptr<uchar>(y - 1);
+        const uchar* row = this->image.ptr<uchar>(y);
+        for (int x = 1; x < this->image.cols - 1; x++)
+        {
+            if (row[x] == 0)
+                continue;
+            bool top = above[x - 1] == 0;
+            for (; row[x] != 0; x++)
+                top = top && above[x] == 0;
+            if (top && above[x] == 0)
+                tops++;
+        }
+    }
+    if (tops * 16 * 2048 < this->image.total())
+        return false;
+
+    Mat labels, stats, centroids;
+    const int ncomp =
+        connectedComponentsWithStats(this->image, labels, stats, centroids, 8, CV_32S) - 1;
+    if (ncomp < nthreads * 4)
+        return false;
+
+    // nested or sprawling components would make the tracing touch the image many times over
+    double traced_area = 0;
+    for (int i = 1; i <= ncomp; i++)
+    {
+        const int* s = stats.ptr<int>(i);
+        traced_area += (double)(s[CC_STAT_WIDTH] + 2) * (s[CC_STAT_HEIGHT] + 2);
+    }
+    if (traced_area > 2. * (double)this->image.total())
+        return false;
+
+    Mat bg_labels;
+    int nbg = 0, outer_bg = 0;
+    if (this->mode == RETR_TREE)
+    {
+        Mat bg;
+        compare(this->image, 0, bg, CMP_EQ);
+        nbg = connectedComponents(bg, bg_labels, 4, CV_32S);
+        outer_bg = bg_labels.at<int>(0, 0);
+    }
+
+    vector<vector<Contour>> found((size_t)ncomp);
+    parallel_for_(Range(0, ncomp), [&](const Range& range) {
+        Mat comp;
+        for (int i = range.start; i < range.end; i++)
+        {
+            const int label = i + 1;
+            const int* s = stats.ptr<int>(label);
+            const Rect roi(s[CC_STAT_LEFT] - 1,
+                           s[CC_STAT_TOP] - 1,
+                           s[CC_STAT_WIDTH] + 2,
+                           s[CC_STAT_HEIGHT] + 2);
+            comp.create(roi.size(), CV_8UC1);
+            for (int y = 0; y < roi.height; y++)
+            {
+                const int* lrow = labels.ptr<int>(roi.y + y) + roi.x;
+                uchar* crow = comp.ptr<uchar>(y);
+                for (int x = 0; x < roi.width; x++)
+                    crow[x] = (uchar)(lrow[x] == label);
+            }
+            // contours of a single component don't depend on the mode, only their parents do
+            ContourScanner local = ContourScanner_::create(comp,
+                                                           RETR_LIST,
+                                                           this->approx_method2,
+                                                           this->offset + roi.tl());
+            while (local->findNext())
+            {
+            }
+            vector<Contour>& res = found[(size_t)i];
+            res.resize(local->tree.size() - 1);
+            for (size_t j = 0; j < res.size(); j++)
+            {
+                res[j] = std::move(local->tree.elem((int)j + 1).body);
+                res[j].origin += roi.tl();
+            }
+        }
+    });
+
+    // outer borders are met at their first pixel, holes at the background pixel next to it
+    struct ContourRef
+    {
+        int64 pos;
+        int comp;
+        int idx;
+        bool operator<(const ContourRef& other) const
+        {
+            return pos < other.pos;
+        }
+    };
+    vector<ContourRef> refs;
+    for (int i = 0; i < ncomp; i++)
+    {
+        for (size_t j = 0; j < found[(size_t)i].size(); j++)
+        {
+            const Contour& c = found[(size_t)i][j];
+            const ContourRef ref = {(int64)c.origin.y * this->image.cols + c.origin.x +
+                                        (c.isHole ? 1 : 0),
+                                    i,
+                                    (int)j};
+            refs.push_back(ref);
+        }
+    }
+    std::sort(refs.begin(), refs.end());
+
+    vector<int> outer_node((size_t)ncomp, 0), hole_node((size_t)nbg, 0);
+    for (const ContourRef& ref : refs)
+    {
+        Contour& c = found[(size_t)ref.comp][(size_t)ref.idx];
+        int parent = 0;
+        if (c.isHole)
+        {
+            if (this->mode != RETR_LIST)
+                parent = outer_node[(size_t)ref.comp];
+        }
+        else if (this->mode == RETR_TREE)
+        {
+            const int bg = bg_labels.at<int>(c.origin.y, c.origin.x - 1);
+            if (bg != outer_bg)
+                parent = hole_node[(size_t)bg];
+        }
+        const Point origin = c.origin;
+        CNode& node = tree.newElem();
+        node.body = std::move(c);
+        tree.addChild(parent, node.self());
+        if (!node.body.isHole)
+            outer_node[(size_t)ref.comp] = node.self();
+        else if (this->mode == RETR_TREE)
+            hole_node[(size_t)bg_labels.at<int>(origin.y, origin.x + 1)] = node.self();
+    }
+    return true;
+}
+
 //==============================================================================
 
 void cv::findContours(InputArray _image,
@@ -679,8 +835,11 @@ void cv::findContours(InputArray _image,
 
     // find contours
     ContourScanner scanner = ContourScanner_::create(image, mode, method, offset + Point(-1, -1));
-    while (scanner->findNext())
+    if (!scanner->findAllParallel())
     {
+        while (scanner->findNext())
+        {
+        }
     }
 
     contourTreeToResults(scanner->tree, res_type, _contours, _hierarchy);
@@ -66,7 +66,7 @@ namespace cv {
 BaseRowFilter::BaseRowFilter() { ksize = anchor = -1; }
 BaseRowFilter::~BaseRowFilter() {}
 
-BaseColumnFilter::BaseColumnFilter() { ksize = anchor = -1; }
+BaseColumnFilter::BaseColumnFilter() { ksize = anchor = -1; batchRows = 0; }
 BaseColumnFilter::~BaseColumnFilter() {}
 void BaseColumnFilter::reset() {}
 
@@ -218,6 +218,57 @@ void FilterEngine::apply(const Mat& src, Mat& dst, const Size& wsz, const Point&
         CV_CPU_DISPATCH_MODES_ALL);
 }
 
+class FilterEngineParallelInvoker : public ParallelLoopBody
+{
+public:
+    FilterEngineParallelInvoker(const std::function<Ptr<FilterEngine>()>& _createEngine,
+                                const Mat& _src, Mat& _dst, const Size& _wsz, const Point& _ofs)
+        : createEngine(_createEngine), src(_src), dst(_dst), wsz(_wsz), ofs(_ofs)
+    {
+    }
+
+    void operator()(const Range& range) const CV_OVERRIDE
+    {
+        Ptr<FilterEngine> f = createEngine();
+        Mat dstBand = dst.rowRange(range);
+        f->apply(src.rowRange(range), dstBand, wsz, Point(ofs.x, ofs.y + range.start));
+    }
+
+private:
+    const std::function<Ptr<FilterEngine>()>& createEngine;
+    const Mat& src;
+    Mat& dst;
+    Size wsz;
+    Point ofs;
+};
+
+void applyFilterEngineParallel(const std::function<Ptr<FilterEngine>()>& createEngine,
+                               const Mat& src, Mat& dst, const Size& wsz, const Point& ofs)
+{
+    CV_INSTRUMENT_REGION();
+
+    Ptr<FilterEngine> f = createEngine();
+
+    // every band re-reads ksize.height - 1 rows around it, so keep the bands reasonably tall
+    int minBandRows = std::max(f->ksize.height*4, 32);
+    int nstripes = std::min(getNumThreads(), dst.rows / minBandRows);
+
+    // the engine may read any row of the whole image, so the bands must not overwrite them
+    const uchar* srcStart = src.ptr() - (ptrdiff_t)ofs.y*src.step;
+    const uchar* srcEnd = src.ptr() + (ptrdiff_t)(wsz.height - ofs.y)*src.step;
+    const uchar* dstStart = dst.ptr();
+    const uchar* dstEnd = dst.ptr() + (ptrdiff_t)dst.rows*dst.step;
+    bool overlap = srcStart < dstEnd && dstStart < srcEnd;
+
+    if (nstripes <= 1 || overlap || dst.total() < (size_t)(1 << 16))
+    {
+        f->apply(src, dst, wsz, ofs);
+        return;
+    }
+
+    parallel_for_(Range(0, dst.rows), FilterEngineParallelInvoker(createEngine, src, dst, wsz, ofs), nstripes);
+}
+
 /****************************************************************************************\
 *                                 Separable linear filter                                *
 \****************************************************************************************/
@@ -1353,11 +1404,12 @@ static void ocvFilter2D(int stype, int dtype, int kernel_type,
 {
     int borderTypeValue = borderType & ~BORDER_ISOLATED;
     Mat kernel = Mat(Size(kernel_width, kernel_height), kernel_type, kernel_data, kernel_step);
-    Ptr<FilterEngine> f = createLinearFilter(stype, dtype, kernel, Point(anchor_x, anchor_y), delta,
-                                             borderTypeValue);
     Mat src(Size(width, height), stype, src_data, src_step);
     Mat dst(Size(width, height), dtype, dst_data, dst_step);
-    f->apply(src, dst, Size(full_width, full_height), Point(offset_x, offset_y));
+    applyFilterEngineParallel([&]() {
+            return createLinearFilter(stype, dtype, kernel, Point(anchor_x, anchor_y), delta,
+                                      borderTypeValue);
+        }, src, dst, Size(full_width, full_height), Point(offset_x, offset_y));
 }
 
 static bool replacementSepFilter(int stype, int dtype, int ktype,
@@ -1393,12 +1445,13 @@ static void ocvSepFilter(int stype, int dtype, int ktype,
 {
     Mat kernelX(Size(kernelx_len, 1), ktype, kernelx_data);
     Mat kernelY(Size(kernely_len, 1), ktype, kernely_data);
-    Ptr<FilterEngine> f = createSeparableLinearFilter(stype, dtype, kernelX, kernelY,
-                                                      Point(anchor_x, anchor_y),
-                                                      delta, borderType & ~BORDER_ISOLATED);
     Mat src(Size(width, height), stype, src_data, src_step);
     Mat dst(Size(width, height), dtype, dst_data, dst_step);
-    f->apply(src, dst, Size(full_width, full_height), Point(offset_x, offset_y));
+    applyFilterEngineParallel([&]() {
+            return createSeparableLinearFilter(stype, dtype, kernelX, kernelY,
+                                               Point(anchor_x, anchor_y),
+                                               delta, borderType & ~BORDER_ISOLATED);
+        }, src, dst, Size(full_width, full_height), Point(offset_x, offset_y));
 }
 
 //===================================================================
@@ -107,6 +107,8 @@ int FilterEngine__start(FilterEngine& this_, const Size &_wholeSize, const Size
     int _maxBufRows = std::max(this_.ksize.height + 3,
                                std::max(this_.anchor.y,
                                         this_.ksize.height-this_.anchor.y-1)*2+1);
+    if (this_.columnFilter && this_.columnFilter->batchRows > 0)
+        _maxBufRows = std::max(_maxBufRows, this_.ksize.height + this_.columnFilter->batchRows - 1);
 
     if (this_.maxWidth < this_.roi.width || _maxBufRows != (int)this_.rows.size() )
     {
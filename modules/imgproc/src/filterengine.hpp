@@ -107,6 +107,9 @@ public:
 
     int ksize;
     int anchor;
+    //! the preferred number of output rows per call (0 if the filter has no preference);
+    //! cv::FilterEngine keeps enough rows in its ring buffer to provide them.
+    int batchRows;
 };
 
 
@@ -282,6 +285,18 @@ public:
     Ptr<BaseColumnFilter> columnFilter;
 };
 
+/*!
+ Applies a filter to the specified ROI of the image in horizontal bands processed in parallel.
+
+ Every band is filtered by its own engine returned by createEngine, so the ring buffers and the state
+ of the row/column filters are never shared between threads. A band is started as a ROI of the same
+ whole image (wsz, ofs), so the rows around the band seams are read from the source and only the
+ real image border is extrapolated, exactly as in a single FilterEngine::apply() call.
+ Small images and overlapping src/dst (e.g. in-place filtering) are processed by one engine.
+*/
+void applyFilterEngineParallel(const std::function<Ptr<FilterEngine>()>& createEngine,
+                               const Mat& src, Mat& dst, const Size& wsz, const Point& ofs);
+
 
 //! returns type (one of KERNEL_*) of 1D or 2D kernel specified by its coefficients.
 int getKernelType(InputArray kernel, Point anchor);
@@ -44,6 +44,7 @@
 #include "precomp.hpp"
 
 #include <vector>
+#include <unordered_set>
 
 #include "opencv2/core/hal/intrin.hpp"
 
@@ -141,15 +142,17 @@ medianBlur_8u_O1( const Mat& _src, Mat& _dst, int ksize )
         memset( h_coarse, 0, 16*n*cn*sizeof(h_coarse[0]) );
         memset( h_fine, 0, 16*16*n*cn*sizeof(h_fine[0]) );
 
-        // First row initialization
+        // First row initialization. The source carries r replicated rows on
+        // each side, so dst row i sees src rows [i, i+2r]; row 0 is counted
+        // twice because the loop below removes it once before adding row 2r.
         for( c = 0; c < cn; c++ )
         {
             for( j = 0; j < n; j++ )
-                COP( c, j, src[cn*j+c], += (HT)(r+2) );
+                COP( c, j, src[cn*j+c], += 2 );
 
-            for( i = 1; i < r; i++ )
+            for( i = 1; i < 2*r; i++ )
             {
-                const uchar* p = src + sstep*std::min(i, m-1);
+                const uchar* p = src + sstep*i;
                 for ( j = 0; j < n; j++ )
                     COP( c, j, p[cn*j+c], ++ );
             }
@@ -157,8 +160,8 @@ medianBlur_8u_O1( const Mat& _src, Mat& _dst, int ksize )
 
         for( i = 0; i < m; i++ )
         {
-            const uchar* p0 = src + sstep * std::max( 0, i-r-1 );
-            const uchar* p1 = src + sstep * std::min( m-1, i+r );
+            const uchar* p0 = src + sstep * std::max( 0, i-1 );
+            const uchar* p1 = src + sstep * (i + 2*r);
 
             for( c = 0; c < cn; c++ )
             {
@@ -359,7 +362,6 @@ medianBlur_8u_Om( const Mat& _src, Mat& _dst, int m )
     uchar*  dst = _dst.ptr();
     int     src_step = (int)_src.step, dst_step = (int)_dst.step;
     int     cn = _src.channels();
-    const uchar*  src_max = src + size.height*src_step;
     CV_Assert(cn > 0 && cn <= 4);
 
     #define UPDATE_ACC01( pix, cn, op ) \
@@ -369,19 +371,19 @@ medianBlur_8u_Om( const Mat& _src, Mat& _dst, int m )
         zone0[cn][p >> 4] op;           \
     }
 
-    //CV_Assert( size.height >= nx && size.width >= nx );
+    // the source carries m/2 replicated rows and columns on each side,
+    // so the window of dst row y spans src rows [y, y+m)
     for( x = 0; x < size.width; x++, src += cn, dst += cn )
     {
         uchar* dst_cur = dst;
-        const uchar* src_top = src;
-        const uchar* src_bottom = src;
+        const uchar* src_first = src;
         int k, c;
-        int src_step1 = src_step, dst_step1 = dst_step;
+        ptrdiff_t src_step1 = src_step, dst_step1 = dst_step;
 
         if( x % 2 != 0 )
         {
-            src_bottom = src_top += src_step*(size.height-1);
-            dst_cur += dst_step*(size.height-1);
+            src_first += (ptrdiff_t)src_step*(size.height+m-2);
+            dst_cur += (ptrdiff_t)dst_step*(size.height-1);
             src_step1 = -src_step1;
             dst_step1 = -dst_step1;
         }
@@ -390,25 +392,12 @@ medianBlur_8u_Om( const Mat& _src, Mat& _dst, int m )
         memset( zone0, 0, sizeof(zone0[0])*cn );
         memset( zone1, 0, sizeof(zone1[0])*cn );
 
-        for( y = 0; y <= m/2; y++ )
+        for( y = 0; y < m; y++ )
         {
+            const uchar* src_bottom = src_first + src_step1*y;
             for( c = 0; c < cn; c++ )
-            {
-                if( y > 0 )
-                {
-                    for( k = 0; k < m*cn; k += cn )
-                        UPDATE_ACC01( src_bottom[k+c], c, ++ );
-                }
-                else
-                {
-                    for( k = 0; k < m*cn; k += cn )
-                        UPDATE_ACC01( src_bottom[k+c], c, += m/2+1 );
-                }
-            }
-
-            if( (src_step1 > 0 && y < size.height-1) ||
-                (src_step1 < 0 && size.height-y-1 > 0) )
-                src_bottom += src_step1;
+                for( k = 0; k < m*cn; k += cn )
+                    UPDATE_ACC01( src_bottom[k+c], c, ++ );
         }
 
         for( y = 0; y < size.height; y++, dst_cur += dst_step1 )
@@ -436,6 +425,9 @@ medianBlur_8u_Om( const Mat& _src, Mat& _dst, int m )
             if( y+1 == size.height )
                 break;
 
+            const uchar* src_top = src_first + src_step1*y;
+            const uchar* src_bottom = src_first + src_step1*(y + m);
+
             if( cn == 1 )
             {
                 for( k = 0; k < m; k++ )
@@ -477,19 +469,182 @@ medianBlur_8u_Om( const Mat& _src, Mat& _dst, int m )
                     UPDATE_ACC01( src_bottom[k+3], 3, ++ );
                 }
             }
-
-            if( (src_step1 > 0 && src_bottom + src_step1 < src_max) ||
-                (src_step1 < 0 && src_bottom + src_step1 >= src) )
-                src_bottom += src_step1;
-
-            if( y >= m/2 )
-                src_top += src_step1;
         }
     }
 #undef N
 #undef UPDATE_ACC
 }
 
+static inline void
+medianHistAdd( ushort* h, const ushort* a, int len )
+{
+    int i = 0;
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+    const int nlanes = VTraits<v_uint16>::vlanes();
+    for( ; i <= len - nlanes; i += nlanes )
+        v_store(h + i, v_add_wrap(vx_load(h + i), vx_load(a + i)));
+#endif
+    for( ; i < len; i++ )
+        h[i] = (ushort)(h[i] + a[i]);
+}
+
+static inline void
+medianHistSub( ushort* h, const ushort* a, int len )
+{
+    int i = 0;
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+    const int nlanes = VTraits<v_uint16>::vlanes();
+    for( ; i <= len - nlanes; i += nlanes )
+        v_store(h + i, v_sub_wrap(vx_load(h + i), vx_load(a + i)));
+#endif
+    for( ; i < len; i++ )
+        h[i] = (ushort)(h[i] - a[i]);
+}
+
+static inline void
+medianHistAddSub( ushort* h, const ushort* a, const ushort* b, int len )
+{
+    int i = 0;
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+    const int nlanes = VTraits<v_uint16>::vlanes();
+    for( ; i <= len - nlanes; i += nlanes )
+        v_store(h + i, v_sub_wrap(v_add_wrap(vx_load(h + i), vx_load(a + i)), vx_load(b + i)));
+#endif
+    for( ; i < len; i++ )
+        h[i] = (ushort)(h[i] + a[i] - b[i]);
+}
+
+/*
+ * Perreault-Hebert constant-time median for 16-bit keys with at most `bits`
+ * significant bits. It follows medianBlur_8u_O1, but the coarse and fine
+ * tiers take bits - bits/2 and bits/2 bits respectively (up to 256 x 256
+ * bins), so the column histograms of a stripe grow with the key range and
+ * the stripe is narrowed to keep them within a few megabytes.
+ * Like the 8-bit version, the source carries ksize/2 replicated rows and
+ * columns on each side.
+ */
+static void
+medianBlur_16u_O1( const Mat& _src, Mat& _dst, int ksize, int bits )
+{
+    CV_INSTRUMENT_REGION();
+
+    typedef ushort HT;
+
+#define COP(c,j,x,op) \
+    h_coarse[ nc*(n*c+j) + (x >> fbits) ] op, \
+    h_fine[ nf*(n*(nc*c+(x >> fbits)) + j) + (x & fmask) ] op
+
+    int cn = _dst.channels(), m = _dst.rows, r = (ksize-1)/2;
+    CV_Assert(cn > 0 && cn <= 4 && bits > 0 && bits <= 16);
+    size_t sstep = _src.step1(), dstep = _dst.step1();
+    int fbits = bits/2, nc = 1 << (bits - fbits), nf = 1 << fbits, fmask = nf - 1;
+    int t = 2*r*r + 2*r;
+
+    int maxCols = (int)((size_t)(4 << 20)/((size_t)nc*(nf + 1)*cn*sizeof(HT)));
+    int STRIPE_SIZE = std::min( _dst.cols, std::max(std::min(512/cn, maxCols - 2*r), 32) );
+
+    std::vector<HT> _h_coarse((size_t)nc * (STRIPE_SIZE + 2*r) * cn);
+    std::vector<HT> _h_fine((size_t)nc * nf * (STRIPE_SIZE + 2*r) * cn);
+    std::vector<HT> _H((size_t)nc * (nf + 1));
+    std::vector<int> luc(nc);
+    HT* h_coarse = &_h_coarse[0];
+    HT* h_fine = &_h_fine[0];
+    HT* H_coarse = &_H[0];
+    HT* H_fine = H_coarse + nc;
+
+    for( int x = 0; x < _dst.cols; x += STRIPE_SIZE )
+    {
+        int i, j, k, c, n = std::min(_dst.cols - x, STRIPE_SIZE) + r*2;
+        const ushort* src = _src.ptr<ushort>() + x*cn;
+        ushort* dst = _dst.ptr<ushort>() + x*cn;
+
+        memset( h_coarse, 0, (size_t)nc*n*cn*sizeof(h_coarse[0]) );
+        memset( h_fine, 0, (size_t)nc*nf*n*cn*sizeof(h_fine[0]) );
+
+        // First row initialization, see medianBlur_8u_O1
+        for( c = 0; c < cn; c++ )
+        {
+            for( j = 0; j < n; j++ )
+                COP( c, j, src[cn*j+c], += 2 );
+
+            for( i = 1; i < 2*r; i++ )
+            {
+                const ushort* p = src + sstep*i;
+                for( j = 0; j < n; j++ )
+                    COP( c, j, p[cn*j+c], ++ );
+            }
+        }
+
+        for( i = 0; i < m; i++ )
+        {
+            const ushort* p0 = src + sstep * std::max( 0, i-1 );
+            const ushort* p1 = src + sstep * (i + 2*r);
+
+            for( c = 0; c < cn; c++ )
+            {
+                // Update column histograms for the entire row.
+                for( j = 0; j < n; j++ )
+                {
+                    COP( c, j, p0[j*cn + c], -- );
+                    COP( c, j, p1[j*cn + c], ++ );
+                }
+
+                // The kernel fine histograms are rebuilt lazily, on first use
+                memset( H_coarse, 0, nc*sizeof(H_coarse[0]) );
+                std::fill( luc.begin(), luc.end(), 0 );
+
+                const HT* hc = h_coarse + nc*n*c;
+                for( j = 0; j < 2*r; j++ )
+                    medianHistAdd( H_coarse, hc + nc*j, nc );
+
+                for( j = r; j < n-r; j++ )
+                {
+                    int sum = 0, b;
+                    medianHistAdd( H_coarse, hc + nc*(j + r), nc );
+
+                    // Find median at coarse level
+                    for( k = 0; k < nc; k++ )
+                    {
+                        if( sum + H_coarse[k] > t )
+                            break;
+                        sum += H_coarse[k];
+                    }
+                    CV_Assert( k < nc );
+
+                    // Update corresponding histogram segment
+                    HT* segment = H_fine + nf*k;
+                    const HT* px = h_fine + nf*n*(nc*c + k);
+                    if( luc[k] <= j-r )
+                    {
+                        memset( segment, 0, nf*sizeof(segment[0]) );
+                        for( luc[k] = j-r; luc[k] <= j+r; luc[k]++ )
+                            medianHistAdd( segment, px + nf*luc[k], nf );
+                    }
+                    else
+                    {
+                        for( ; luc[k] <= j+r; luc[k]++ )
+                            medianHistAddSub( segment, px + nf*luc[k], px + nf*(luc[k] - 2*r - 1), nf );
+                    }
+
+                    medianHistSub( H_coarse, hc + nc*(j - r), nc );
+
+                    // Find median in segment
+                    for( b = 0; b < nf; b++ )
+                    {
+                        sum += segment[b];
+                        if( sum > t )
+                            break;
+                    }
+                    CV_Assert( b < nf );
+                    dst[dstep*i + cn*(j - r) + c] = (ushort)((k << fbits) + b);
+                }
+            }
+        }
+    }
+
+#undef COP
+}
+
 
 namespace {
 
@@ -620,7 +775,7 @@ typedef MinMax32f MinMaxVec32f;
 
 template<class Op, class VecOp>
 static void
-medianBlur_SortNet( const Mat& _src, Mat& _dst, int m )
+medianBlur_SortNet( const Mat& _src, Mat& _dst, int m, const Range& rows )
 {
     CV_INSTRUMENT_REGION();
 
@@ -628,8 +783,10 @@ medianBlur_SortNet( const Mat& _src, Mat& _dst, int m )
     typedef typename Op::arg_type WT;
     typedef typename VecOp::arg_type VT;
 
+    // single-row and single-column images are processed as a whole
+    // (the caller does not split them), so dst starts at rows.start == 0
     const T* src = _src.ptr<T>();
-    T* dst = _dst.ptr<T>();
+    T* dst = _dst.ptr<T>(rows.start);
     int sstep = (int)(_src.step/sizeof(T));
     int dstep = (int)(_dst.step/sizeof(T));
     Size size = _dst.size();
@@ -660,7 +817,7 @@ medianBlur_SortNet( const Mat& _src, Mat& _dst, int m )
         }
 
         size.width *= cn;
-        for( i = 0; i < size.height; i++, dst += dstep )
+        for( i = rows.start; i < rows.end; i++, dst += dstep )
         {
             const T* row0 = src + std::max(i - 1, 0)*sstep;
             const T* row1 = src + i*sstep;
@@ -737,7 +894,7 @@ medianBlur_SortNet( const Mat& _src, Mat& _dst, int m )
         }
 
         size.width *= cn;
-        for( i = 0; i < size.height; i++, dst += dstep )
+        for( i = rows.start; i < rows.end; i++, dst += dstep )
         {
             const T* row[5];
             row[0] = src + std::max(i - 2, 0)*sstep;
@@ -838,6 +995,266 @@ medianBlur_SortNet( const Mat& _src, Mat& _dst, int m )
     }
 }
 
+/*
+ * Straightforward selection over the whole aperture, for the inputs the
+ * histogram method cannot take. The source carries ksize/2 replicated rows
+ * and columns on each side.
+ */
+template<typename T>
+static void
+medianBlur_Select( const Mat& _src, Mat& _dst, int ksize )
+{
+    CV_INSTRUMENT_REGION();
+
+    int cn = _dst.channels(), m2 = ksize*ksize;
+    std::vector<T> buf(m2);
+
+    for( int i = 0; i < _dst.rows; i++ )
+    {
+        T* dst = _dst.ptr<T>(i);
+        for( int j = 0; j < _dst.cols*cn; j++ )
+        {
+            T* b = &buf[0];
+            for( int k = 0; k < ksize; k++ )
+            {
+                const T* src = _src.ptr<T>(i + k) + j;
+                for( int l = 0; l < ksize*cn; l += cn )
+                    *b++ = src[l];
+            }
+            std::nth_element( buf.begin(), buf.begin() + m2/2, buf.end() );
+            dst[j] = buf[m2/2];
+        }
+    }
+}
+
+// Maps float bit patterns to unsigned integers of the same order (and back)
+static inline unsigned medianFloatKey( unsigned u )
+{
+    return u ^ ((unsigned)((int)u >> 31) | 0x80000000u);
+}
+
+static inline unsigned medianFloatKeyInv( unsigned k )
+{
+    return k ^ ((unsigned)((int)~k >> 31) | 0x80000000u);
+}
+
+/*
+ * Rank selection over sorted columns for the large apertures of 32F.
+ * Every column of the aperture is kept sorted while the window moves down,
+ * one value is replaced per row. The sorted window of each channel moves
+ * right by one merge pass, which drops the left column and inserts the new
+ * right one, so the median is taken by its index. This is O(ksize^2)
+ * sequential operations per pixel instead of gathering the aperture and
+ * selecting in it. The source carries ksize/2 replicated rows and columns
+ * on each side.
+ */
+static void
+medianBlur_SortedColumns( const Mat& _src, Mat& _dst, int ksize )
+{
+    CV_INSTRUMENT_REGION();
+
+    const int cn = _dst.channels(), m2 = ksize*ksize, ncols = _src.cols*cn;
+    std::vector<unsigned> cols((size_t)ncols*ksize), win(m2), tmp(m2);
+
+    for( int j = 0; j < ncols; j++ )
+    {
+        unsigned* col = &cols[(size_t)j*ksize];
+        for( int k = 0; k < ksize; k++ )
+            col[k] = _src.ptr<unsigned>(k)[j];
+        std::sort(col, col + ksize);
+    }
+
+    for( int i = 0; i < _dst.rows; i++ )
+    {
+        if( i > 0 )
+        {
+            const unsigned* out = _src.ptr<unsigned>(i - 1);
+            const unsigned* in = _src.ptr<unsigned>(i + ksize - 1);
+            for( int j = 0; j < ncols; j++ )
+            {
+                unsigned* col = &cols[(size_t)j*ksize];
+                int k = (int)(std::lower_bound(col, col + ksize, out[j]) - col);
+                unsigned v = in[j];
+                for( ; k > 0 && col[k - 1] > v; k-- )
+                    col[k] = col[k - 1];
+                for( ; k < ksize - 1 && col[k + 1] < v; k++ )
+                    col[k] = col[k + 1];
+                col[k] = v;
+            }
+        }
+
+        unsigned* dst = _dst.ptr<unsigned>(i);
+        for( int c = 0; c < cn; c++ )
+        {
+            for( int k = 0; k < ksize; k++ )
+                std::copy(&cols[(size_t)(k*cn + c)*ksize], &cols[(size_t)(k*cn + c + 1)*ksize], &win[k*ksize]);
+            std::sort(win.begin(), win.end());
+            dst[c] = win[m2/2];
+
+            for( int x = 1; x < _dst.cols; x++ )
+            {
+                const unsigned* out = &cols[(size_t)((x - 1)*cn + c)*ksize];
+                const unsigned* in = &cols[(size_t)((x + ksize - 1)*cn + c)*ksize];
+                int po = 0, pn = 0, t = 0;
+                for( int k = 0; k < m2; k++ )
+                {
+                    unsigned v = win[k];
+                    if( po < ksize && v == out[po] )
+                    {
+                        po++;
+                        continue;
+                    }
+                    for( ; pn < ksize && in[pn] < v; pn++ )
+                        tmp[t++] = in[pn];
+                    tmp[t++] = v;
+                }
+                for( ; pn < ksize; pn++ )
+                    tmp[t++] = in[pn];
+                win.swap(tmp);
+                dst[x*cn + c] = win[m2/2];
+            }
+        }
+    }
+}
+
+static int medianBlurStripes( const Mat& dst, int ksize )
+{
+    // every band re-reads ksize-1 rows of context and re-primes its histograms
+    if( (double)dst.total()*dst.channels()*ksize*ksize < (double)(1 << 18) )
+        return 1;
+    return std::max(1, std::min(getNumThreads(), dst.rows / std::max(16, ksize*4)));
+}
+
+// Runs func(srcBand, dstBand) over horizontal bands of dst in parallel;
+// src carries ksize/2 replicated rows and columns on each side.
+template<typename Func> static void
+medianBlurBands( const Mat& src, Mat& dst, int ksize, const Func& func )
+{
+    CV_Assert( src.rows == dst.rows + ksize - 1 && src.cols == dst.cols + ksize - 1 );
+    parallel_for_(Range(0, dst.rows), [&](const Range& range)
+    {
+        Mat dstBand = dst.rowRange(range);
+        func(src.rowRange(range.start, range.end + ksize - 1), dstBand);
+    }, medianBlurStripes(dst, ksize));
+}
+
+static inline int medianBlurKeyBits( double range )
+{
+    int bits = 1;
+    while( bits < 16 && (double)(1 << bits) <= range )
+        bits++;
+    return bits;
+}
+
+static void
+medianBlur_16( const Mat& src0, Mat& dst, int ksize )
+{
+    int depth = src0.depth(), cn = src0.channels(), r = ksize/2;
+    double vmin = 0, vmax = 0;
+    minMaxIdx(src0.reshape(1), &vmin, &vmax);
+    int bits = medianBlurKeyBits(vmax - vmin);
+
+    Mat src;
+    cv::copyMakeBorder( src0, src, r, r, r, r, BORDER_REPLICATE|BORDER_ISOLATED );
+
+    // even the full 16-bit range with ksize == 7 is several times faster
+    // through the histograms than with selection
+    if( cn > 4 )
+    {
+        if( depth == CV_16U )
+            medianBlurBands(src, dst, ksize, [&](const Mat& s, Mat& d) { medianBlur_Select<ushort>(s, d, ksize); });
+        else
+            medianBlurBands(src, dst, ksize, [&](const Mat& s, Mat& d) { medianBlur_Select<short>(s, d, ksize); });
+        return;
+    }
+
+    // shift the values to keys in [0, 2^bits)
+    bool shifted = depth != CV_16U || vmin != 0;
+    Mat keys = src, dkeys = dst;
+    if( shifted )
+    {
+        src.convertTo(keys, CV_16U, 1, -vmin);
+        dkeys = Mat(dst.size(), CV_16UC(cn));
+    }
+    medianBlurBands(keys, dkeys, ksize, [&](const Mat& s, Mat& d) { medianBlur_16u_O1(s, d, ksize, bits); });
+    if( shifted )
+        dkeys.convertTo(dst, depth, 1, vmin);
+}
+
+static void
+medianBlur_32f( const Mat& src0, Mat& dst, int ksize )
+{
+    int cn = src0.channels(), r = ksize/2, rowlen = src0.cols*cn;
+    Mat src;
+
+    // Replace every value by its rank among the distinct values of the image.
+    // Depth maps and other quantized data rarely have more than 64K of them,
+    // and then the ranks go through the 16-bit histogram method. The count
+    // stops at the first value over the limit, so data which is not quantized
+    // is rejected after a small part of the image.
+    if( cn <= 4 )
+    {
+        std::unordered_set<unsigned> distinct;
+        distinct.reserve(65536);
+        for( int i = 0; i < src0.rows && distinct.size() <= 65536; i++ )
+        {
+            const unsigned* p = src0.ptr<unsigned>(i);
+            for( int j = 0; j < rowlen && distinct.size() <= 65536; j++ )
+                distinct.insert(medianFloatKey(p[j]));
+        }
+
+        if( distinct.size() <= 65536 )
+        {
+            std::vector<unsigned> vals(distinct.begin(), distinct.end());
+            distinct = std::unordered_set<unsigned>();
+            std::sort( vals.begin(), vals.end() );
+
+            Mat ranks(src0.size(), CV_16UC(cn));
+            for( int i = 0; i < src0.rows; i++ )
+            {
+                const unsigned* p = src0.ptr<unsigned>(i);
+                ushort* rk = ranks.ptr<ushort>(i);
+                for( int j = 0; j < rowlen; j++ )
+                    rk[j] = (ushort)(std::lower_bound(vals.begin(), vals.end(), medianFloatKey(p[j])) - vals.begin());
+            }
+            for( size_t k = 0; k < vals.size(); k++ )
+                vals[k] = medianFloatKeyInv(vals[k]);
+
+            int bits = medianBlurKeyBits((double)vals.size() - 1);
+            Mat dkeys(dst.size(), CV_16UC(cn));
+            cv::copyMakeBorder( ranks, src, r, r, r, r, BORDER_REPLICATE|BORDER_ISOLATED );
+            medianBlurBands(src, dkeys, ksize, [&](const Mat& s, Mat& d) { medianBlur_16u_O1(s, d, ksize, bits); });
+
+            for( int i = 0; i < dst.rows; i++ )
+            {
+                const ushort* k = dkeys.ptr<ushort>(i);
+                unsigned* d = dst.ptr<unsigned>(i);
+                for( int j = 0; j < rowlen; j++ )
+                    d[j] = vals[k[j]];
+            }
+            return;
+        }
+    }
+
+    // Otherwise select over order-preserving integer keys, which (unlike
+    // floats with NaNs among them) are always strictly weakly ordered.
+    // The aperture is selected in sorted columns.
+    cv::copyMakeBorder( src0, src, r, r, r, r, BORDER_REPLICATE|BORDER_ISOLATED );
+    for( int i = 0; i < src.rows; i++ )
+    {
+        unsigned* p = src.ptr<unsigned>(i);
+        for( int j = 0; j < src.cols*cn; j++ )
+            p[j] = medianFloatKey(p[j]);
+    }
+    medianBlurBands(src, dst, ksize, [&](const Mat& s, Mat& d) { medianBlur_SortedColumns(s, d, ksize); });
+    for( int i = 0; i < dst.rows; i++ )
+    {
+        unsigned* p = dst.ptr<unsigned>(i);
+        for( int j = 0; j < rowlen; j++ )
+            p[j] = medianFloatKeyInv(p[j]);
+    }
+}
+
 } // namespace anon
 
 void medianBlur(const Mat& src0, /*const*/ Mat& dst, int ksize)
@@ -850,6 +1267,8 @@ void medianBlur(const Mat& src0, /*const*/ Mat& dst, int ksize)
 #endif
         );
 
+    int depth = src0.depth(), cn = src0.channels();
+
     Mat src;
     if( useSortNet )
     {
@@ -858,34 +1277,43 @@ void medianBlur(const Mat& src0, /*const*/ Mat& dst, int ksize)
         else
             src0.copyTo(src);
 
-        if( src.depth() == CV_8U )
-            medianBlur_SortNet<MinMax8u, MinMaxVec8u>( src, dst, ksize );
-        else if( src.depth() == CV_16U )
-            medianBlur_SortNet<MinMax16u, MinMaxVec16u>( src, dst, ksize );
-        else if( src.depth() == CV_16S )
-            medianBlur_SortNet<MinMax16s, MinMaxVec16s>( src, dst, ksize );
-        else if( src.depth() == CV_32F )
-            medianBlur_SortNet<MinMax32f, MinMaxVec32f>( src, dst, ksize );
+        void (*func)(const Mat&, Mat&, int, const Range&) = 0;
+        if( depth == CV_8U )
+            func = medianBlur_SortNet<MinMax8u, MinMaxVec8u>;
+        else if( depth == CV_16U )
+            func = medianBlur_SortNet<MinMax16u, MinMaxVec16u>;
+        else if( depth == CV_16S )
+            func = medianBlur_SortNet<MinMax16s, MinMaxVec16s>;
+        else if( depth == CV_32F )
+            func = medianBlur_SortNet<MinMax32f, MinMaxVec32f>;
         else
             CV_Error(cv::Error::StsUnsupportedFormat, "");
 
-        return;
+        parallel_for_(Range(0, dst.rows), [&](const Range& range)
+        {
+            func( src, dst, ksize, range );
+        }, src.rows > 1 && src.cols > 1 ? medianBlurStripes(dst, ksize) : 1);
     }
-    else
+    else if( depth == CV_8U )
     {
         // TODO AVX guard (external call)
-        cv::copyMakeBorder( src0, src, 0, 0, ksize/2, ksize/2, BORDER_REPLICATE|BORDER_ISOLATED);
+        cv::copyMakeBorder( src0, src, ksize/2, ksize/2, ksize/2, ksize/2, BORDER_REPLICATE|BORDER_ISOLATED);
 
-        int cn = src0.channels();
-        CV_Assert( src.depth() == CV_8U && (cn == 1 || cn == 3 || cn == 4) );
+        CV_Assert( cn == 1 || cn == 3 || cn == 4 );
 
         double img_size_mp = (double)(src0.total())/(1 << 20);
         if( ksize <= 3 + (img_size_mp < 1 ? 12 : img_size_mp < 4 ? 6 : 2)*
             (CV_SIMD ? 1 : 3))
-            medianBlur_8u_Om( src, dst, ksize );
+            medianBlurBands(src, dst, ksize, [&](const Mat& s, Mat& d) { medianBlur_8u_Om(s, d, ksize); });
         else
-            medianBlur_8u_O1( src, dst, ksize );
+            medianBlurBands(src, dst, ksize, [&](const Mat& s, Mat& d) { medianBlur_8u_O1(s, d, ksize); });
     }
+    else if( depth == CV_16U || depth == CV_16S )
+        medianBlur_16( src0, dst, ksize );
+    else if( depth == CV_32F )
+        medianBlur_32f( src0, dst, ksize );
+    else
+        CV_Error(cv::Error::StsUnsupportedFormat, "");
 }
 
 #endif
@@ -444,15 +444,18 @@ static void ocvMorph(int op, int src_type, int dst_type,
     Mat kernel(Size(kernel_width, kernel_height), kernel_type, kernel_data, kernel_step);
     Point anchor(anchor_x, anchor_y);
     Vec<double, 4> borderVal(borderValue);
-    Ptr<FilterEngine> f = createMorphologyFilter(op, src_type, kernel, anchor, borderType, borderType, borderVal);
     Mat src(Size(width, height), src_type, src_data, src_step);
     Mat dst(Size(width, height), dst_type, dst_data, dst_step);
     {
         Point ofs(roi_x, roi_y);
         Size wsz(roi_width, roi_height);
-        f->apply( src, dst, wsz, ofs );
+        applyFilterEngineParallel([&]() {
+                return createMorphologyFilter(op, src_type, kernel, anchor, borderType, borderType, borderVal);
+            }, src, dst, wsz, ofs );
     }
+    if( iterations > 1 )
     {
+        Ptr<FilterEngine> f = createMorphologyFilter(op, src_type, kernel, anchor, borderType, borderType, borderVal);
         Point ofs(roi_x2, roi_y2);
         Size wsz(roi_width2, roi_height2);
         for( int i = 1; i < iterations; i++ )
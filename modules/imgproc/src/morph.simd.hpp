@@ -106,6 +106,11 @@ struct MorphNoVec
     int operator()(uchar**, int, uchar*, int) const { return 0; }
 };
 
+struct MorphCombineNoVec
+{
+    int operator()(const uchar*, const uchar*, uchar*, int) const { return 0; }
+};
+
 #if CV_SIMD // TODO: enable for CV_SIMD_SCALABLE, GCC 13 related
 
 template<class VecUpdate> struct MorphRowVec
@@ -406,6 +411,36 @@ template<class VecUpdate> struct MorphVec
     }
 };
 
+template<class VecUpdate> struct MorphCombineVec
+{
+    typedef typename VecUpdate::vtype vtype;
+    typedef typename VTraits<vtype>::lane_type stype;
+    int operator()(const uchar* _a, const uchar* _b, uchar* _dst, int len) const
+    {
+        const stype* a = (const stype*)_a;
+        const stype* b = (const stype*)_b;
+        stype* dst = (stype*)_dst;
+        const int vlanes = VTraits<vtype>::vlanes();
+        VecUpdate updateOp;
+        int i = 0;
+
+        // all the loads precede the stores, so dst may be a or b shifted by a non-negative offset
+        for( ; i <= len - 2*vlanes; i += 2*vlanes )
+        {
+            vtype a0 = vx_load(a + i), a1 = vx_load(a + i + vlanes);
+            vtype b0 = vx_load(b + i), b1 = vx_load(b + i + vlanes);
+            v_store(dst + i, updateOp(a0, b0));
+            v_store(dst + i + vlanes, updateOp(a1, b1));
+        }
+        if( i <= len - vlanes )
+        {
+            v_store(dst + i, updateOp(vx_load(a + i), vx_load(b + i)));
+            i += vlanes;
+        }
+        return i;
+    }
+};
+
 template <typename T> struct VMin
 {
     typedef T vtype;
@@ -444,6 +479,15 @@ typedef MorphVec<VMax<v_int16> > DilateVec16s;
 typedef MorphVec<VMin<v_float32> > ErodeVec32f;
 typedef MorphVec<VMax<v_float32> > DilateVec32f;
 
+typedef MorphCombineVec<VMin<v_uint8> > ErodeCombineVec8u;
+typedef MorphCombineVec<VMax<v_uint8> > DilateCombineVec8u;
+typedef MorphCombineVec<VMin<v_uint16> > ErodeCombineVec16u;
+typedef MorphCombineVec<VMax<v_uint16> > DilateCombineVec16u;
+typedef MorphCombineVec<VMin<v_int16> > ErodeCombineVec16s;
+typedef MorphCombineVec<VMax<v_int16> > DilateCombineVec16s;
+typedef MorphCombineVec<VMin<v_float32> > ErodeCombineVec32f;
+typedef MorphCombineVec<VMax<v_float32> > DilateCombineVec32f;
+
 #else
 
 typedef MorphRowNoVec ErodeRowVec8u;
@@ -475,6 +519,15 @@ typedef MorphNoVec DilateVec16s;
 typedef MorphNoVec ErodeVec32f;
 typedef MorphNoVec DilateVec32f;
 
+typedef MorphCombineNoVec ErodeCombineVec8u;
+typedef MorphCombineNoVec DilateCombineVec8u;
+typedef MorphCombineNoVec ErodeCombineVec16u;
+typedef MorphCombineNoVec DilateCombineVec16u;
+typedef MorphCombineNoVec ErodeCombineVec16s;
+typedef MorphCombineNoVec DilateCombineVec16s;
+typedef MorphCombineNoVec ErodeCombineVec32f;
+typedef MorphCombineNoVec DilateCombineVec32f;
+
 #endif
 
 typedef MorphRowNoVec ErodeRowVec64f;
@@ -483,6 +536,26 @@ typedef MorphColumnNoVec ErodeColumnVec64f;
 typedef MorphColumnNoVec DilateColumnVec64f;
 typedef MorphNoVec ErodeVec64f;
 typedef MorphNoVec DilateVec64f;
+typedef MorphCombineNoVec ErodeCombineVec64f;
+typedef MorphCombineNoVec DilateCombineVec64f;
+
+// the row and column filters below take O(log(ksize)) and O(1) operations per pixel
+// instead of O(ksize); they pay off only starting from moderate kernel sizes
+enum
+{
+    MORPH_ROW_LOG_MIN_KSIZE = 8,
+    MORPH_COLUMN_VHGW_MIN_KSIZE = 8
+};
+
+// dst[i] = op(a[i], b[i]), i < len; dst may coincide with a or with b.
+template<class Op, class CombineVec> static inline void
+morphCombine(const typename Op::rtype* a, const typename Op::rtype* b, typename Op::rtype* dst, int len)
+{
+    Op op;
+    int i = CombineVec()((const uchar*)a, (const uchar*)b, (uchar*)dst, len);
+    for( ; i < len; i++ )
+        dst[i] = op(a[i], b[i]);
+}
 
 
 template<class Op, class VecOp> struct MorphRowFilter : public BaseRowFilter
@@ -638,6 +711,108 @@ template<class Op, class VecOp> struct MorphColumnFilter : public BaseColumnFilt
 };
 
 
+/*
+ Erosion/dilation of a row by a long horizontal line.
+
+ The line of ksize pixels is the union of two overlapping lines of l pixels, where l is the largest
+ power of two not exceeding ksize, and those are built by doubling: the line of 2*n pixels is the line
+ of n pixels combined with itself shifted by n. This takes O(log(ksize)) operations per pixel.
+*/
+template<class Op, class CombineVec> struct MorphRowLogFilter : public BaseRowFilter
+{
+    typedef typename Op::rtype T;
+
+    MorphRowLogFilter( int _ksize, int _anchor )
+    {
+        ksize = _ksize;
+        anchor = _anchor;
+    }
+
+    void operator()(const uchar* src, uchar* dst, int width, int cn) CV_OVERRIDE
+    {
+        CV_INSTRUMENT_REGION();
+
+        int l, len = (width + ksize - 1)*cn;
+        buf.resize(len);
+        T* B = &buf[0];
+        const T* S = (const T*)src;
+
+        morphCombine<Op, CombineVec>(S, S + cn, B, len - cn);
+        for( l = 2; l*2 <= ksize; l *= 2 )
+            morphCombine<Op, CombineVec>(B, B + l*cn, B, len - (l*2 - 1)*cn);
+        morphCombine<Op, CombineVec>(B, B + (ksize - l)*cn, (T*)dst, width*cn);
+    }
+
+    std::vector<T> buf;
+};
+
+
+/*
+ Erosion/dilation of columns by a long vertical line (van Herk/Gil-Werman).
+
+ The windows of n <= ksize consecutive output rows all contain the source rows n-1 ... ksize-1,
+ so this part is computed once, and every output row adds the partial result over the rows
+ above it (a suffix) and below it (a prefix). Requesting batches of ksize rows from the engine,
+ this takes about 3 operations per pixel independently of the kernel size.
+*/
+template<class Op, class CombineVec> struct MorphColumnVHGWFilter : public BaseColumnFilter
+{
+    typedef typename Op::rtype T;
+
+    MorphColumnVHGWFilter( int _ksize, int _anchor )
+    {
+        ksize = _ksize;
+        anchor = _anchor;
+        batchRows = _ksize;
+    }
+
+    void operator()(const uchar** _src, uchar* dst, int dststep, int count, int width) CV_OVERRIDE
+    {
+        CV_INSTRUMENT_REGION();
+
+        const T** src = (const T**)_src;
+        T* D = (T*)dst;
+        dststep /= sizeof(D[0]);
+        buf.resize(width);
+        T* prefix = &buf[0];
+
+        for( int n; count > 0; count -= n, src += n, D += dststep*n )
+        {
+            int i;
+            n = std::min(count, ksize);
+
+            T* Dc = D + dststep*(n-1);
+            if( n < ksize )
+            {
+                morphCombine<Op, CombineVec>(src[n-1], src[n], Dc, width);
+                for( i = n+1; i < ksize; i++ )
+                    morphCombine<Op, CombineVec>(Dc, src[i], Dc, width);
+            }
+            else
+                memcpy(Dc, src[n-1], width*sizeof(T));
+
+            // suffixes: output row i also covers the source rows i ... n-2
+            for( i = n-2; i >= 0; i-- )
+                morphCombine<Op, CombineVec>(D + dststep*(i+1), src[i], D + dststep*i, width);
+
+            // prefixes: output row i also covers the source rows ksize ... ksize+i-1
+            if( n > 1 )
+            {
+                const T* p = src[ksize];
+                morphCombine<Op, CombineVec>(D + dststep, p, D + dststep, width);
+                for( i = 2; i < n; i++, p = prefix )
+                {
+                    morphCombine<Op, CombineVec>(p, src[ksize+i-1], prefix, width);
+                    morphCombine<Op, CombineVec>(D + dststep*i, prefix, D + dststep*i, width);
+                }
+            }
+        }
+    }
+
+    std::vector<T> buf;
+};
+
+
 template<class Op, class VecOp> struct MorphFilter : BaseFilter
 {
     typedef typename Op::rtype T;
@@ -716,6 +891,45 @@ Ptr<BaseRowFilter> getMorphologyRowFilter(int op, int type, int ksize, int ancho
     if( anchor < 0 )
         anchor = ksize/2;
     CV_Assert( op == MORPH_ERODE || op == MORPH_DILATE );
+    if( ksize >= MORPH_ROW_LOG_MIN_KSIZE )
+    {
+        if( op == MORPH_ERODE )
+        {
+            if( depth == CV_8U )
+                return makePtr<MorphRowLogFilter<MinOp<uchar>,
+                                                 ErodeCombineVec8u> >(ksize, anchor);
+            if( depth == CV_16U )
+                return makePtr<MorphRowLogFilter<MinOp<ushort>,
+                                                 ErodeCombineVec16u> >(ksize, anchor);
+            if( depth == CV_16S )
+                return makePtr<MorphRowLogFilter<MinOp<short>,
+                                                 ErodeCombineVec16s> >(ksize, anchor);
+            if( depth == CV_32F )
+                return makePtr<MorphRowLogFilter<MinOp<float>,
+                                                 ErodeCombineVec32f> >(ksize, anchor);
+            if( depth == CV_64F )
+                return makePtr<MorphRowLogFilter<MinOp<double>,
+                                                 ErodeCombineVec64f> >(ksize, anchor);
+        }
+        else
+        {
+            if( depth == CV_8U )
+                return makePtr<MorphRowLogFilter<MaxOp<uchar>,
+                                                 DilateCombineVec8u> >(ksize, anchor);
+            if( depth == CV_16U )
+                return makePtr<MorphRowLogFilter<MaxOp<ushort>,
+                                                 DilateCombineVec16u> >(ksize, anchor);
+            if( depth == CV_16S )
+                return makePtr<MorphRowLogFilter<MaxOp<short>,
+                                                 DilateCombineVec16s> >(ksize, anchor);
+            if( depth == CV_32F )
+                return makePtr<MorphRowLogFilter<MaxOp<float>,
+                                                 DilateCombineVec32f> >(ksize, anchor);
+            if( depth == CV_64F )
+                return makePtr<MorphRowLogFilter<MaxOp<double>,
+                                                 DilateCombineVec64f> >(ksize, anchor);
+        }
+    }
     if( op == MORPH_ERODE )
     {
         if( depth == CV_8U )
@@ -764,6 +978,45 @@ Ptr<BaseColumnFilter> getMorphologyColumnFilter(int op, int type, int ksize, int
     if( anchor < 0 )
         anchor = ksize/2;
     CV_Assert( op == MORPH_ERODE || op == MORPH_DILATE );
+    if( ksize >= MORPH_COLUMN_VHGW_MIN_KSIZE )
+    {
+        if( op == MORPH_ERODE )
+        {
+            if( depth == CV_8U )
+                return makePtr<MorphColumnVHGWFilter<MinOp<uchar>,
+                                                     ErodeCombineVec8u> >(ksize, anchor);
+            if( depth == CV_16U )
+                return makePtr<MorphColumnVHGWFilter<MinOp<ushort>,
+                                                     ErodeCombineVec16u> >(ksize, anchor);
+            if( depth == CV_16S )
+                return makePtr<MorphColumnVHGWFilter<MinOp<short>,
+                                                     ErodeCombineVec16s> >(ksize, anchor);
+            if( depth == CV_32F )
+                return makePtr<MorphColumnVHGWFilter<MinOp<float>,
+                                                     ErodeCombineVec32f> >(ksize, anchor);
+            if( depth == CV_64F )
+                return makePtr<MorphColumnVHGWFilter<MinOp<double>,
+                                                     ErodeCombineVec64f> >(ksize, anchor);
+        }
+        else
+        {
+            if( depth == CV_8U )
+                return makePtr<MorphColumnVHGWFilter<MaxOp<uchar>,
+                                                     DilateCombineVec8u> >(ksize, anchor);
+            if( depth == CV_16U )
+                return makePtr<MorphColumnVHGWFilter<MaxOp<ushort>,
+                                                     DilateCombineVec16u> >(ksize, anchor);
+            if( depth == CV_16S )
+                return makePtr<MorphColumnVHGWFilter<MaxOp<short>,
+                                                     DilateCombineVec16s> >(ksize, anchor);
+            if( depth == CV_32F )
+                return makePtr<MorphColumnVHGWFilter<MaxOp<float>,
+                                                     DilateCombineVec32f> >(ksize, anchor);
+            if( depth == CV_64F )
+                return makePtr<MorphColumnVHGWFilter<MaxOp<double>,
+                                                     DilateCombineVec64f> >(ksize, anchor);
+        }
+    }
     if( op == MORPH_ERODE )
     {
         if( depth == CV_8U )
@@ -563,15 +563,169 @@ static bool ocl_matchTemplate( InputArray _img, InputArray _templ, OutputArray _
 
 #include "opencv2/core/hal/hal.hpp"
 
-void crossCorr( const Mat& img, const Mat& _templ, Mat& corr,
-                Point anchor, double delta, int borderType )
+class CrossCorrInvoker : public ParallelLoopBody
+{
+public:
+    CrossCorrInvoker(const Mat& _img0, Size _templSize, const Mat& _dftTempl, Mat& _corr,
+                     Point _anchor, double _delta, int _borderType, Size _blocksize, Size _dftsize,
+                     int _tileCountX, int _maxDepth) :
+        img0(_img0), templSize(_templSize), dftTempl(_dftTempl), corr(_corr), anchor(_anchor),
+        delta(_delta), borderType(_borderType), blocksize(_blocksize), dftsize(_dftsize),
+        tileCountX(_tileCountX), maxDepth(_maxDepth)
+    {}
+
+    void operator()(const Range& range) const CV_OVERRIDE
+    {
+        int depth = img0.depth(), cn = img0.channels();
+        int cdepth = corr.depth(), ccn = corr.channels();
+        int tcn = dftTempl.rows / dftsize.height;
+
+        int bufSize = 0;
+        if( cn > 1 && depth != maxDepth )
+            bufSize = (blocksize.width + templSize.width - 1)*
+                (blocksize.height + templSize.height - 1)*CV_ELEM_SIZE(depth);
+
+        if( (ccn > 1 || cn > 1) && cdepth != maxDepth )
+            bufSize = std::max( bufSize, blocksize.width*blocksize.height*CV_ELEM_SIZE(cdepth));
+
+        std::vector<uchar> buf(bufSize);
+        Mat dftImg( dftsize, maxDepth );
+
+        Ptr<hal::DFT2D> cF, cR;
+        int f = CV_HAL_DFT_IS_INPLACE;
+        int f_inv = f | CV_HAL_DFT_INVERSE | CV_HAL_DFT_SCALE;
+        cF = hal::DFT2D::create(dftsize.width, dftsize.height, maxDepth, 1, 1, f, blocksize.height + templSize.height - 1);
+        cR = hal::DFT2D::create(dftsize.width, dftsize.height, maxDepth, 1, 1, f_inv, blocksize.height);
+
+        // calculate correlation by blocks
+        for( int i = range.start; i < range.end; i++ )
+        {
+            int x = (i%tileCountX)*blocksize.width;
+            int y = (i/tileCountX)*blocksize.height;
+
+            Size bsz(std::min(blocksize.width, corr.cols - x),
+                     std::min(blocksize.height, corr.rows - y));
+            Size dsz(bsz.width + templSize.width - 1, bsz.height + templSize.height - 1);
+            int x0 = x - anchor.x, y0 = y - anchor.y;
+            int x1 = std::max(0, x0), y1 = std::max(0, y0);
+            int x2 = std::min(img0.cols, x0 + dsz.width);
+            int y2 = std::min(img0.rows, y0 + dsz.height);
+            Mat src0(img0, Range(y1, y2), Range(x1, x2));
+            Mat dst(dftImg, Rect(0, 0, dsz.width, dsz.height));
+            Mat dst1(dftImg, Rect(x1-x0, y1-y0, x2-x1, y2-y1));
+            Mat cdst(corr, Rect(x, y, bsz.width, bsz.height));
+
+            for( int k = 0; k < cn; k++ )
+            {
+                Mat src = src0;
+                dftImg = Scalar::all(0);
+
+                if( cn > 1 )
+                {
+                    src = depth == maxDepth ? dst1 : Mat(y2-y1, x2-x1, depth, &buf[0]);
+                    int pairs[] = {k, 0};
+                    mixChannels(&src0, 1, &src, 1, pairs, 1);
+                }
+
+                if( dst1.data != src.data )
+                    src.convertTo(dst1, dst1.depth());
+
+                if( x2 - x1 < dsz.width || y2 - y1 < dsz.height )
+                    copyMakeBorder(dst1, dst, y1-y0, dst.rows-dst1.rows-(y1-y0),
+                                   x1-x0, dst.cols-dst1.cols-(x1-x0), borderType);
+
+                if (bsz.height == blocksize.height)
+                    cF->apply(dftImg.data, (int)dftImg.step, dftImg.data, (int)dftImg.step);
+                else
+                    dft( dftImg, dftImg, 0, dsz.height );
+
+                Mat dftTempl1(dftTempl, Rect(0, tcn > 1 ? k*dftsize.height : 0,
+                                             dftsize.width, dftsize.height));
+                mulSpectrums(dftImg, dftTempl1, dftImg, 0, true);
+
+                if (bsz.height == blocksize.height)
+                    cR->apply(dftImg.data, (int)dftImg.step, dftImg.data, (int)dftImg.step);
+                else
+                    dft( dftImg, dftImg, DFT_INVERSE + DFT_SCALE, bsz.height );
+
+                src = dftImg(Rect(0, 0, bsz.width, bsz.height));
+
+                if( ccn > 1 )
+                {
+                    if( cdepth != maxDepth )
+                    {
+                        Mat plane(bsz, cdepth, &buf[0]);
+                        src.convertTo(plane, cdepth, 1, delta);
+                        src = plane;
+                    }
+                    int pairs[] = {0, k};
+                    mixChannels(&src, 1, &cdst, 1, pairs, 1);
+                }
+                else
+                {
+                    if( k == 0 )
+                        src.convertTo(cdst, cdepth, 1, delta);
+                    else
+                    {
+                        if( maxDepth != cdepth )
+                        {
+                            Mat plane(bsz, cdepth, &buf[0]);
+                            src.convertTo(plane, cdepth);
+                            src = plane;
+                        }
+                        add(src, cdst, cdst);
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    const Mat& img0;
+    Size templSize;
+    const Mat& dftTempl;
+    Mat& corr;
+    Point anchor;
+    double delta;
+    int borderType;
+    Size blocksize, dftsize;
+    int tileCountX, maxDepth;
+};
+
+// Picks the correlation block (tile) size and the matching DFT size for the template size
+static Size crossCorrBlockSize( Size templSize, Size corrSize, Size& dftsize )
 {
     const double blockScale = 4.5;
     const int minBlockSize = 256;
+    Size blocksize;
+
+    blocksize.width = cvRound(templSize.width*blockScale);
+    blocksize.width = std::max( blocksize.width, minBlockSize - templSize.width + 1 );
+    blocksize.width = std::min( blocksize.width, corrSize.width );
+    blocksize.height = cvRound(templSize.height*blockScale);
+    blocksize.height = std::max( blocksize.height, minBlockSize - templSize.height + 1 );
+    blocksize.height = std::min( blocksize.height, corrSize.height );
+
+    dftsize.width = std::max(getOptimalDFTSize(blocksize.width + templSize.width - 1), 2);
+    dftsize.height = getOptimalDFTSize(blocksize.height + templSize.height - 1);
+    if( dftsize.width <= 0 || dftsize.height <= 0 )
+        CV_Error( cv::Error::StsOutOfRange, "the input arrays are too big" );
+
+    // recompute block size
+    blocksize.width = dftsize.width - templSize.width + 1;
+    blocksize.width = MIN( blocksize.width, corrSize.width );
+    blocksize.height = dftsize.height - templSize.height + 1;
+    blocksize.height = MIN( blocksize.height, corrSize.height );
+    return blocksize;
+}
+
+void crossCorr( const Mat& img, const Mat& _templ, Mat& corr,
+                Point anchor, double delta, int borderType )
+{
     std::vector<uchar> buf;
 
     Mat templ = _templ;
-    int depth = img.depth(), cn = img.channels();
+    int depth = img.depth();
     int tdepth = templ.depth(), tcn = templ.channels();
     int cdepth = corr.depth(), ccn = corr.channels();
 
@@ -590,40 +744,14 @@ void crossCorr( const Mat& img, const Mat& _templ, Mat& corr,
     CV_Assert( ccn == 1 || delta == 0 );
 
     int maxDepth = depth > CV_8S ? CV_64F : std::max(std::max(CV_32F, tdepth), cdepth);
-    Size blocksize, dftsize;
-
-    blocksize.width = cvRound(templ.cols*blockScale);
-    blocksize.width = std::max( blocksize.width, minBlockSize - templ.cols + 1 );
-    blocksize.width = std::min( blocksize.width, corr.cols );
-    blocksize.height = cvRound(templ.rows*blockScale);
-    blocksize.height = std::max( blocksize.height, minBlockSize - templ.rows + 1 );
-    blocksize.height = std::min( blocksize.height, corr.rows );
-
-    dftsize.width = std::max(getOptimalDFTSize(blocksize.width + templ.cols - 1), 2);
-    dftsize.height = getOptimalDFTSize(blocksize.height + templ.rows - 1);
-    if( dftsize.width <= 0 || dftsize.height <= 0 )
-        CV_Error( cv::Error::StsOutOfRange, "the input arrays are too big" );
-
-    // recompute block size
-    blocksize.width = dftsize.width - templ.cols + 1;
-    blocksize.width = MIN( blocksize.width, corr.cols );
-    blocksize.height = dftsize.height - templ.rows + 1;
-    blocksize.height = MIN( blocksize.height, corr.rows );
+    Size dftsize, blocksize = crossCorrBlockSize(templ.size(), corr.size(), dftsize);
 
     Mat dftTempl( dftsize.height*tcn, dftsize.width, maxDepth );
-    Mat dftImg( dftsize, maxDepth );
 
-    int i, k, bufSize = 0;
+    int k, bufSize = 0;
     if( tcn > 1 && tdepth != maxDepth )
         bufSize = templ.cols*templ.rows*CV_ELEM_SIZE(tdepth);
 
-    if( cn > 1 && depth != maxDepth )
-        bufSize = std::max( bufSize, (blocksize.width + templ.cols - 1)*
-            (blocksize.height + templ.rows - 1)*CV_ELEM_SIZE(depth));
-
-    if( (ccn > 1 || cn > 1) && cdepth != maxDepth )
-        bufSize = std::max( bufSize, blocksize.width*blocksize.height*CV_ELEM_SIZE(cdepth));
-
     buf.resize(bufSize);
 
     Ptr<hal::DFT2D> c = hal::DFT2D::create(dftsize.width, dftsize.height, dftTempl.depth(), 1, 1, CV_HAL_DFT_IS_INPLACE, templ.rows);
@@ -670,93 +798,10 @@ void crossCorr( const Mat& img, const Mat& _templ, Mat& corr,
     }
     borderType |= BORDER_ISOLATED;
 
-    Ptr<hal::DFT2D> cF, cR;
-    int f = CV_HAL_DFT_IS_INPLACE;
-    int f_inv = f | CV_HAL_DFT_INVERSE | CV_HAL_DFT_SCALE;
-    cF = hal::DFT2D::create(dftsize.width, dftsize.height, maxDepth, 1, 1, f, blocksize.height + templ.rows - 1);
-    cR = hal::DFT2D::create(dftsize.width, dftsize.height, maxDepth, 1, 1, f_inv, blocksize.height);
-
-    // calculate correlation by blocks
-    for( i = 0; i < tileCount; i++ )
-    {
-        int x = (i%tileCountX)*blocksize.width;
-        int y = (i/tileCountX)*blocksize.height;
-
-        Size bsz(std::min(blocksize.width, corr.cols - x),
-                 std::min(blocksize.height, corr.rows - y));
-        Size dsz(bsz.width + templ.cols - 1, bsz.height + templ.rows - 1);
-        int x0 = x - anchor.x + roiofs.x, y0 = y - anchor.y + roiofs.y;
-        int x1 = std::max(0, x0), y1 = std::max(0, y0);
-        int x2 = std::min(img0.cols, x0 + dsz.width);
-        int y2 = std::min(img0.rows, y0 + dsz.height);
-        Mat src0(img0, Range(y1, y2), Range(x1, x2));
-        Mat dst(dftImg, Rect(0, 0, dsz.width, dsz.height));
-        Mat dst1(dftImg, Rect(x1-x0, y1-y0, x2-x1, y2-y1));
-        Mat cdst(corr, Rect(x, y, bsz.width, bsz.height));
-
-        for( k = 0; k < cn; k++ )
-        {
-            Mat src = src0;
-            dftImg = Scalar::all(0);
-
-            if( cn > 1 )
-            {
-                src = depth == maxDepth ? dst1 : Mat(y2-y1, x2-x1, depth, &buf[0]);
-                int pairs[] = {k, 0};
-                mixChannels(&src0, 1, &src, 1, pairs, 1);
-            }
-
-            if( dst1.data != src.data )
-                src.convertTo(dst1, dst1.depth());
-
-            if( x2 - x1 < dsz.width || y2 - y1 < dsz.height )
-                copyMakeBorder(dst1, dst, y1-y0, dst.rows-dst1.rows-(y1-y0),
-                               x1-x0, dst.cols-dst1.cols-(x1-x0), borderType);
-
-            if (bsz.height == blocksize.height)
-                cF->apply(dftImg.data, (int)dftImg.step, dftImg.data, (int)dftImg.step);
-            else
-                dft( dftImg, dftImg, 0, dsz.height );
-
-            Mat dftTempl1(dftTempl, Rect(0, tcn > 1 ? k*dftsize.height : 0,
-                                         dftsize.width, dftsize.height));
-            mulSpectrums(dftImg, dftTempl1, dftImg, 0, true);
-
-            if (bsz.height == blocksize.height)
-                cR->apply(dftImg.data, (int)dftImg.step, dftImg.data, (int)dftImg.step);
-            else
-                dft( dftImg, dftImg, DFT_INVERSE + DFT_SCALE, bsz.height );
-
-            src = dftImg(Rect(0, 0, bsz.width, bsz.height));
-
-            if( ccn > 1 )
-            {
-                if( cdepth != maxDepth )
-                {
-                    Mat plane(bsz, cdepth, &buf[0]);
-                    src.convertTo(plane, cdepth, 1, delta);
-                    src = plane;
-                }
-                int pairs[] = {0, k};
-                mixChannels(&src, 1, &cdst, 1, pairs, 1);
-            }
-            else
-            {
-                if( k == 0 )
-                    src.convertTo(cdst, cdepth, 1, delta);
-                else
-                {
-                    if( maxDepth != cdepth )
-                    {
-                        Mat plane(bsz, cdepth, &buf[0]);
-                        src.convertTo(plane, cdepth);
-                        src = plane;
-                    }
-                    add(src, cdst, cdst);
-                }
-            }
-        }
-    }
+    // the tiles are independent and write disjoint parts of corr
+    CrossCorrInvoker invoker(img0, templ.size(), dftTempl, corr, anchor - roiofs, delta, borderType,
+                             blocksize, dftsize, tileCountX, maxDepth);
+    parallel_for_(Range(0, tileCount), invoker, std::min(tileCount, getNumThreads()));
 }
 
 static void matchTemplateMask( InputArray _img, InputArray _templ, OutputArray _result, int method, InputArray _mask )
@@ -903,7 +948,9 @@ static void matchTemplateMask( InputArray _img, InputArray _templ, OutputArray _
     }
 }
 
-static void common_matchTemplate( Mat& img, Mat& templ, Mat& result, int method, int cn )
+// Turns the cross-correlation in result into the requested measure; sum and sqsum
+// are the 64F integrals of the image (sqsum is not needed for TM_CCOEFF)
+static void common_matchTemplate( const Mat& sum, const Mat& sqsum, const Mat& templ, Mat& result, int method, int cn )
 {
     if( method == cv::TM_CCORR )
         return;
@@ -916,19 +963,16 @@ static void common_matchTemplate( Mat& img, Mat& templ, Mat& result, int method,
 
     double invArea = 1./((double)templ.rows * templ.cols);
 
-    Mat sum, sqsum;
     Scalar templMean, templSdv;
     double *q0 = 0, *q1 = 0, *q2 = 0, *q3 = 0;
     double templNorm = 0, templSum2 = 0;
 
     if( method == cv::TM_CCOEFF )
     {
-        integral(img, sum, CV_64F);
         templMean = mean(templ);
     }
     else
     {
-        integral(img, sum, sqsum, CV_64F);
         meanStdDev( templ, templMean, templSdv );
 
         templNorm = templSdv[0]*templSdv[0] + templSdv[1]*templSdv[1] + templSdv[2]*templSdv[2] + templSdv[3]*templSdv[3];
@@ -1027,6 +1071,20 @@ static void common_matchTemplate( Mat& img, Mat& templ, Mat& result, int method,
         }
     }
 }
+
+static void common_matchTemplate( Mat& img, Mat& templ, Mat& result, int method, int cn )
+{
+    if( method == cv::TM_CCORR )
+        return;
+
+    Mat sum, sqsum;
+    if( method == cv::TM_CCOEFF )
+        integral(img, sum, CV_64F);
+    else
+        integral(img, sum, sqsum, CV_64F);
+
+    common_matchTemplate( sum, sqsum, templ, result, method, cn );
+}
 }
 
 
@@ -1193,6 +1251,221 @@ void cv::matchTemplate( InputArray _img, InputArray _templ, OutputArray _result,
     common_matchTemplate(img, templ, result, method, cn);
 }
 
+namespace cv
+{
+
+class TemplateMatcherInvoker : public ParallelLoopBody
+{
+public:
+    TemplateMatcherInvoker(const Mat& _img, const std::vector<Mat>& _spectra, std::vector<Mat>& _results,
+                           Size _maxTemplSize, Size _blocksize, Size _dftsize, int _tileCountX, int _maxDepth) :
+        img(_img), spectra(_spectra), results(_results), maxTemplSize(_maxTemplSize),
+        blocksize(_blocksize), dftsize(_dftsize), tileCountX(_tileCountX), maxDepth(_maxDepth)
+    {}
+
+    void operator()(const Range& range) const CV_OVERRIDE
+    {
+        int cn = img.channels();
+        std::vector<Mat> dftImg(cn);
+        Mat plane, acc(dftsize, maxDepth), prod;
+        for( int k = 0; k < cn; k++ )
+            dftImg[k].create(dftsize, maxDepth);
+
+        int f = CV_HAL_DFT_IS_INPLACE;
+        int f_inv = f | CV_HAL_DFT_INVERSE | CV_HAL_DFT_SCALE;
+        Ptr<hal::DFT2D> cF = hal::DFT2D::create(dftsize.width, dftsize.height, maxDepth, 1, 1, f,
+                                                blocksize.height + maxTemplSize.height - 1);
+        Ptr<hal::DFT2D> cR = hal::DFT2D::create(dftsize.width, dftsize.height, maxDepth, 1, 1, f_inv,
+                                                blocksize.height);
+
+        for( int i = range.start; i < range.end; i++ )
+        {
+            int x = (i%tileCountX)*blocksize.width;
+            int y = (i/tileCountX)*blocksize.height;
+            int x2 = std::min(img.cols, x + blocksize.width + maxTemplSize.width - 1);
+            int y2 = std::min(img.rows, y + blocksize.height + maxTemplSize.height - 1);
+            Mat src0(img, Range(y, y2), Range(x, x2));
+
+            // the spectrum of the image block is shared by all the templates
+            for( int k = 0; k < cn; k++ )
+            {
+                Mat& dst = dftImg[k];
+                Mat dst1(dst, Rect(0, 0, x2 - x, y2 - y));
+                dst = Scalar::all(0);
+                if( cn > 1 )
+                {
+                    extractChannel(src0, plane, k);
+                    plane.convertTo(dst1, maxDepth);
+                }
+                else
+                    src0.convertTo(dst1, maxDepth);
+                cF->apply(dst.data, (int)dst.step, dst.data, (int)dst.step);
+            }
+
+            for( size_t t = 0; t < results.size(); t++ )
+            {
+                Mat& result = results[t];
+                if( x >= result.cols || y >= result.rows )
+                    continue;
+
+                // the transform is linear, so the channels are summed up before the inverse DFT
+                for( int k = 0; k < cn; k++ )
+                {
+                    Mat spect(spectra[t], Rect(0, k*dftsize.height, dftsize.width, dftsize.height));
+                    mulSpectrums(dftImg[k], spect, k == 0 ? acc : prod, 0, true);
+                    if( k > 0 )
+                        add(acc, prod, acc);
+                }
+                cR->apply(acc.data, (int)acc.step, acc.data, (int)acc.step);
+
+                Rect roi(x, y, std::min(blocksize.width, result.cols - x), std::min(blocksize.height, result.rows - y));
+                acc(Rect(Point(), roi.size())).convertTo(result(roi), CV_32F);
+            }
+        }
+    }
+
+private:
+    const Mat& img;
+    const std::vector<Mat>& spectra;
+    std::vector<Mat>& results;
+    Size maxTemplSize, blocksize, dftsize;
+    int tileCountX, maxDepth;
+};
+
+class TemplateMatcherImpl CV_FINAL : public TemplateMatcher
+{
+public:
+    TemplateMatcherImpl(InputArrayOfArrays _templs, int _method);
+
+    void match(InputArray image, OutputArrayOfArrays results) CV_OVERRIDE;
+    int getTemplatesCount() const CV_OVERRIDE { return (int)templs.size(); }
+    int getMethod() const CV_OVERRIDE { return method; }
+
+private:
+    void computeSpectra(Size dftsize);
+
+    std::vector<Mat> templs;
+    // per template: the DFT of each zero-padded template plane, stacked vertically
+    std::vector<Mat> spectra;
+    Size maxTemplSize, minTemplSize;
+    Size spectraDftSize;
+    int method, type, maxDepth;
+};
+
+TemplateMatcherImpl::TemplateMatcherImpl(InputArrayOfArrays _templs, int _method)
+{
+    CV_Assert( cv::TM_SQDIFF <= _method && _method <= cv::TM_CCOEFF_NORMED );
+
+    std::vector<Mat> src;
+    _templs.getMatVector(src);
+    CV_Assert( !src.empty() );
+
+    method = _method;
+    type = src[0].type();
+    int depth = CV_MAT_DEPTH(type);
+    CV_Assert( depth == CV_8U || depth == CV_32F );
+    maxDepth = depth == CV_8U ? CV_32F : CV_64F;
+
+    maxTemplSize = Size(0, 0);
+    minTemplSize = Size(INT_MAX, INT_MAX);
+    templs.resize(src.size());
+    for( size_t i = 0; i < src.size(); i++ )
+    {
+        CV_Assert( src[i].type() == type && src[i].dims <= 2 && !src[i].empty() );
+        templs[i] = src[i].clone();
+        maxTemplSize.width = std::max(maxTemplSize.width, src[i].cols);
+        maxTemplSize.height = std::max(maxTemplSize.height, src[i].rows);
+        minTemplSize.width = std::min(minTemplSize.width, src[i].cols);
+        minTemplSize.height = std::min(minTemplSize.height, src[i].rows);
+    }
+}
+
+void TemplateMatcherImpl::computeSpectra(Size dftsize)
+{
+    int cn = CV_MAT_CN(type);
+    spectra.resize(templs.size());
+
+    for( size_t i = 0; i < templs.size(); i++ )
+    {
+        const Mat& templ = templs[i];
+        Mat plane, &spect = spectra[i];
+        spect.create(dftsize.height*cn, dftsize.width, maxDepth);
+        spect = Scalar::all(0);
+
+        Ptr<hal::DFT2D> c = hal::DFT2D::create(dftsize.width, dftsize.height, maxDepth, 1, 1,
+                                               CV_HAL_DFT_IS_INPLACE, templ.rows);
+        for( int k = 0; k < cn; k++ )
+        {
+            Mat dst(spect, Rect(0, k*dftsize.height, dftsize.width, dftsize.height));
+            Mat dst1(dst, Rect(0, 0, templ.cols, templ.rows));
+            if( cn > 1 )
+            {
+                extractChannel(templ, plane, k);
+                plane.convertTo(dst1, maxDepth);
+            }
+            else
+                templ.convertTo(dst1, maxDepth);
+            c->apply(dst.data, (int)dst.step, dst.data, (int)dst.step);
+        }
+    }
+    spectraDftSize = dftsize;
+}
+
+void TemplateMatcherImpl::match(InputArray _img, OutputArrayOfArrays _results)
+{
+    CV_INSTRUMENT_REGION();
+
+    Mat img = _img.getMat();
+    CV_Assert( img.type() == type && img.dims <= 2 &&
+               img.cols >= maxTemplSize.width && img.rows >= maxTemplSize.height );
+
+    int n = (int)templs.size(), cn = CV_MAT_CN(type);
+
+    // one tiling, sized for the largest template, serves all of them; the spectra
+    // are recomputed only when the image size leads to a different DFT size
+    Size corrSize(img.cols - minTemplSize.width + 1, img.rows - minTemplSize.height + 1);
+    Size dftsize, blocksize = crossCorrBlockSize(maxTemplSize, corrSize, dftsize);
+    if( dftsize != spectraDftSize )
+        computeSpectra(dftsize);
+
+    std::vector<Mat> results(n);
+    _results.create(n, 1, CV_32F);
+    for( int i = 0; i < n; i++ )
+    {
+        _results.create(Size(img.cols - templs[i].cols + 1, img.rows - templs[i].rows + 1), CV_32F, i);
+        results[i] = _results.getMat(i);
+    }
+
+    int tileCountX = (corrSize.width + blocksize.width - 1)/blocksize.width;
+    int tileCountY = (corrSize.height + blocksize.height - 1)/blocksize.height;
+    int tileCount = tileCountX * tileCountY;
+
+    TemplateMatcherInvoker invoker(img, spectra, results, maxTemplSize, blocksize, dftsize, tileCountX, maxDepth);
+    parallel_for_(Range(0, tileCount), invoker, std::min(tileCount, getNumThreads()));
+
+    if( method == cv::TM_CCORR )
+        return;
+
+    Mat sum, sqsum;
+    if( method == cv::TM_CCOEFF )
+        integral(img, sum, CV_64F);
+    else
+        integral(img, sum, sqsum, CV_64F);
+
+    parallel_for_(Range(0, n), [&](const Range& range)
+    {
+        for( int i = range.start; i < range.end; i++ )
+            common_matchTemplate(sum, sqsum, templs[i], results[i], method, cn);
+    });
+}
+
+}
+
+cv::Ptr<cv::TemplateMatcher> cv::createTemplateMatcher(InputArrayOfArrays templates, int method)
+{
+    return makePtr<TemplateMatcherImpl>(templates, method);
+}
+
 CV_IMPL void
 cvMatchTemplate( const CvArr* _img, const CvArr* _templ, CvArr* _result, int method )
 {
@@ -551,6 +551,40 @@ TEST_P(Imgproc_FindContours_Modes2, approx)
 
 // TODO: offset test
 
+// Busy images are scanned per connected component in parallel,
+// the result must be the same as the one of the sequential scan
+TEST_P(Imgproc_FindContours_Modes2, parallel)
+{
+    const int mode = get<0>(GetParam());
+    const int method = get<1>(GetParam());
+
+    RNG& rng = TS::ptr()->get_rng();
+    Mat img(Size(1280, 1024), CV_8UC1, Scalar::all(0));
+    for (int i = 0; i < 4000; ++i)
+    {
+        const Point center(rng.uniform(0, img.cols), rng.uniform(0, img.rows));
+        // rings produce holes with other blobs nested inside
+        circle(img, center, rng.uniform(1, 10), Scalar::all(255), rng.uniform(0, 2) ? FILLED : 1);
+    }
+
+    vector<vector<Point>> contours, contours_s;
+    vector<Vec4i> hierarchy, hierarchy_s;
+    const int nthreads = cv::getNumThreads();
+    cv::setNumThreads(1);
+    findContours(img, contours_s, hierarchy_s, mode, method);
+    cv::setNumThreads(4);
+    findContours(img, contours, hierarchy, mode, method);
+    cv::setNumThreads(nthreads);
+
+    ASSERT_EQ(contours_s.size(), contours.size());
+    for (size_t i = 0; i < contours_s.size(); ++i)
+    {
+        SCOPED_TRACE(format("contour = %zu", i));
+        EXPECT_MAT_NEAR(Mat(contours_s[i]), Mat(contours[i]), 0);
+    }
+    EXPECT_MAT_NEAR(Mat(hierarchy_s), Mat(hierarchy), 0);
+}
+
 // no RETR_FLOODFILL - no CV_32S input images
 INSTANTIATE_TEST_CASE_P(
     ,
@@ -2054,6 +2054,38 @@ TEST(Imgproc_Morphology, iterated)
     }
 }
 
+TEST(Imgproc_Morphology, large_rect_kernels)
+{
+    RNG& rng = theRNG();
+    const int depths[] = { CV_8U, CV_16U, CV_16S, CV_32F, CV_64F };
+    for( int iter = 0; iter < 40; iter++ )
+    {
+        int depth = depths[iter % 5];
+        int cn = rng.uniform(1, 5);
+        Size sz(rng.uniform(16, 100), rng.uniform(16, 100));
+        Size ksize(rng.uniform(1, 50), rng.uniform(1, 50));
+        Point anchor(rng.uniform(0, ksize.width), rng.uniform(0, ksize.height));
+        int borderType = iter % 2 == 0 ? BORDER_REPLICATE : BORDER_REFLECT_101;
+        int op = rng.uniform(0, 2);
+        Mat src(sz, CV_MAKETYPE(depth, cn)), dst, ref;
+        randu(src, 0, 256);
+        Mat kernel = getStructuringElement(MORPH_RECT, ksize);
+
+        if( op == 0 )
+        {
+            cv::dilate(src, dst, kernel, anchor, 1, borderType);
+            cvtest::dilate(src, ref, kernel, anchor, borderType);
+        }
+        else
+        {
+            cv::erode(src, dst, kernel, anchor, 1, borderType);
+            cvtest::erode(src, ref, kernel, anchor, borderType);
+        }
+        ASSERT_EQ(0.0, cvtest::norm(dst, ref, NORM_INF))
+            << "depth=" << depth << " cn=" << cn << " size=" << sz << " ksize=" << ksize << " anchor=" << anchor;
+    }
+}
+
 TEST(Imgproc_Sobel, borderTypes)
 {
     int kernelSize = 3;
@@ -2291,6 +2323,72 @@ TEST(Imgproc_MedianBlur, hires_regression_13409)
     ASSERT_EQ(0.0, cvtest::norm(dst_hires(Rect(516, 516, 1016, 1016)), dst_ref(Rect(4, 4, 1016, 1016)), NORM_INF));
 }
 
+static Mat medianBlurReference(const Mat& src0, int ksize)
+{
+    Mat src, dst(src0.size(), CV_64FC(src0.channels()));
+    cv::copyMakeBorder(src0, src, ksize/2, ksize/2, ksize/2, ksize/2, BORDER_REPLICATE);
+    src.convertTo(src, CV_64F);
+    int cn = src0.channels();
+    std::vector<double> buf(ksize*ksize);
+    for (int i = 0; i < dst.rows; i++)
+        for (int j = 0; j < dst.cols*cn; j++)
+        {
+            for (int k = 0; k < ksize; k++)
+                for (int l = 0; l < ksize; l++)
+                    buf[k*ksize + l] = src.ptr<double>(i + k)[j + l*cn];
+            std::nth_element(buf.begin(), buf.begin() + buf.size()/2, buf.end());
+            dst.ptr<double>(i)[j] = buf[buf.size()/2];
+        }
+    dst.convertTo(dst, src0.type());
+    return dst;
+}
+
+typedef testing::TestWithParam<tuple<perf::MatType, int> > Imgproc_MedianBlur_large;
+
+TEST_P(Imgproc_MedianBlur_large, accuracy)
+{
+    const int type = get<0>(GetParam());
+    const int ksize = get<1>(GetParam());
+    const int depth = CV_MAT_DEPTH(type);
+    RNG& rng = TS::ptr()->get_rng();
+
+    const int nthreads = getNumThreads();
+    for (int iter = 0; iter < 4; iter++)
+    {
+        // full value range, narrow (quantized) range, an image that is cut into bands
+        // and an image with more than 64K distinct values
+        Size sz = iter < 2 ? Size(rng.uniform(1, 70), rng.uniform(1, 70)) : iter == 2 ? Size(97, 211) : Size(320, 241);
+        Mat src(sz, type);
+        if (depth == CV_32F)
+        {
+            cvtest::randUni(rng, src, Scalar::all(-1000), Scalar::all(1000));
+            if (iter == 1)
+                src.convertTo(src, CV_16S), src.convertTo(src, type, 0.125);
+        }
+        else
+            cvtest::randUni(rng, src, Scalar::all(depth == CV_16S ? -32768 : 0),
+                            Scalar::all(iter == 1 ? 300 : depth == CV_16S ? 32767 : depth == CV_8U ? 256 : 65536));
+
+        Mat ref = medianBlurReference(src, ksize), dst, dst4;
+        {
+            cv::setNumThreads(1);
+            medianBlur(src, dst, ksize);
+            cv::setNumThreads(4);
+            medianBlur(src, dst4, ksize);
+            cv::setNumThreads(nthreads);
+        }
+        EXPECT_EQ(0, cvtest::norm(dst, ref, NORM_INF)) << "size: " << sz << " iter: " << iter;
+        EXPECT_EQ(0, cvtest::norm(dst4, ref, NORM_INF)) << "size: " << sz << " iter: " << iter;
+
+        medianBlur(src, src, ksize);
+        EXPECT_EQ(0, cvtest::norm(src, ref, NORM_INF)) << "in-place, size: " << sz << " iter: " << iter;
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(/**/, Imgproc_MedianBlur_large, testing::Combine(
+    testing::Values(CV_8UC1, CV_8UC3, CV_16UC1, CV_16UC3, CV_16SC1, CV_32FC1, CV_32FC4),
+    testing::Values(3, 7, 15)));
+
 TEST(Imgproc_Sobel, s16_regression_13506)
 {
     Mat src = (Mat_<short>(8, 16) << 127, 138, 130, 102, 118,  97,  76,  84, 124,  90, 146,  63, 130,  87, 212,  85,
@@ -2551,4 +2649,42 @@ INSTANTIATE_TEST_CASE_P(/**/, Imgproc_sepFilter2D_types,
     testing::Values(CV_16S, CV_32F, CV_64F),
 );
 
+typedef testing::TestWithParam<tuple<perf::MatType, int> > Imgproc_FilterEngine_parallel;
+TEST_P(Imgproc_FilterEngine_parallel, bands_match_single_engine)
+{
+    const int type = get<0>(GetParam()), borderType = get<1>(GetParam());
+    Mat whole(525, 317, type);
+    cvtest::randUni(theRNG(), whole, Scalar::all(0), Scalar::all(255));
+    // a submatrix, so that the rows around the bands and the ROI come from the parent image
+    Mat src = whole(Rect(3, 5, 300, 511));
+
+    Mat kernel(5, 7, CV_32F);
+    cvtest::randUni(theRNG(), kernel, Scalar::all(-1), Scalar::all(1));
+    Mat kx = getGaussianKernel(9, -1, CV_32F), ky = getGaussianKernel(5, -1, CV_32F);
+
+    const int nthreads = getNumThreads();
+    std::vector<Mat> results[2];
+    for (int i = 0; i < 2; i++)
+    {
+        setNumThreads(i == 0 ? 1 : 4);
+        std::vector<Mat>& r = results[i];
+        r.resize(6);
+        cv::filter2D(src, r[0], -1, kernel, Point(-1, -1), 0, borderType);
+        cv::sepFilter2D(src, r[1], CV_32F, kx, ky, Point(-1, -1), 1, borderType);
+        cv::Sobel(src, r[2], CV_32F, 1, 1, 5, 1, 0, borderType);
+        cv::boxFilter(src, r[3], -1, Size(7, 11), Point(-1, -1), true, borderType);
+        cv::sqrBoxFilter(src, r[4], CV_64F, Size(5, 5), Point(-1, -1), false, borderType);
+        cv::erode(src, r[5], Mat(), Point(-1, -1), 2, borderType);
+    }
+    setNumThreads(nthreads);
+
+    for (size_t j = 0; j < results[0].size(); j++)
+        EXPECT_LE(cvtest::norm(results[0][j], results[1][j], NORM_INF | NORM_RELATIVE), 1e-6) << "filter #" << j;
+}
+
+INSTANTIATE_TEST_CASE_P(/**/, Imgproc_FilterEngine_parallel, testing::Combine(
+    testing::Values(CV_8UC1, CV_8UC3, CV_32FC1),
+    testing::Values(BORDER_CONSTANT, BORDER_REPLICATE, BORDER_REFLECT_101)
+));
+
 }} // namespace
@@ -425,4 +425,59 @@ TEST(Imgproc_MatchTemplate, bug_9597) {
         cv::minMaxLoc(result, &minValue, NULL, NULL, NULL);
         ASSERT_GE(minValue, 0);
 }
+
+typedef testing::TestWithParam<tuple<perf::MatType, int> > Imgproc_TemplateMatcher;
+
+TEST_P(Imgproc_TemplateMatcher, accuracy)
+{
+    const int type = get<0>(GetParam());
+    const int method = get<1>(GetParam());
+    RNG& rng = TS::ptr()->get_rng();
+
+    Mat img(rng.uniform(200, 400), rng.uniform(200, 500), type);
+    cvtest::randUni(rng, img, Scalar::all(0), Scalar::all(255));
+
+    std::vector<Mat> templs;
+    for (int i = 0; i < 6; i++)
+    {
+        Size sz(rng.uniform(3, 70), rng.uniform(3, 70));
+        Rect r(rng.uniform(0, img.cols - sz.width), rng.uniform(0, img.rows - sz.height), sz.width, sz.height);
+        templs.push_back(img(r).clone());
+    }
+
+    Ptr<TemplateMatcher> matcher = createTemplateMatcher(templs, method);
+    ASSERT_EQ((int)templs.size(), matcher->getTemplatesCount());
+    ASSERT_EQ(method, matcher->getMethod());
+
+    // the second image needs a different tiling, the third one reuses it
+    const Rect rois[] = { Rect(0, 0, img.cols, img.rows), Rect(5, 3, 90, 100), Rect(4, 2, 90, 100) };
+    const int nthreads = getNumThreads();
+    for (int iter = 0; iter < 3; iter++)
+    {
+        Mat src = img(rois[iter]);
+        std::vector<Mat> results, results4;
+        cv::setNumThreads(1);
+        matcher->match(src, results);
+        cv::setNumThreads(4);
+        matcher->match(src, results4);
+        cv::setNumThreads(nthreads);
+        ASSERT_EQ(templs.size(), results.size());
+
+        for (size_t i = 0; i < templs.size(); i++)
+        {
+            Mat ref;
+            matchTemplate(src, templs[i], ref, method);
+            ASSERT_EQ(ref.size(), results[i].size());
+            ASSERT_EQ(CV_32FC1, results[i].type());
+            double scale = std::max(1.0, cvtest::norm(ref, NORM_INF));
+            EXPECT_LE(cvtest::norm(results[i], ref, NORM_INF), 1e-4*scale) << "iter: " << iter << " template: " << i;
+            EXPECT_EQ(0, cvtest::norm(results[i], results4[i], NORM_INF)) << "iter: " << iter << " template: " << i;
+        }
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(/**/, Imgproc_TemplateMatcher, testing::Combine(
+    testing::Values(CV_8UC1, CV_8UC3, CV_32FC1),
+    testing::Values((int)TM_SQDIFF, (int)TM_SQDIFF_NORMED, (int)TM_CCORR,
+                    (int)TM_CCORR_NORMED, (int)TM_CCOEFF, (int)TM_CCOEFF_NORMED)));
 } // namespace